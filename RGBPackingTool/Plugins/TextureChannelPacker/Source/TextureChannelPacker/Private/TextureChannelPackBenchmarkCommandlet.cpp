@@ -0,0 +1,53 @@
+#include "TextureChannelPackBenchmarkCommandlet.h"
+#include "TextureChannelPackerJob.h"
+#include "TextureChannelPackerBenchmarks.h"
+
+/** Process exit codes returned by UTextureChannelPackBenchmarkCommandlet::Main. */
+enum class ETextureChannelPackBenchmarkExitCode : int32
+{
+    Success = 0,
+    Failed = 1,
+    InvalidArguments = 2,
+};
+
+UTextureChannelPackBenchmarkCommandlet::UTextureChannelPackBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Benchmarks the channel packing engine on synthetic sources and compares the results with a baseline.");
+    HelpUsage = TEXT("-run=TextureChannelPackBenchmark [-Sizes=<W[xH],...>] [-Iterations=<N>] [-Output=<Results.csv|Results.json>] [-Baseline=<Baseline.csv>] [-Threshold=<Percent>]");
+    HelpParamNames.Add(TEXT("Sizes"));
+    HelpParamDescriptions.Add(TEXT("Comma-separated source sizes, e.g. 1024,4096,2048x512 (default 256 to 8192 squares plus 2048x512 and 512x2048)."));
+    HelpParamNames.Add(TEXT("Iterations"));
+    HelpParamDescriptions.Add(TEXT("Timed runs per case after one warm-up run; the fastest is reported (default 3)."));
+    HelpParamNames.Add(TEXT("Output"));
+    HelpParamDescriptions.Add(TEXT("Optional file receiving the results, as JSON (.json) or CSV."));
+    HelpParamNames.Add(TEXT("Baseline"));
+    HelpParamDescriptions.Add(TEXT("Optional CSV results of an earlier run to compare against."));
+    HelpParamNames.Add(TEXT("Threshold"));
+    HelpParamDescriptions.Add(TEXT("Percentage a case may be slower than the baseline before the run fails (default 10)."));
+}
+
+int32 UTextureChannelPackBenchmarkCommandlet::Main(const FString& Params)
+{
+    FChannelPackBenchmarkSuiteSettings Settings;
+    FString Error;
+    if (!ParseChannelPackBenchmarkSuiteSettings(*Params, Settings, Error))
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("%s Usage: %s"), *Error, *HelpUsage);
+        return (int32)ETextureChannelPackBenchmarkExitCode::InvalidArguments;
+    }
+
+    TArray<FChannelPackBenchmarkResult> Results;
+    if (!RunChannelPackBenchmarkSuite(Settings, Results, Error))
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Benchmark suite failed: %s"), *Error);
+        return (int32)ETextureChannelPackBenchmarkExitCode::Failed;
+    }
+
+    UE_LOG(LogTexturePacker, Display, TEXT("Benchmark suite: %d case(s) passed."), Results.Num());
+    return (int32)ETextureChannelPackBenchmarkExitCode::Success;
+}
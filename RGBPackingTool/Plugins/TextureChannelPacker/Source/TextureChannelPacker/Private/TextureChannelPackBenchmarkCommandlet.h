@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TextureChannelPackBenchmarkCommandlet.generated.h"
+
+/**
+ * @class UTextureChannelPackBenchmarkCommandlet
+ * @brief Runs the pixel engine benchmark suite headlessly, for performance checks on build machines.
+ *
+ * Usage:
+ * @code
+ * UnrealEditor-Cmd Project.uproject -run=TextureChannelPackBenchmark [-Sizes=256,1024,2048x512] [-Iterations=3] [-Output=Results.csv] [-Baseline=Baseline.csv] [-Threshold=10] -nullrhi -unattended
+ * @endcode
+ *
+ * Packs synthetic sources of every format through the same-size, resize, invert and missing-channel
+ * paths (see RunChannelPackBenchmarkSuite) and writes the timings, throughput and peak memory of
+ * every case to -Output (JSON if the extension is .json, CSV otherwise). A CSV written by an earlier
+ * run can be passed as -Baseline. The exit code is 0 if no case is more than -Threshold percent
+ * slower than the baseline, 1 if one is or a file could not be read or written, and 2 if the
+ * arguments are invalid.
+ */
+UCLASS()
+class UTextureChannelPackBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTextureChannelPackBenchmarkCommandlet();
+
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString& Params) override;
+    //~ End UCommandlet Interface
+};
@@ -0,0 +1,183 @@
+#include "TextureChannelPackCommandlet.h"
+#include "TextureChannelPackerBatch.h"
+#include "Engine/Texture2D.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+#include "Misc/FileHelper.h"
+#include "HAL/PlatformTime.h"
+
+/** Process exit codes returned by UTextureChannelPackCommandlet::Main. */
+enum class ETextureChannelPackExitCode : int32
+{
+    Success = 0,
+    JobsFailed = 1,
+    InvalidArguments = 2,
+};
+
+/** Number of finished jobs between garbage collections, so loaded inputs do not pile up. */
+static constexpr int32 ChannelPackJobsPerGC = 16;
+
+// ---------------------------------------------------------
+// Job Execution
+// ---------------------------------------------------------
+
+/** Saves a finished output's package to disk. */
+static void SavePackedTexture(FChannelPackJob& Job, FString& OutError)
+{
+    // An up-to-date asset is only saved if its compression settings changed
+    if (!Job.bUpToDate || Job.Package->IsDirty())
+    {
+        const FString FileName = FPackageName::LongPackageNameToFilename(Job.PackageName, FPackageName::GetAssetPackageExtension());
+
+        FSavePackageArgs SaveArgs;
+        SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+        SaveArgs.SaveFlags = SAVE_NoError;
+        if (!UPackage::SavePackage(Job.Package.Get(), Job.Texture.Get(), *FileName, SaveArgs))
+        {
+            OutError = FString::Printf(TEXT("Failed to save %s"), *FileName);
+        }
+    }
+}
+
+/** Writes the per-job results as CSV. */
+static void WriteChannelPackReport(const FString& ReportPath, const TArray<TSharedPtr<FChannelPackBatchItem>>& Items)
+{
+    FString Report = TEXT("Output,Result,LoadSeconds,DecodeSeconds,PackSeconds,SaveSeconds,PeakMB,Error\n");
+    for (const TSharedPtr<FChannelPackBatchItem>& Item : Items)
+    {
+        Report += FString::Printf(TEXT("%s,%s,%.3f,%.3f,%.3f,%.3f,%.1f,\"%s\"\n"),
+            *Item->PackageName,
+            Item->State != EChannelPackBatchItemState::Succeeded ? TEXT("FAILED") : Item->bUpToDate ? TEXT("UPTODATE") : TEXT("OK"),
+            Item->LoadSeconds, Item->DecodeSeconds, Item->PackSeconds, Item->FinishSeconds, Item->PeakBytes / (1024.0 * 1024.0),
+            *Item->Error.Replace(TEXT("\""), TEXT("\"\"")));
+    }
+
+    if (!FFileHelper::SaveStringToFile(Report, *ReportPath))
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Failed to write report: %s"), *ReportPath);
+    }
+}
+
+// ---------------------------------------------------------
+// UTextureChannelPackCommandlet
+// ---------------------------------------------------------
+
+UTextureChannelPackCommandlet::UTextureChannelPackCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Packs textures from a JSON or CSV job manifest.");
+    HelpUsage = TEXT("-run=TextureChannelPack -Manifest=<Jobs.json|Jobs.csv> [-Parallel=<Jobs in flight>] [-Report=<Report.csv>] [-Force]");
+    HelpParamNames.Add(TEXT("Manifest"));
+    HelpParamDescriptions.Add(TEXT("Path to the job manifest (.json or .csv)."));
+    HelpParamNames.Add(TEXT("Parallel"));
+    HelpParamDescriptions.Add(TEXT("Number of jobs packed at the same time (default 2)."));
+    HelpParamNames.Add(TEXT("Report"));
+    HelpParamDescriptions.Add(TEXT("Optional CSV file receiving the result and timings of every job."));
+    HelpParamNames.Add(TEXT("Force"));
+    HelpParamDescriptions.Add(TEXT("Repack every job, even if its output asset was packed from the same inputs and settings."));
+}
+
+int32 UTextureChannelPackCommandlet::Main(const FString& Params)
+{
+    FString ManifestPath;
+    if (!FParse::Value(*Params, TEXT("Manifest="), ManifestPath))
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Usage: %s"), *HelpUsage);
+        return (int32)ETextureChannelPackExitCode::InvalidArguments;
+    }
+
+    int32 MaxJobsInFlight = 2;
+    FParse::Value(*Params, TEXT("Parallel="), MaxJobsInFlight);
+    MaxJobsInFlight = FMath::Max(1, MaxJobsInFlight);
+
+    const bool bForce = FParse::Param(*Params, TEXT("Force"));
+
+    FString ReportPath;
+    FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+    // ---------------------------------------------------------
+    // Load the manifest
+    // ---------------------------------------------------------
+    TArray<FChannelPackBatchItem> ManifestItems;
+    FString ManifestError;
+    if (!LoadChannelPackManifest(ManifestPath, ManifestItems, ManifestError))
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Invalid manifest %s: %s"), *ManifestPath, *ManifestError);
+        return (int32)ETextureChannelPackExitCode::InvalidArguments;
+    }
+
+    UE_LOG(LogTexturePacker, Display, TEXT("Packing %d textures from %s (%d in flight)"), ManifestItems.Num(), *ManifestPath, MaxJobsInFlight);
+
+    // ---------------------------------------------------------
+    // Run the jobs
+    // ---------------------------------------------------------
+    const double BatchStartTime = FPlatformTime::Seconds();
+    FChannelPackBatch Batch;
+    for (FChannelPackBatchItem& Item : ManifestItems)
+    {
+        Item.Settings.bSkipUnchanged = !bForce;
+        Batch.Add(Item);
+    }
+
+    int32 NumFinished = 0;
+    int32 NumFailed = 0;
+    int32 NumUpToDate = 0;
+
+    Batch.OnJobFinalized = [](FChannelPackBatchItem& Item, FChannelPackJob& Job)
+    {
+        SavePackedTexture(Job, Item.Error);
+        for (const TSharedPtr<FChannelPackJob>& VariantJob : Job.VariantJobs)
+        {
+            SavePackedTexture(*VariantJob, Item.Error);
+        }
+    };
+
+    Batch.OnItemFinished = [&](const FChannelPackBatchItem& Item)
+    {
+        ++NumFinished;
+        if (Item.State != EChannelPackBatchItemState::Succeeded)
+        {
+            ++NumFailed;
+            UE_LOG(LogTexturePacker, Error, TEXT("[%d/%d] %s FAILED: %s"), NumFinished, ManifestItems.Num(), *Item.PackageName, *Item.Error);
+        }
+        else if (Item.bUpToDate)
+        {
+            ++NumUpToDate;
+            UE_LOG(LogTexturePacker, Display, TEXT("[%d/%d] %s UP TO DATE (%.2f s)"),
+                NumFinished, ManifestItems.Num(), *Item.PackageName, Item.LoadSeconds + Item.FinishSeconds);
+        }
+        else
+        {
+            UE_LOG(LogTexturePacker, Display, TEXT("[%d/%d] %s OK (load %.2f s, decode %.2f s, pack %.2f s, save %.2f s, peak %.1f MB)"),
+                NumFinished, ManifestItems.Num(), *Item.PackageName, Item.LoadSeconds, Item.DecodeSeconds, Item.PackSeconds, Item.FinishSeconds,
+                Item.PeakBytes / (1024.0 * 1024.0));
+        }
+
+        if (NumFinished % ChannelPackJobsPerGC == 0)
+        {
+            CollectGarbage(RF_NoFlags);
+        }
+    };
+
+    // Jobs are started on the Game Thread while the packing of the others runs on the workers
+    Batch.Start(MaxJobsInFlight);
+    while (Batch.Tick())
+    {
+        Batch.WaitForAnyJob();
+    }
+
+    UE_LOG(LogTexturePacker, Display, TEXT("Packed %d of %d textures in %.2f s (%d up to date, %d failed)"),
+        ManifestItems.Num() - NumFailed - NumUpToDate, ManifestItems.Num(), FPlatformTime::Seconds() - BatchStartTime, NumUpToDate, NumFailed);
+
+    if (!ReportPath.IsEmpty())
+    {
+        WriteChannelPackReport(ReportPath, Batch.GetItems());
+    }
+
+    return (int32)(NumFailed > 0 ? ETextureChannelPackExitCode::JobsFailed : ETextureChannelPackExitCode::Success);
+}
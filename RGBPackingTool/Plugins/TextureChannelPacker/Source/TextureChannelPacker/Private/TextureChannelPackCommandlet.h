@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TextureChannelPackCommandlet.generated.h"
+
+/**
+ * @class UTextureChannelPackCommandlet
+ * @brief Packs textures headlessly from a job manifest, for batch runs on build machines.
+ *
+ * Usage:
+ * @code
+ * UnrealEditor-Cmd Project.uproject -run=TextureChannelPack -Manifest=Jobs.json [-Parallel=2] [-Report=Report.csv] [-Force] -nullrhi -unattended
+ * @endcode
+ *
+ * The manifest is JSON or CSV (by file extension). Each job names an output package, up to four
+ * input textures (R, G, B, A) and optional per-job settings; see Docs/API.md for the schema.
+ * Up to -Parallel jobs are in flight at once (see FChannelPackBatch): while their packing tasks
+ * run on the worker threads, the Game Thread loads the inputs of the next job and saves finished ones.
+ *
+ * Jobs whose output asset was packed from the same inputs and settings are skipped unless -Force
+ * is given (see UTextureChannelPackRecipe). Every job is logged with its load, pack and save
+ * timings. The exit code is 0 if all jobs succeeded, 1 if at least one job failed and 2 if the
+ * arguments or the manifest are invalid.
+ */
+UCLASS()
+class UTextureChannelPackCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTextureChannelPackCommandlet();
+
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString& Params) override;
+    //~ End UCommandlet Interface
+};
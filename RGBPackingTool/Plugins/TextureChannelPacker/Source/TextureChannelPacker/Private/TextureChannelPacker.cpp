@@ -1,5 +1,7 @@
 #include "TextureChannelPacker.h"
-#include "UObject/StrongObjectPtr.h"
+#include "TextureChannelPackerEngine.h"
+#include "TextureChannelPackerJob.h"
+#include "TextureChannelPackerBatch.h"
 #include "ToolMenus.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Widgets/Text/STextBlock.h"
@@ -8,6 +10,9 @@
 #include "Widgets/Input/SNumericEntryBox.h"
 #include "Widgets/Layout/SSeparator.h"
 #include "Widgets/Layout/SSpacer.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
 #include "Framework/Docking/TabManager.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
@@ -16,51 +21,44 @@
 #include "PropertyCustomizationHelpers.h"
 #include "Engine/Texture2D.h"
 #include "AssetRegistry/AssetRegistryModule.h"
-#include "Misc/Paths.h"
 #include "Misc/MessageDialog.h"
-#include "ImageUtils.h"
 #include "Math/UnrealMathUtility.h"
-#include "Math/Float16.h"
 #include "Widgets/Input/SComboButton.h"
 #include "Widgets/Input/SComboBox.h"
 #include "Widgets/Images/SImage.h"
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
 #include "ThumbnailRendering/ThumbnailManager.h"
-#include "Internationalization/Internationalization.h"
-#include "Internationalization/Culture.h"
-#include "Misc/ScopedSlowTask.h"
-#include "Async/ParallelFor.h"
+#include "DesktopPlatformModule.h"
+#include "IDesktopPlatform.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "HAL/IConsoleManager.h"
 
 #define LOCTEXT_NAMESPACE "FTextureChannelPackerModule"
 
-DEFINE_LOG_CATEGORY_STATIC(LogTexturePacker, Log, All);
-
 static const FName TextureChannelPackerTabName("TextureChannelPacker");
 
-/**
- * @brief Retrieves a localized message based on the current culture.
- *
- * This helper function returns either the Japanese text (if the current culture is Japanese)
- * or the English text (for all other cultures).
- *
- * @param Key A unique identifier for the localization key (currently unused but good for future expansion).
- * @param EnglishText The text to display in English.
- * @param JapaneseText The text to display in Japanese.
- * @return FText The localized text.
- */
-static FText GetLocalizedMessage(const FString& Key, const FString& EnglishText, const FString& JapaneseText)
+static TAutoConsoleVariable<int32> CVarChannelPackBatchJobsInFlight(
+    TEXT("TextureChannelPacker.BatchJobsInFlight"),
+    2,
+    TEXT("Number of queued jobs the batch queue of the editor tab packs at the same time (at least 1). Read when the queue is run; the commandlet uses -Parallel instead."));
+
+/** Game Thread time per tick spent starting queued jobs (input extraction), so the editor stays responsive. */
+static constexpr double BatchTickBudgetSeconds = 0.02;
+
+FText FCompressionOption::GetDisplayName() const
 {
-    FString CultureName = FInternationalization::Get().GetCurrentCulture()->GetTwoLetterISOLanguageName();
-    if (CultureName == TEXT("ja"))
-    {
-        return FText::FromString(JapaneseText);
-    }
-    // We return FText::FromString to avoid unsafe usage of internal localization macros with dynamic strings.
-    return FText::FromString(EnglishText);
+    return GetLocalizedMessage(InternalName, DisplayNameEn, DisplayNameJa);
 }
 
-FText FCompressionOption::GetDisplayName() const
+FText FResizeFilterOption::GetDisplayName() const
+{
+    return GetLocalizedMessage(InternalName, DisplayNameEn, DisplayNameJa);
+}
+
+FText FSourceChannelOption::GetDisplayName() const
 {
     return GetLocalizedMessage(InternalName, DisplayNameEn, DisplayNameJa);
 }
@@ -91,6 +89,57 @@ void FTextureChannelPackerModule::StartupModule()
 
     CurrentCompressionOption = CompressionOptions[0];
 
+    // Initialize Resize Filter Options
+    auto AddResizeFilterOption = [this](const TCHAR* InternalName, ETextureResizeFilter Filter, const TCHAR* DisplayNameEn, const TCHAR* DisplayNameJa)
+    {
+        FResizeFilterOption Option;
+        Option.InternalName = InternalName;
+        Option.Filter = Filter;
+        Option.DisplayNameEn = DisplayNameEn;
+        Option.DisplayNameJa = DisplayNameJa;
+        ResizeFilterOptions.Add(MakeShared<FResizeFilterOption>(Option));
+    };
+
+    AddResizeFilterOption(TEXT("Box"), ETextureResizeFilter::Box, TEXT("Box"), TEXT("ボックス"));
+    AddResizeFilterOption(TEXT("Bilinear"), ETextureResizeFilter::Bilinear, TEXT("Bilinear (Recommended)"), TEXT("バイリニア (推奨)"));
+    AddResizeFilterOption(TEXT("Mitchell"), ETextureResizeFilter::Mitchell, TEXT("Mitchell"), TEXT("Mitchell"));
+    AddResizeFilterOption(TEXT("CatmullRom"), ETextureResizeFilter::CatmullRom, TEXT("Catmull-Rom"), TEXT("Catmull-Rom"));
+    AddResizeFilterOption(TEXT("Lanczos3"), ETextureResizeFilter::Lanczos3, TEXT("Lanczos (3 lobes)"), TEXT("Lanczos (3ローブ)"));
+
+    CurrentResizeFilterOption = ResizeFilterOptions[1];
+
+    // Initialize Source Channel Options
+    auto AddSourceChannelOption = [this](const TCHAR* InternalName, ETextureSourceChannel Channel, const TCHAR* DisplayNameEn, const TCHAR* DisplayNameJa)
+    {
+        FSourceChannelOption Option;
+        Option.InternalName = InternalName;
+        Option.Channel = Channel;
+        Option.DisplayNameEn = DisplayNameEn;
+        Option.DisplayNameJa = DisplayNameJa;
+        SourceChannelOptions.Add(MakeShared<FSourceChannelOption>(Option));
+    };
+
+    AddSourceChannelOption(TEXT("Red"), ETextureSourceChannel::Red, TEXT("R"), TEXT("R"));
+    AddSourceChannelOption(TEXT("Green"), ETextureSourceChannel::Green, TEXT("G"), TEXT("G"));
+    AddSourceChannelOption(TEXT("Blue"), ETextureSourceChannel::Blue, TEXT("B"), TEXT("B"));
+    AddSourceChannelOption(TEXT("Alpha"), ETextureSourceChannel::Alpha, TEXT("A"), TEXT("A"));
+    AddSourceChannelOption(TEXT("Luminance"), ETextureSourceChannel::Luminance, TEXT("Luminance"), TEXT("輝度"));
+
+    // Batch Queue
+    Batch = MakeShared<FChannelPackBatch>();
+    Batch->OnItemFinished = [this](const FChannelPackBatchItem& Item)
+    {
+        if (Item.State == EChannelPackBatchItemState::Failed)
+        {
+            UE_LOG(LogTexturePacker, Error, TEXT("Batch: %s failed: %s"), *Item.PackageName, *Item.Error);
+        }
+
+        if (BatchListView.IsValid())
+        {
+            BatchListView->RequestListRefresh();
+        }
+    };
+
     // Register Nomad Tab
     FGlobalTabmanager::Get()->RegisterNomadTabSpawner(TextureChannelPackerTabName, FOnSpawnTab::CreateRaw(this, &FTextureChannelPackerModule::OnSpawnPluginTab))
         .SetDisplayName(LOCTEXT("TextureChannelPackerTabTitle", "Texture Channel Packer"))
@@ -128,13 +177,51 @@ void FTextureChannelPackerModule::ShutdownModule()
     // we call this function before unloading the module.
     UToolMenus::UnregisterOwner(this);
     FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TextureChannelPackerTabName);
+
+    // Do not leave a background task writing into a texture that is about to be released
+    FTSTicker::GetCoreTicker().RemoveTicker(PackJobTickerHandle);
+    PackJobTickerHandle.Reset();
+    if (ActivePackJob.IsValid())
+    {
+        ActivePackJob->Control.Cancel();
+        FinishActivePackJob();
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(BatchTickerHandle);
+    BatchTickerHandle.Reset();
+    if (Batch.IsValid())
+    {
+        Batch->OnItemFinished = nullptr;
+        Batch->Cancel();
+        while (Batch->Tick())
+        {
+            Batch->WaitForAnyJob();
+        }
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(ScratchArenaTrimTickerHandle);
+    ScratchArenaTrimTickerHandle.Reset();
+    FChannelPackScratchArena::Get().Trim(0.0);
+}
+
+TSharedPtr<FSourceChannelOption> FTextureChannelPackerModule::FindSourceChannelOption(ETextureSourceChannel Channel) const
+{
+    for (const TSharedPtr<FSourceChannelOption>& Option : SourceChannelOptions)
+    {
+        if (Option->Channel == Channel)
+        {
+            return Option;
+        }
+    }
+    return nullptr;
 }
 
-TSharedRef<SWidget> FTextureChannelPackerModule::CreateChannelInputSlot(const FText& LabelText, TWeakObjectPtr<UTexture2D>& TargetTexturePtr, bool& bInvertFlag, const FText& TooltipText)
+TSharedRef<SWidget> FTextureChannelPackerModule::CreateChannelInputSlot(const FText& LabelText, TWeakObjectPtr<UTexture2D>& TargetTexturePtr, bool& bInvertFlag, ETextureSourceChannel& SourceChannel, const FText& TooltipText)
 {
     // Capture the address of the member variable to update it inside the lambda
     TWeakObjectPtr<UTexture2D>* TexturePtr = &TargetTexturePtr;
     bool* InvertPtr = &bInvertFlag;
+    ETextureSourceChannel* SourceChannelPtr = &SourceChannel;
 
     TSharedPtr<STextBlock> LabelWidget = SNew(STextBlock)
         .Text(LabelText)
@@ -158,6 +245,40 @@ TSharedRef<SWidget> FTextureChannelPackerModule::CreateChannelInputSlot(const FT
             [
                 LabelWidget.ToSharedRef()
             ]
+            // Source Channel Dropdown
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(0.0f, 0.0f, 8.0f, 0.0f)
+            [
+                SNew(SComboBox<TSharedPtr<FSourceChannelOption>>)
+                .ToolTipText(GetLocalizedMessage(
+                    TEXT("SourceChannelTooltip"),
+                    TEXT("Which channel of the input texture is read. Only RGBA textures have separate channels; grayscale textures always provide their single value."),
+                    TEXT("入力テクスチャのどのチャンネルを読み取るかを指定します。チャンネルが分かれているのは RGBA テクスチャのみで、グレースケールテクスチャは常にその値が使われます。")))
+                .OptionsSource(&SourceChannelOptions)
+                .InitiallySelectedItem(FindSourceChannelOption(SourceChannel))
+                .OnSelectionChanged_Lambda([SourceChannelPtr](TSharedPtr<FSourceChannelOption> NewSelection, ESelectInfo::Type)
+                {
+                    if (NewSelection.IsValid())
+                    {
+                        *SourceChannelPtr = NewSelection->Channel;
+                    }
+                })
+                .OnGenerateWidget_Lambda([](TSharedPtr<FSourceChannelOption> Item)
+                {
+                    return SNew(STextBlock).Text(Item->GetDisplayName());
+                })
+                [
+                    SNew(STextBlock)
+                    .Text_Lambda([this, SourceChannelPtr]()
+                    {
+                        const TSharedPtr<FSourceChannelOption> Option = FindSourceChannelOption(*SourceChannelPtr);
+                        return Option.IsValid() ? Option->GetDisplayName() : FText::GetEmpty();
+                    })
+                    .Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+                ]
+            ]
             // Checkbox
             + SHorizontalBox::Slot()
             .AutoWidth()
@@ -245,7 +366,8 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                 CreateChannelInputSlot(
                     GetLocalizedMessage(TEXT("RedChannelLabel"), TEXT("Red Channel Input (e.g. Ambient Occlusion)"), TEXT("Red Channel Input (例: アンビエントオクルージョン)")),
                     InputTextureR,
-                    bInvertR
+                    bInvertR,
+                    SourceChannelR
                 )
             ]
 
@@ -257,7 +379,8 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                 CreateChannelInputSlot(
                     GetLocalizedMessage(TEXT("GreenChannelLabel"), TEXT("Green Channel Input (e.g. Roughness)"), TEXT("Green Channel Input (例: ラフネス)")),
                     InputTextureG,
-                    bInvertG
+                    bInvertG,
+                    SourceChannelG
                 )
             ]
 
@@ -269,7 +392,8 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                 CreateChannelInputSlot(
                     GetLocalizedMessage(TEXT("BlueChannelLabel"), TEXT("Blue Channel Input (e.g. Metallic)"), TEXT("Blue Channel Input (例: メタリック)")),
                     InputTextureB,
-                    bInvertB
+                    bInvertB,
+                    SourceChannelB
                 )
             ]
 
@@ -282,6 +406,7 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                     GetLocalizedMessage(TEXT("AlphaChannelLabel"), TEXT("Alpha Channel Input (Optional)"), TEXT("Alpha Channel Input (任意)")),
                     InputTextureA,
                     bInvertA,
+                    SourceChannelA,
                     GetLocalizedMessage(
                         TEXT("AlphaChannelTooltip"),
                         TEXT("If left empty, fills with White (255) to ensure opacity. Assign a texture to pack a custom Alpha mask."),
@@ -320,7 +445,7 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                 [
                     SNew(STextBlock)
                     .Text(LOCTEXT("ResolutionLabel", "Resolution - Width \u00D7 Height (e.g. 2048 \u00D7 2048)"))
-                    .ToolTipText(GetLocalizedMessage(TEXT("ResolutionTooltip"), TEXT("Width and Height. Valid range: 1 - 8192 each."), TEXT("幅と高さ。有効範囲: それぞれ 1 - 8192")))
+                    .ToolTipText(GetLocalizedMessage(TEXT("ResolutionTooltip"), TEXT("Width and Height. Valid range: 1 - 16384 each. Packs that do not fit in the memory budget are written one input at a time."), TEXT("幅と高さ。有効範囲: それぞれ 1 - 16384。メモリ予算に収まらないパックは入力ごとに書き込まれます。")))
                     .Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
                 ]
                 + SVerticalBox::Slot()
@@ -336,9 +461,9 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                         .OnValueChanged_Lambda([this](int32 NewValue) { TargetWidth = NewValue; })
                         .AllowSpin(true)
                         .MinValue(1)
-                        .MaxValue(8192)
+                        .MaxValue(ChannelPackMaxResolution)
                         .MinSliderValue(1)
-                        .MaxSliderValue(8192)
+                        .MaxSliderValue(ChannelPackMaxResolution)
                     ]
                     // "×" Separator
                     + SHorizontalBox::Slot()
@@ -359,13 +484,41 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                         .OnValueChanged_Lambda([this](int32 NewValue) { TargetHeight = NewValue; })
                         .AllowSpin(true)
                         .MinValue(1)
-                        .MaxValue(8192)
+                        .MaxValue(ChannelPackMaxResolution)
                         .MinSliderValue(1)
-                        .MaxSliderValue(8192)
+                        .MaxSliderValue(ChannelPackMaxResolution)
                     ]
                 ]
             ]
 
+            // Variants
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f)
+            [
+                SNew(SVerticalBox)
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                .Padding(0.0f, 0.0f, 0.0f, 4.0f)
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("VariantsLabel", "Variant Sizes (Optional, e.g. 1024, 512)"))
+                    .ToolTipText(GetLocalizedMessage(
+                        TEXT("VariantsTooltip"),
+                        TEXT("Smaller copies created by the same pack, each saved as its own texture next to the output (e.g., T_Rock_ORM_1024). A single number keeps the aspect ratio; use WxH for an explicit size. The inputs are read once and every variant is resampled from the nearest larger output: from its packed 8-bit BGRA8 pixels, not from the inputs, so each channel is rounded to 8 bits before it is resized. Existing variant assets are overwritten after confirmation."),
+                        TEXT("同じパックで作成する小さいサイズのコピーです。それぞれ出力の隣に個別のテクスチャとして保存されます (例: T_Rock_ORM_1024)。数値のみの場合は縦横比を維持し、WxH で明示的なサイズを指定できます。入力は 1 回だけ読み込まれ、各バリアントはより大きい最も近い出力からリサンプリングされます。入力ではなくパック済みの 8bit BGRA8 のピクセルから作成するため、各チャンネルは 8bit に丸められてからリサイズされます。既存のバリアントアセットは確認の後に上書きされます。")
+                    ))
+                    .Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+                ]
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                [
+                    SNew(SEditableTextBox)
+                    .Text_Lambda([this] { return FText::FromString(VariantSizes); })
+                    .OnTextCommitted_Lambda([this](const FText& NewText, ETextCommit::Type) { VariantSizes = NewText.ToString(); })
+                ]
+            ]
+
             // Compression Settings
             + SVerticalBox::Slot()
             .AutoHeight()
@@ -411,6 +564,51 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                 ]
             ]
 
+            // Resize Filter
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f)
+            [
+                SNew(SVerticalBox)
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                .Padding(0.0f, 0.0f, 0.0f, 4.0f)
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("ResizeFilterLabel", "Resize Filter"))
+                    .Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+                ]
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                [
+                    SNew(SComboBox<TSharedPtr<FResizeFilterOption>>)
+                    .ToolTipText(GetLocalizedMessage(
+                        TEXT("ResizeFilterTooltip"),
+                        TEXT("Filter used when an input's size differs from the output resolution.\n- Box: Plain average. Fastest, blocky when upscaling.\n- Bilinear: Smooth, good default for masks.\n- Mitchell: Balanced sharpness with little ringing.\n- Catmull-Rom: Sharper, slight ringing.\n- Lanczos: Sharpest, may ring on hard edges."),
+                        TEXT("入力サイズが出力解像度と異なる場合に使用するフィルタです。\n- Box: 単純平均。最速ですが拡大時はブロック状になります\n- Bilinear: 滑らか。マスクに適した標準設定\n- Mitchell: シャープさとリンギングのバランスが良好\n- Catmull-Rom: よりシャープ。わずかにリンギングが発生\n- Lanczos: 最もシャープ。硬いエッジでリンギングが発生する場合があります")
+                    ))
+                    .OptionsSource(&ResizeFilterOptions)
+                    .OnSelectionChanged_Lambda([this](TSharedPtr<FResizeFilterOption> NewSelection, ESelectInfo::Type)
+                    {
+                        if (NewSelection.IsValid())
+                        {
+                            CurrentResizeFilterOption = NewSelection;
+                        }
+                    })
+                    .OnGenerateWidget_Lambda([](TSharedPtr<FResizeFilterOption> Item)
+                    {
+                        return SNew(STextBlock).Text(Item->GetDisplayName());
+                    })
+                    [
+                        SNew(STextBlock)
+                        .Text_Lambda([this]()
+                        {
+                            return CurrentResizeFilterOption.IsValid() ? CurrentResizeFilterOption->GetDisplayName() : FText::GetEmpty();
+                        })
+                    ]
+                ]
+            ]
+
             // Output Path
             + SVerticalBox::Slot()
             .AutoHeight()
@@ -475,6 +673,41 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                 ]
             ]
 
+            // Skip Unchanged
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f)
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                [
+                    SNew(SCheckBox)
+                    .IsChecked_Lambda([this]()
+                    {
+                        return bSkipUnchanged ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+                    })
+                    .OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+                    {
+                        bSkipUnchanged = (NewState == ECheckBoxState::Checked);
+                    })
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f, 0.0f, 0.0f)
+                [
+                    SNew(STextBlock)
+                    .Text(GetLocalizedMessage(TEXT("SkipUnchangedLabel"), TEXT("Skip if unchanged"), TEXT("変更がなければスキップ")))
+                    .ToolTipText(GetLocalizedMessage(
+                        TEXT("SkipUnchangedTooltip"),
+                        TEXT("If the output texture was already generated from the same input textures and settings, it is kept as is instead of being packed again. Only a changed compression setting is applied."),
+                        TEXT("出力テクスチャが同じ入力テクスチャと設定から生成済みの場合、再パックせずにそのまま使用します。圧縮設定が変更されている場合のみ反映されます。")))
+                    .Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+                ]
+            ]
+
             // Spacer
             + SVerticalBox::Slot()
             .AutoHeight()
@@ -494,6 +727,10 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                 .HAlign(HAlign_Center)
                 .VAlign(VAlign_Center)
                 .ContentPadding(FMargin(0.0f, 10.0f))
+                .IsEnabled_Lambda([this]()
+                {
+                    return !ActivePackJob.IsValid() && !Batch->IsRunning();
+                })
                 .OnClicked_Lambda([this]()
                 {
                     return OnGenerateClicked();
@@ -504,6 +741,133 @@ TSharedRef<SDockTab> FTextureChannelPackerModule::OnSpawnPluginTab(const FSpawnT
                     .Font(FAppStyle::GetFontStyle("PropertyWindow.BoldFont"))
                 ]
             ]
+
+            // Separator
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f)
+            [
+                SNew(SSeparator)
+            ]
+
+            // Batch Queue Header
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f)
+            [
+                SNew(STextBlock)
+                .Text(GetLocalizedMessage(TEXT("BatchQueueLabel"), TEXT("Batch Queue"), TEXT("バッチキュー")))
+                .ToolTipText(GetLocalizedMessage(
+                    TEXT("BatchQueueTooltip"),
+                    TEXT("Queue several texture sets and generate them in one run. Several textures are packed at the same time."),
+                    TEXT("複数のテクスチャセットをキューに追加し、まとめて生成します。複数のテクスチャが同時にパックされます。")))
+                .Font(FAppStyle::GetFontStyle("PropertyWindow.BoldFont"))
+            ]
+
+            // Batch Queue Buttons
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f)
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .Padding(0.0f, 0.0f, 4.0f, 0.0f)
+                [
+                    SNew(SButton)
+                    .HAlign(HAlign_Center)
+                    .ToolTipText(GetLocalizedMessage(TEXT("AddToQueueTooltip"), TEXT("Adds the current inputs and output settings to the queue."), TEXT("現在の入力と出力設定をキューに追加します。")))
+                    .IsEnabled_Lambda([this]() { return !Batch->IsRunning(); })
+                    .OnClicked_Raw(this, &FTextureChannelPackerModule::OnAddToQueueClicked)
+                    [
+                        SNew(STextBlock).Text(GetLocalizedMessage(TEXT("AddToQueueButton"), TEXT("Add to Queue"), TEXT("キューに追加")))
+                    ]
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .Padding(0.0f, 0.0f, 4.0f, 0.0f)
+                [
+                    SNew(SButton)
+                    .HAlign(HAlign_Center)
+                    .ToolTipText(GetLocalizedMessage(TEXT("ImportManifestTooltip"), TEXT("Adds every job of a JSON or CSV manifest (same format as the commandlet) to the queue."), TEXT("JSON または CSV のマニフェスト (コマンドレットと同じ形式) のすべてのジョブをキューに追加します。")))
+                    .IsEnabled_Lambda([this]() { return !Batch->IsRunning(); })
+                    .OnClicked_Raw(this, &FTextureChannelPackerModule::OnImportManifestClicked)
+                    [
+                        SNew(STextBlock).Text(GetLocalizedMessage(TEXT("ImportManifestButton"), TEXT("Import Manifest..."), TEXT("マニフェストを読み込み...")))
+                    ]
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .Padding(0.0f, 0.0f, 4.0f, 0.0f)
+                [
+                    SNew(SButton)
+                    .HAlign(HAlign_Center)
+                    .IsEnabled_Lambda([this]()
+                    {
+                        return Batch->IsRunning() || (!ActivePackJob.IsValid() && Batch->GetNumItems(EChannelPackBatchItemState::Pending) > 0);
+                    })
+                    .OnClicked_Raw(this, &FTextureChannelPackerModule::OnRunQueueClicked)
+                    [
+                        SNew(STextBlock)
+                        .Text_Lambda([this]()
+                        {
+                            return Batch->IsRunning()
+                                ? GetLocalizedMessage(TEXT("CancelQueueButton"), TEXT("Cancel Queue"), TEXT("キューをキャンセル"))
+                                : GetLocalizedMessage(TEXT("RunQueueButton"), TEXT("Run Queue"), TEXT("キューを実行"));
+                        })
+                    ]
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                [
+                    SNew(SButton)
+                    .HAlign(HAlign_Center)
+                    .ToolTipText(GetLocalizedMessage(TEXT("ClearQueueTooltip"), TEXT("Removes all items from the queue."), TEXT("キューからすべての項目を削除します。")))
+                    .IsEnabled_Lambda([this]() { return !Batch->IsRunning() && Batch->GetItems().Num() > 0; })
+                    .OnClicked_Raw(this, &FTextureChannelPackerModule::OnClearQueueClicked)
+                    [
+                        SNew(STextBlock).Text(GetLocalizedMessage(TEXT("ClearQueueButton"), TEXT("Clear Queue"), TEXT("キューをクリア")))
+                    ]
+                ]
+            ]
+
+            // Batch Queue List
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f)
+            [
+                SNew(SBox)
+                .HeightOverride(150.0f)
+                [
+                    SAssignNew(BatchListView, SListView<TSharedPtr<FChannelPackBatchItem>>)
+                    .ListItemsSource(&Batch->GetItems())
+                    .SelectionMode(ESelectionMode::None)
+                    .OnGenerateRow_Raw(this, &FTextureChannelPackerModule::GenerateBatchItemRow)
+                ]
+            ]
+
+            // Batch Queue Summary
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(10.0f, 5.0f, 10.0f, 10.0f)
+            [
+                SNew(STextBlock)
+                .Text_Lambda([this]()
+                {
+                    const FText Summary = FText::Format(
+                        GetLocalizedMessage(TEXT("BatchQueueSummary"), TEXT("{0} queued, {1} succeeded, {2} failed"), TEXT("待機 {0} / 成功 {1} / 失敗 {2}")),
+                        FText::AsNumber(Batch->GetNumItems(EChannelPackBatchItemState::Pending) + Batch->GetNumItems(EChannelPackBatchItemState::Running)),
+                        FText::AsNumber(Batch->GetNumItems(EChannelPackBatchItemState::Succeeded)),
+                        FText::AsNumber(Batch->GetNumItems(EChannelPackBatchItemState::Failed)));
+
+                    if (!Batch->IsRunning())
+                    {
+                        return Summary;
+                    }
+                    return FText::Format(FText::FromString(TEXT("{0} ({1}%)")), Summary, FText::AsNumber(FMath::FloorToInt(Batch->GetProgress() * 100.0f)));
+                })
+                .Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+            ]
         ];
 }
 
@@ -520,16 +884,44 @@ FReply FTextureChannelPackerModule::OnGenerateClicked()
         bInvertG ? TEXT("Yes") : TEXT("No"),
         bInvertB ? TEXT("Yes") : TEXT("No"),
         bInvertA ? TEXT("Yes") : TEXT("No"));
+    UE_LOG(LogTexturePacker, Log, TEXT("Source Channel R: %s, G: %s, B: %s, A: %s"),
+        *FindSourceChannelOption(SourceChannelR)->InternalName,
+        *FindSourceChannelOption(SourceChannelG)->InternalName,
+        *FindSourceChannelOption(SourceChannelB)->InternalName,
+        *FindSourceChannelOption(SourceChannelA)->InternalName);
     UE_LOG(LogTexturePacker, Log, TEXT("Resolution: %d x %d"), TargetWidth, TargetHeight);
+    UE_LOG(LogTexturePacker, Log, TEXT("Resize Filter: %s"), CurrentResizeFilterOption.IsValid() ? *CurrentResizeFilterOption->InternalName : TEXT("None"));
     UE_LOG(LogTexturePacker, Log, TEXT("Output Path: %s"), *OutputPackagePath);
     UE_LOG(LogTexturePacker, Log, TEXT("File Name: %s"), *OutputFileName);
 
+    // Validation Check 0: Only one generation runs at a time
+    if (ActivePackJob.IsValid() || Batch->IsRunning())
+    {
+        FText Msg = GetLocalizedMessage(TEXT("ErrorJobRunning"), TEXT("A texture is already being generated. Please wait or cancel it."), TEXT("テクスチャを生成中です。完了するまで待つか、キャンセルしてください。"));
+        ShowNotification(Msg, false);
+        return FReply::Handled();
+    }
+
+    FString PackageName;
+    TArray<FChannelPackVariant> Variants;
+    if (!ValidateOutputAndGetPackageName(PackageName, Variants))
+    {
+        return FReply::Handled();
+    }
+
+    CreateTexture(PackageName, TargetWidth, TargetHeight, Variants);
+
+    return FReply::Handled();
+}
+
+bool FTextureChannelPackerModule::ValidateOutputAndGetPackageName(FString& OutPackageName, TArray<FChannelPackVariant>& OutVariants)
+{
     // Validation Check 1: At least one input texture
     if (!InputTextureR.IsValid() && !InputTextureG.IsValid() && !InputTextureB.IsValid() && !InputTextureA.IsValid())
     {
         FText Msg = GetLocalizedMessage(TEXT("ErrorNoTextures"), TEXT("Please select at least one input texture."), TEXT("入力テクスチャを少なくとも1つ選択してください。"));
         ShowNotification(Msg, false);
-        return FReply::Handled();
+        return false;
     }
 
     // Validation Check 2: Output filename is not empty
@@ -537,38 +929,70 @@ FReply FTextureChannelPackerModule::OnGenerateClicked()
     {
         FText Msg = GetLocalizedMessage(TEXT("ErrorNoFileName"), TEXT("Please specify a file name."), TEXT("ファイル名を指定してください。"));
         ShowNotification(Msg, false);
-        return FReply::Handled();
+        return false;
     }
 
     // Validation Check 3: Resolution is valid
-    if (TargetWidth < 1 || TargetWidth > 8192 || TargetHeight < 1 || TargetHeight > 8192)
+    if (TargetWidth < 1 || TargetWidth > ChannelPackMaxResolution || TargetHeight < 1 || TargetHeight > ChannelPackMaxResolution)
     {
-        FText Msg = GetLocalizedMessage(TEXT("ErrorInvalidResolution"), TEXT("Width and Height must each be between 1 and 8192."), TEXT("幅と高さはそれぞれ 1 から 8192 の間で指定してください。"));
+        FText Msg = GetLocalizedMessage(TEXT("ErrorInvalidResolution"), TEXT("Width and Height must each be between 1 and 16384."), TEXT("幅と高さはそれぞれ 1 から 16384 の間で指定してください。"));
         ShowNotification(Msg, false);
-        return FReply::Handled();
+        return false;
     }
 
-    FString PackageName = OutputPackagePath;
-    if (!PackageName.EndsWith(TEXT("/")))
+    OutPackageName = OutputPackagePath;
+    if (!OutPackageName.EndsWith(TEXT("/")))
     {
-        PackageName += TEXT("/");
+        OutPackageName += TEXT("/");
     }
-    PackageName += OutputFileName;
-
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    FString ObjectPath = PackageName + TEXT(".") + OutputFileName;
-    FAssetData ExistingAsset = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(ObjectPath));
+    OutPackageName += OutputFileName;
 
-    if (ExistingAsset.IsValid())
+    // Validation Check 4: Variant sizes fit in the output resolution
+    FString VariantError;
+    if (!ParseChannelPackVariants(VariantSizes, OutPackageName, TargetWidth, TargetHeight, OutVariants, VariantError))
     {
         FText Msg = FText::Format(
-            GetLocalizedMessage(
-                TEXT("ConfirmOverwrite"),
-                TEXT("{0} already exists. Do you want to overwrite it?"),
-                TEXT("{0} は既に存在します。上書きしますか？")
-            ),
-            FText::FromString(OutputFileName)
+            GetLocalizedMessage(TEXT("ErrorInvalidVariants"), TEXT("Invalid variant sizes: {0}"), TEXT("バリアントサイズが不正です: {0}")),
+            FText::FromString(VariantError)
         );
+        ShowNotification(Msg, false);
+        return false;
+    }
+
+    // The variants are overwritten along with the main output, so they are confirmed together
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    TArray<FString> ExistingNames;
+    const auto AddIfExists = [&AssetRegistryModule, &ExistingNames](const FString& PackageName)
+    {
+        const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+        if (AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(ObjectPath)).IsValid())
+        {
+            ExistingNames.Add(FPackageName::GetShortName(PackageName));
+        }
+    };
+    AddIfExists(OutPackageName);
+    for (const FChannelPackVariant& Variant : OutVariants)
+    {
+        AddIfExists(Variant.PackageName);
+    }
+
+    if (ExistingNames.Num() > 0)
+    {
+        FText Msg = ExistingNames.Num() == 1
+            ? FText::Format(
+                GetLocalizedMessage(
+                    TEXT("ConfirmOverwrite"),
+                    TEXT("{0} already exists. Do you want to overwrite it?"),
+                    TEXT("{0} は既に存在します。上書きしますか？")
+                ),
+                FText::FromString(ExistingNames[0]))
+            : FText::Format(
+                GetLocalizedMessage(
+                    TEXT("ConfirmOverwriteOutputs"),
+                    TEXT("These outputs already exist. Do you want to overwrite them?\n\n{0}"),
+                    TEXT("次の出力は既に存在します。上書きしますか？\n\n{0}")
+                ),
+                FText::FromString(FString::Join(ExistingNames, TEXT("\n"))));
 
         EAppReturnType::Type Result = FMessageDialog::Open(
             EAppMsgType::YesNo,
@@ -577,13 +1001,30 @@ FReply FTextureChannelPackerModule::OnGenerateClicked()
 
         if (Result == EAppReturnType::No)
         {
-            return FReply::Handled();
+            return false;
         }
     }
 
-    CreateTexture(PackageName, TargetWidth, TargetHeight);
+    return true;
+}
 
-    return FReply::Handled();
+FChannelPackSettings FTextureChannelPackerModule::GetChannelPackSettings() const
+{
+    FChannelPackSettings Settings;
+    Settings.Width = TargetWidth;
+    Settings.Height = TargetHeight;
+    Settings.Filter = GetSelectedResizeFilter();
+    Settings.CompressionSettings = GetSelectedCompressionSettings();
+    Settings.bInvert[0] = bInvertR;
+    Settings.bInvert[1] = bInvertG;
+    Settings.bInvert[2] = bInvertB;
+    Settings.bInvert[3] = bInvertA;
+    Settings.SourceChannels[0] = SourceChannelR;
+    Settings.SourceChannels[1] = SourceChannelG;
+    Settings.SourceChannels[2] = SourceChannelB;
+    Settings.SourceChannels[3] = SourceChannelA;
+    Settings.bSkipUnchanged = bSkipUnchanged;
+    return Settings;
 }
 
 void FTextureChannelPackerModule::AutoGenerateFileName()
@@ -651,557 +1092,440 @@ void FTextureChannelPackerModule::AutoGenerateFileName()
 }
 
 /**
- * @struct FTextureRawData
- * @brief Holds raw texture data extracted from a UTexture2D.
- *
- * This struct is used to transfer texture data from the Game Thread (where UTexture2D is accessible)
- * to background threads for processing. It ensures thread safety by copying necessary data
- * (dimensions, format, raw bytes) beforehand.
+ * @brief Returns the localized progress text shown while a pack job is running, with the time spent
+ * reading the inputs on the Game Thread and decoding compressed ones on the workers.
  */
-struct FTextureRawData
+static FText GetPackProgressText(const FChannelPackJob& Job)
 {
-    TArray<uint8> RawData;
-    int32 Width = 0;
-    int32 Height = 0;
-    ETextureSourceFormat Format = TSF_Invalid;
-    FString TextureName;
-    bool bIsValid = false;
-
-    /**
-     * User-facing error message if extraction failed.
-     * Empty if no error occurred.
-     */
-    FText ErrorMessage;
-};
+    FNumberFormattingOptions SecondsFormat;
+    SecondsFormat.SetMinimumFractionalDigits(2);
+    SecondsFormat.SetMaximumFractionalDigits(2);
 
-/**
- * @struct FTextureProcessResult
- * @brief Represents the result of a texture processing operation.
- *
- * This struct contains the processed pixel data for a specific channel or an error message
- * if the operation failed. It is generated by background threads and consumed by the Game Thread.
- */
-struct FTextureProcessResult
-{
-    TArray<uint8> ProcessedData;
-    FText ErrorMessage;
-    bool bSuccess = true;
-};
-
-/**
- * @brief Extracts raw pixel data from a UTexture2D on the Game Thread.
- *
- * This function accesses the platform-specific source data of a texture asset,
- * locks the mipmap to read raw bytes, and copies them into a thread-safe struct.
- * This MUST be called on the Game Thread.
- *
- * @param SourceTex The source UTexture2D asset.
- * @return FTextureRawData A struct containing the copied raw data and metadata.
- */
-static FTextureRawData ExtractTextureSourceData(UTexture2D* SourceTex)
-{
-    FTextureRawData Result;
-    if (!SourceTex)
+    // A pipelined pass may already be packing some inputs while others decode; show its progress then
+    if (Job.IsDecodingSources() && Job.GetProgress() == 0.0f)
     {
-        return Result;
+        return FText::Format(
+            GetLocalizedMessage(TEXT("ProgressDecoding"), TEXT("Decoding Textures... (read {0} s)"), TEXT("テクスチャをデコード中... (読み込み {0} 秒)")),
+            FText::AsNumber(Job.ExtractSeconds, &SecondsFormat)
+        );
     }
 
-    Result.TextureName = SourceTex->GetName();
-
-#if WITH_EDITORONLY_DATA
-    Result.Width = SourceTex->Source.GetSizeX();
-    Result.Height = SourceTex->Source.GetSizeY();
-    Result.Format = SourceTex->Source.GetFormat();
+    return FText::Format(
+        GetLocalizedMessage(TEXT("ProgressProcessingPercentTimings"), TEXT("Processing Textures... {0}% (read {1} s, decode {2} s)"), TEXT("テクスチャを処理中... {0}% (読み込み {1} 秒、デコード {2} 秒)")),
+        FText::AsNumber(FMath::FloorToInt(Job.GetProgress() * 100.0f)),
+        FText::AsNumber(Job.ExtractSeconds, &SecondsFormat),
+        FText::AsNumber(Job.GetDecodeSeconds(), &SecondsFormat)
+    );
+}
 
-    uint8* SrcData = SourceTex->Source.LockMip(0);
-    if (SrcData)
+void FTextureChannelPackerModule::ShowExtractionErrors(const FChannelPackJob& Job)
+{
+    for (int32 i = 0; i < Job.RawInputs.Num(); ++i)
     {
-        int32 BytesPerPixel = SourceTex->Source.GetBytesPerPixel();
-
-        // Validation 1: Check if BytesPerPixel is valid
-        if (BytesPerPixel == 0)
+        if (Job.FirstSlotOfInput[i] == i && !Job.RawInputs[i].bIsValid && !Job.RawInputs[i].ErrorMessage.IsEmpty())
         {
-            UE_LOG(LogTexturePacker, Error,
-                TEXT("GetBytesPerPixel() returned 0 for texture: %s (Format: %d). This format may not be supported."),
-                *Result.TextureName, (int32)Result.Format);
-            SourceTex->Source.UnlockMip(0);
-            return Result;  // Return invalid result
-        }
-
-        int32 TotalBytes = Result.Width * Result.Height * BytesPerPixel;
-
-        // Validation 2: Check if TotalBytes is valid
-        if (TotalBytes <= 0)
-        {
-            UE_LOG(LogTexturePacker, Error,
-                TEXT("Invalid total bytes (%d) for texture: %s (Width: %d, Height: %d, BPP: %d)"),
-                TotalBytes, *Result.TextureName, Result.Width, Result.Height, BytesPerPixel);
-            SourceTex->Source.UnlockMip(0);
-            return Result;  // Return invalid result
+            ShowNotification(Job.RawInputs[i].ErrorMessage, false);
+            // Continue processing - the channel will be filled with default values
         }
-
-        // Data is valid, proceed with copy
-        Result.RawData.SetNumUninitialized(TotalBytes);
-        FMemory::Memcpy(Result.RawData.GetData(), SrcData, TotalBytes);
-        Result.bIsValid = true;
-    }
-    else
-    {
-        UE_LOG(LogTexturePacker, Warning, TEXT("Failed to lock source mip for texture: %s"), *Result.TextureName);
-        Result.ErrorMessage = GetLocalizedMessage(
-            TEXT("ErrorLockFailed"),
-            TEXT("Failed to access texture data. The texture may be corrupted or in use. Try reimporting the texture."),
-            TEXT("テクスチャデータへのアクセスに失敗しました。テクスチャが破損しているか、使用中の可能性があります。テクスチャを再インポートしてください。")
-        );
     }
-    SourceTex->Source.UnlockMip(0);
-#else
-    UE_LOG(LogTexturePacker, Error, TEXT("TextureChannelPacker requires WITH_EDITORONLY_DATA to access Source."));
-    Result.ErrorMessage = GetLocalizedMessage(
-        TEXT("ErrorNoEditorData"),
-        TEXT("This plugin requires Editor-only data to function. Ensure the project is built with editor support."),
-        TEXT("このプラグインはエディター専用データが必要です。プロジェクトがエディターサポート付きでビルドされていることを確認してください。")
-    );
-#endif
-
-    return Result;
 }
 
-/**
- * @brief Processes raw texture data to produce a single channel of output.
- *
- * This function handles resizing (using FImageUtils) and format conversion (e.g., extracting
- * the Red channel from BGRA, or converting 16-bit grayscale to 8-bit).
- * This function is designed to be thread-safe and run in parallel tasks.
- *
- * @param Input The raw source data extracted from the input texture.
- * @param TargetWidth The target width for the output.
- * @param TargetHeight The target height for the output.
- * @return FTextureProcessResult The processed single-channel 8-bit data.
- */
-static FTextureProcessResult ProcessTextureSourceData(FTextureRawData& Input, int32 TargetWidth, int32 TargetHeight)
+void FTextureChannelPackerModule::CreateTexture(const FString& PackageName, int32 Width, int32 Height, const TArray<FChannelPackVariant>& Variants)
 {
-    FTextureProcessResult Result;
-    // Default to zero-filled array
-    Result.ProcessedData.Init(0, TargetWidth * TargetHeight);
+    check(IsInGameThread());
+    check(!ActivePackJob.IsValid());
 
-    if (!Input.bIsValid)
-    {
-        return Result; // Empty/Invalid input results in black channel (or white if handled by caller default)
-    }
+    FChannelPackSettings Settings = GetChannelPackSettings();
+    Settings.Width = Width;
+    Settings.Height = Height;
 
-    int32 SrcWidth = Input.Width;
-    int32 SrcHeight = Input.Height;
-    int32 NumPixels = SrcWidth * SrcHeight;
-    const uint8* SrcData = Input.RawData.GetData();
+    UTexture2D* const Inputs[4] = { InputTextureR.Get(), InputTextureG.Get(), InputTextureB.Get(), InputTextureA.Get() };
+    FText Error;
+    TSharedPtr<FChannelPackJob> Job = BeginChannelPackJob(PackageName, Inputs, Settings, Variants, &Error);
 
-    // Optimization: Fast path for same-resolution textures
-    if (SrcWidth == TargetWidth && SrcHeight == TargetHeight)
+    if (!Job.IsValid())
     {
-        if (Input.Format == TSF_G8)
-        {
-            // Direct move for Grayscale input (zero-copy optimization)
-            Result.ProcessedData = MoveTemp(Input.RawData);
-            return Result;
-        }
-        else if (Input.Format == TSF_BGRA8)
-        {
-            // Parallel Red-channel extraction for BGRA input
-            Result.ProcessedData.SetNumUninitialized(NumPixels);
-            uint8* DestData = Result.ProcessedData.GetData();
-            const uint8* SrcPtr = SrcData;
-
-            ParallelFor(NumPixels, [DestData, SrcPtr](int32 i)
-            {
-                DestData[i] = SrcPtr[i * 4 + 2]; // R channel in BGRA
-            });
-            return Result;
-        }
+        ShowNotification(
+            !Error.IsEmpty() ? Error : GetLocalizedMessage(
+                TEXT("ErrorPackageCreation"),
+                TEXT("Failed to create package."),
+                TEXT("パッケージの作成に失敗しました。")
+            ),
+            false
+        );
+        return;
     }
 
-    TArray<FColor> SrcColors;
-    SrcColors.SetNumUninitialized(NumPixels);
-
-    // Convert input to FColor (BGRA)
-    switch (Input.Format)
+    // Nothing to pack: the existing asset was generated from the same recipe
+    if (Job->bUpToDate)
     {
-    case TSF_BGRA8:
-    {
-        FMemory::Memcpy(SrcColors.GetData(), SrcData, Input.RawData.Num());
-        break;
+        ActivePackJob = Job;
+        FinishActivePackJob();
+        return;
     }
-    case TSF_G8:
+
+    // A job waiting for the plane cache extracts its inputs later (see TickActivePackJob)
+    if (Job->bInputsExtracted)
     {
-        const uint8* GrayData = SrcData;
-        for (int32 i = 0; i < NumPixels; ++i)
-        {
-            uint8 Val = GrayData[i];
-            SrcColors[i] = FColor(Val, Val, Val, 255);
-        }
-        break;
+        ShowExtractionErrors(*Job);
     }
-    case TSF_G16:
+
+    FNotificationInfo Info(GetPackProgressText(*Job));
+    Info.bFireAndForget = false;
+    Info.bUseThrobber = true;
+    Info.ButtonDetails.Add(FNotificationButtonInfo(
+        GetLocalizedMessage(TEXT("CancelButton"), TEXT("Cancel"), TEXT("キャンセル")),
+        GetLocalizedMessage(TEXT("CancelButtonTooltip"), TEXT("Stops the texture generation."), TEXT("テクスチャ生成を中止します。")),
+        FSimpleDelegate::CreateRaw(this, &FTextureChannelPackerModule::CancelActivePackJob),
+        SNotificationItem::CS_Pending
+    ));
+    Job->Notification = FSlateNotificationManager::Get().AddNotification(Info);
+    if (Job->Notification.IsValid())
     {
-        // 16-bit Grayscale: 2 bytes per pixel
-        const uint16* GrayData16 = (const uint16*)SrcData;
-        for (int32 i = 0; i < NumPixels; ++i)
-        {
-            uint8 Val = (uint8)(GrayData16[i] >> 8);
-            SrcColors[i] = FColor(Val, Val, Val, 255);
-        }
-        break;
+        Job->Notification->SetCompletionState(SNotificationItem::CS_Pending);
     }
-    case TSF_R16F:
+
+    // Follow the task and finalize on the Game Thread
+    ActivePackJob = Job;
+    PackJobTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FTextureChannelPackerModule::TickActivePackJob), 0.1f);
+}
+
+bool FTextureChannelPackerModule::TickActivePackJob(float DeltaTime)
+{
+    if (!ActivePackJob.IsValid())
     {
-        // Half-float: 2 bytes per pixel
-        const FFloat16* Pixel16 = (const FFloat16*)SrcData;
-        for (int32 i = 0; i < NumPixels; ++i)
-        {
-            uint8 Val = (uint8)FMath::Clamp<float>((float)Pixel16[i] * 255.0f, 0.0f, 255.0f);
-            SrcColors[i] = FColor(Val, Val, Val, 255);
-        }
-        break;
+        PackJobTickerHandle.Reset();
+        return false;
     }
-    case TSF_R32F:
+
+    const bool bWasExtracted = ActivePackJob->bInputsExtracted;
+    const bool bKeepRunning = !ActivePackJob->Task.IsCompleted() || AdvanceChannelPackJob(*ActivePackJob);
+    if (!bWasExtracted && ActivePackJob->bInputsExtracted)
     {
-        // Float: 4 bytes per pixel
-        const float* Pixel32 = (const float*)SrcData;
-        for (int32 i = 0; i < NumPixels; ++i)
-        {
-            uint8 Val = (uint8)FMath::Clamp<float>(Pixel32[i] * 255.0f, 0.0f, 255.0f);
-            SrcColors[i] = FColor(Val, Val, Val, 255);
-        }
-        break;
+        ShowExtractionErrors(*ActivePackJob);
     }
-    case TSF_RGBA32F:
+
+    if (bKeepRunning)
     {
-        // Linear Color: 16 bytes per pixel
-        const FLinearColor* LinearColors = (const FLinearColor*)SrcData;
-        for (int32 i = 0; i < NumPixels; ++i)
+        if (ActivePackJob->Notification.IsValid() && !ActivePackJob->Control.IsCancelRequested())
         {
-            uint8 Val = (uint8)FMath::Clamp<float>(LinearColors[i].R * 255.0f, 0.0f, 255.0f);
-            SrcColors[i] = FColor(Val, Val, Val, 255);
+            ActivePackJob->Notification->SetText(GetPackProgressText(*ActivePackJob));
         }
-        break;
-    }
-    default:
-    {
-        UE_LOG(LogTexturePacker, Error, TEXT("Unsupported Source Format: %d for texture: %s"), (int32)Input.Format, *Input.TextureName);
-        Result.bSuccess = false;
-        Result.ErrorMessage = GetLocalizedMessage(
-            TEXT("ErrorUnsupportedFormat"),
-            TEXT("Texture format not supported. Please convert to PNG or TGA."),
-            TEXT("テクスチャ形式がサポートされていません。PNGまたはTGAに変換してください。")
-        );
-        return Result;
-    }
+        return true;
     }
 
-    // Resize if necessary
-    TArray<FColor> ResizedColors;
-    if (SrcWidth != TargetWidth || SrcHeight != TargetHeight)
-    {
-        ResizedColors.SetNum(TargetWidth * TargetHeight);
-        FImageUtils::ImageResize(SrcWidth, SrcHeight, SrcColors, TargetWidth, TargetHeight, ResizedColors, false);
-    }
-    else
+    PackJobTickerHandle.Reset();
+    FinishActivePackJob();
+    return false;
+}
+
+void FTextureChannelPackerModule::CancelActivePackJob()
+{
+    if (!ActivePackJob.IsValid())
     {
-        ResizedColors = MoveTemp(SrcColors);
+        return;
     }
 
-    // Convert FColor (BGRA) to uint8 array (Grayscale, 1 byte per pixel)
-    Result.ProcessedData.SetNumUninitialized(TargetWidth * TargetHeight);
-    uint8* DestData = Result.ProcessedData.GetData();
-    for (int32 i = 0; i < TargetWidth * TargetHeight; ++i)
+    ActivePackJob->Control.Cancel();
+    if (ActivePackJob->Notification.IsValid())
     {
-        const FColor& C = ResizedColors[i];
-        DestData[i] = C.R;
+        ActivePackJob->Notification->SetText(GetLocalizedMessage(TEXT("ProgressCancelling"), TEXT("Cancelling..."), TEXT("キャンセル中...")));
     }
-
-    return Result;
 }
 
-void FTextureChannelPackerModule::CreateTexture(const FString& PackageName, int32 Width, int32 Height)
+void FTextureChannelPackerModule::FinishActivePackJob()
 {
     check(IsInGameThread());
 
-    // Initialize progress dialog with 6 steps total
-    FScopedSlowTask SlowTask(6.0f, GetLocalizedMessage(
-        TEXT("ProgressProcessing"),
-        TEXT("Processing Textures..."),
-        TEXT("テクスチャを処理中...")
-    ));
-    SlowTask.MakeDialog(true); // true = cancellable
-
-    // Create the package using TStrongObjectPtr for RAII
-    TStrongObjectPtr<UPackage> PackagePtr(CreatePackage(*PackageName));
-    UPackage* Package = PackagePtr.Get();
-
-    if (!Package)
+    TSharedPtr<FChannelPackJob> Job = MoveTemp(ActivePackJob);
+    if (!Job.IsValid())
     {
-        ShowNotification(
-            GetLocalizedMessage(
-                TEXT("ErrorPackageCreation"),
-                TEXT("Failed to create package."),
-                TEXT("パッケージの作成に失敗しました。")
-            ),
-            false
-        );
         return;
     }
 
-    Package->FullyLoad();
+    FinishChannelPackJob(*Job);
+    ScheduleScratchArenaTrim();
 
-    // Helper lambda for cleanup on early exit (Cancel/Error)
-    auto CleanupOnEarlyExit = [&Package, &PackageName]()
+    if (Job->Notification.IsValid())
     {
-        if (Package && !Package->IsDirty())
+        Job->Notification->SetCompletionState(Job->bSucceeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+        Job->Notification->Fadeout();
+    }
+
+    if (!Job->bSucceeded)
+    {
+        if (Job->Control.IsCancelRequested())
         {
-            UE_LOG(LogTexturePacker, Warning, TEXT("Package creation cancelled. Cleaning up: %s"), *PackageName);
-            Package->ClearFlags(RF_Standalone | RF_MarkAsRootSet);
-            Package->MarkAsGarbage();
+            FText CancelMsg = GetLocalizedMessage(
+                TEXT("OperationCancelled"),
+                TEXT("Texture generation was cancelled by user."),
+                TEXT("テクスチャ生成がユーザーによってキャンセルされました。")
+            );
+            ShowNotification(CancelMsg, false);
         }
-    };
-
-    SlowTask.EnterProgressFrame(1.0f, GetLocalizedMessage(
-        TEXT("ProgressPackageCreated"),
-        TEXT("Package created. Loading input textures..."),
-        TEXT("パッケージを作成しました。入力テクスチャを読み込み中...")
-    ));
+        else if (const FTextureRawData* FailedInput = Job->RawInputs.FindByPredicate([](const FTextureRawData& Raw) { return !Raw.bIsValid && !Raw.ErrorMessage.IsEmpty(); }))
+        {
+            // An input that could only be read once the job was running (decoding, later passes)
+            ShowNotification(FailedInput->ErrorMessage, false);
+        }
+        else
+        {
+            ShowNotification(GetLocalizedMessage(
+                TEXT("ErrorOutputLockFailed"),
+                TEXT("Failed to write the output texture data."),
+                TEXT("出力テクスチャデータの書き込みに失敗しました。")
+            ), false);
+        }
+        return;
+    }
 
-    if (SlowTask.ShouldCancel())
+    if (Job->bUpToDate)
     {
-        CleanupOnEarlyExit();
-        FText CancelMsg = GetLocalizedMessage(
-            TEXT("OperationCancelled"),
-            TEXT("Texture generation was cancelled by user."),
-            TEXT("テクスチャ生成がユーザーによってキャンセルされました。")
-        );
-        ShowNotification(CancelMsg, false);
+        FText UpToDatePattern = GetLocalizedMessage(TEXT("TextureUpToDate"), TEXT("Texture is up to date: {0}"), TEXT("テクスチャは最新です: {0}"));
+        ShowNotification(FText::Format(UpToDatePattern, FText::FromString(Job->PackageName)), true);
         return;
     }
 
-    // Create the Texture2D
-    FName TextureName = FName(*FPaths::GetBaseFilename(PackageName));
-    UTexture2D* NewTexture = NewObject<UTexture2D>(Package, TextureName, RF_Public | RF_Standalone | RF_MarkAsRootSet);
-
-    // ---------------------------------------------------------
-    // STEP 1: Extract Raw Data from Inputs (Game Thread)
-    // ---------------------------------------------------------
-    SlowTask.EnterProgressFrame(1.0f, GetLocalizedMessage(
-        TEXT("ProgressExtracting"),
-        TEXT("Extracting source data..."),
-        TEXT("ソースデータを抽出中...")
-    ));
+    FText FormatPattern = GetLocalizedMessage(TEXT("SuccessTextureSaved"), TEXT("Texture Saved: {0}"), TEXT("テクスチャを保存しました: {0}"));
+    ShowNotification(FText::Format(FormatPattern, FText::FromString(Job->PackageName)), true);
+}
 
-    if (SlowTask.ShouldCancel())
+FReply FTextureChannelPackerModule::OnAddToQueueClicked()
+{
+    FString PackageName;
+    TArray<FChannelPackVariant> Variants;
+    if (Batch->IsRunning() || !ValidateOutputAndGetPackageName(PackageName, Variants))
     {
-        CleanupOnEarlyExit();
-        FText CancelMsg = GetLocalizedMessage(
-            TEXT("OperationCancelled"),
-            TEXT("Texture generation was cancelled by user."),
-            TEXT("テクスチャ生成がユーザーによってキャンセルされました。")
-        );
-        ShowNotification(CancelMsg, false);
-        return;
+        return FReply::Handled();
     }
 
-    TArray<FTextureRawData> RawInputs;
-    RawInputs.SetNum(4); // R, G, B, A
-
-    RawInputs[0] = ExtractTextureSourceData(InputTextureR.Get());
-    RawInputs[1] = ExtractTextureSourceData(InputTextureG.Get());
-    RawInputs[2] = ExtractTextureSourceData(InputTextureB.Get());
-    RawInputs[3] = ExtractTextureSourceData(InputTextureA.Get());
-
-    // ---------------------------------------------------------
-    // STEP 2: Process Data in Parallel (Background Threads)
-    // ---------------------------------------------------------
-    SlowTask.EnterProgressFrame(2.0f, GetLocalizedMessage(
-        TEXT("ProgressProcessingParallel"),
-        TEXT("Resizing and processing channels..."),
-        TEXT("チャンネルのリサイズと処理中...")
-    ));
+    FChannelPackBatchItem Item;
+    Item.PackageName = PackageName;
+    Item.Settings = GetChannelPackSettings();
+    Item.Variants = MoveTemp(Variants);
 
-    if (SlowTask.ShouldCancel())
+    const TWeakObjectPtr<UTexture2D> Inputs[4] = { InputTextureR, InputTextureG, InputTextureB, InputTextureA };
+    for (int32 i = 0; i < 4; ++i)
     {
-        CleanupOnEarlyExit();
-        FText CancelMsg = GetLocalizedMessage(
-            TEXT("OperationCancelled"),
-            TEXT("Texture generation was cancelled by user."),
-            TEXT("テクスチャ生成がユーザーによってキャンセルされました。")
-        );
-        ShowNotification(CancelMsg, false);
-        return;
+        if (Inputs[i].IsValid())
+        {
+            Item.Inputs[i] = FSoftObjectPath(Inputs[i].Get());
+        }
     }
 
-    TArray<FTextureProcessResult> ProcessedResults;
-    ProcessedResults.SetNum(4);
+    Batch->Add(Item);
+    BatchListView->RequestListRefresh();
 
-    ParallelFor(4, [&](int32 Index)
+    UE_LOG(LogTexturePacker, Log, TEXT("Queued %s"), *PackageName);
+    return FReply::Handled();
+}
+
+FReply FTextureChannelPackerModule::OnImportManifestClicked()
+{
+    IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+    if (!DesktopPlatform || Batch->IsRunning())
     {
-        ProcessedResults[Index] = ProcessTextureSourceData(RawInputs[Index], Width, Height);
-    });
+        return FReply::Handled();
+    }
 
-    if (SlowTask.ShouldCancel())
+    TArray<FString> Files;
+    const bool bOpened = DesktopPlatform->OpenFileDialog(
+        FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+        GetLocalizedMessage(TEXT("ImportManifestTitle"), TEXT("Import Job Manifest"), TEXT("ジョブマニフェストを読み込み")).ToString(),
+        FPaths::ProjectDir(),
+        TEXT(""),
+        TEXT("Job Manifest (*.json;*.csv)|*.json;*.csv"),
+        EFileDialogFlags::None,
+        Files);
+
+    if (!bOpened || Files.Num() == 0)
     {
-        CleanupOnEarlyExit();
-        FText CancelMsg = GetLocalizedMessage(
-            TEXT("OperationCancelled"),
-            TEXT("Texture generation was cancelled by user."),
-            TEXT("テクスチャ生成がユーザーによってキャンセルされました。")
-        );
-        ShowNotification(CancelMsg, false);
-        return;
+        return FReply::Handled();
     }
 
-    // Check for errors
-    for (const auto& Res : ProcessedResults)
+    TArray<FChannelPackBatchItem> Items;
+    FString Error;
+    if (!LoadChannelPackManifest(Files[0], Items, Error))
     {
-        if (!Res.bSuccess && !Res.ErrorMessage.IsEmpty())
-        {
-            ShowNotification(Res.ErrorMessage, false);
-            // We continue, treating it as black/default, but user is warned.
-            // Alternatively, return here to abort.
-        }
+        UE_LOG(LogTexturePacker, Error, TEXT("Invalid manifest %s: %s"), *Files[0], *Error);
+        ShowNotification(FText::Format(
+            GetLocalizedMessage(TEXT("ErrorInvalidManifest"), TEXT("Invalid manifest: {0}"), TEXT("マニフェストが不正です: {0}")),
+            FText::FromString(Error)), false);
+        return FReply::Handled();
     }
 
-    // Check for errors from texture extraction
-    for (int32 i = 0; i < RawInputs.Num(); ++i)
+    // Ask once for the whole manifest instead of once per existing output; variants are outputs too
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    int32 NumOutputs = 0;
+    int32 NumExisting = 0;
+    const auto CountOutput = [&AssetRegistryModule, &NumOutputs, &NumExisting](const FString& PackageName)
     {
-        if (!RawInputs[i].bIsValid && !RawInputs[i].ErrorMessage.IsEmpty())
+        const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+        NumExisting += AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(ObjectPath)).IsValid() ? 1 : 0;
+        ++NumOutputs;
+    };
+    for (const FChannelPackBatchItem& Item : Items)
+    {
+        CountOutput(Item.PackageName);
+        for (const FChannelPackVariant& Variant : Item.Variants)
         {
-            ShowNotification(RawInputs[i].ErrorMessage, false);
-            // Continue processing - the channel will be filled with default values
+            CountOutput(Variant.PackageName);
         }
     }
 
-#if WITH_EDITORONLY_DATA
-    // ---------------------------------------------------------
-    // STEP 3: Write to Output Texture (Game Thread)
-    // ---------------------------------------------------------
-    // Initialize Source
-    NewTexture->Source.Init(Width, Height, 1, 1, TSF_BGRA8);
-
-    SlowTask.EnterProgressFrame(1.0f, GetLocalizedMessage(
-        TEXT("ProgressWritingPixels"),
-        TEXT("Writing pixel data..."),
-        TEXT("ピクセルデータを書き込み中...")
-    ));
-
-    if (SlowTask.ShouldCancel())
+    if (NumExisting > 0)
     {
-        CleanupOnEarlyExit();
-        FText CancelMsg = GetLocalizedMessage(
-            TEXT("OperationCancelled"),
-            TEXT("Texture generation was cancelled by user."),
-            TEXT("テクスチャ生成がユーザーによってキャンセルされました。")
+        FText Msg = FText::Format(
+            GetLocalizedMessage(
+                TEXT("ConfirmOverwriteManifest"),
+                TEXT("{0} of the {1} outputs already exist. Do you want to overwrite them?"),
+                TEXT("{1} 個の出力のうち {0} 個は既に存在します。上書きしますか？")
+            ),
+            FText::AsNumber(NumExisting),
+            FText::AsNumber(NumOutputs)
         );
-        ShowNotification(CancelMsg, false);
-        return;
+
+        if (FMessageDialog::Open(EAppMsgType::YesNo, Msg) == EAppReturnType::No)
+        {
+            return FReply::Handled();
+        }
     }
 
-    // Lock and Write Pixels directly to Source
-    uint8* MipData = NewTexture->Source.LockMip(0);
-    if (MipData)
+    for (const FChannelPackBatchItem& Item : Items)
     {
-        // Invert channels if requested
-        auto InvertChannel = [](TArray<uint8>& Data)
-        {
-            for (int32 i = 0; i < Data.Num(); ++i)
-            {
-                Data[i] = 255 - Data[i];
-            }
-        };
+        Batch->Add(Item);
+    }
+    BatchListView->RequestListRefresh();
 
-        if (bInvertR && ProcessedResults[0].ProcessedData.Num() > 0) InvertChannel(ProcessedResults[0].ProcessedData);
-        if (bInvertG && ProcessedResults[1].ProcessedData.Num() > 0) InvertChannel(ProcessedResults[1].ProcessedData);
-        if (bInvertB && ProcessedResults[2].ProcessedData.Num() > 0) InvertChannel(ProcessedResults[2].ProcessedData);
-        if (bInvertA && ProcessedResults[3].ProcessedData.Num() > 0) InvertChannel(ProcessedResults[3].ProcessedData);
+    UE_LOG(LogTexturePacker, Log, TEXT("Queued %d textures from %s"), Items.Num(), *Files[0]);
+    return FReply::Handled();
+}
 
-        const uint8* TempR = ProcessedResults[0].ProcessedData.Num() > 0 ? ProcessedResults[0].ProcessedData.GetData() : nullptr;
-        const uint8* TempG = ProcessedResults[1].ProcessedData.Num() > 0 ? ProcessedResults[1].ProcessedData.GetData() : nullptr;
-        const uint8* TempB = ProcessedResults[2].ProcessedData.Num() > 0 ? ProcessedResults[2].ProcessedData.GetData() : nullptr;
-        const uint8* TempA = ProcessedResults[3].ProcessedData.Num() > 0 ? ProcessedResults[3].ProcessedData.GetData() : nullptr;
+FReply FTextureChannelPackerModule::OnRunQueueClicked()
+{
+    if (Batch->IsRunning())
+    {
+        Batch->Cancel();
+        return FReply::Handled();
+    }
 
-        // Pre-fill defaults for null channels to eliminate branches in the main loop
-        TArray<uint8> DefaultR, DefaultG, DefaultB, DefaultA;
+    if (ActivePackJob.IsValid())
+    {
+        FText Msg = GetLocalizedMessage(TEXT("ErrorJobRunning"), TEXT("A texture is already being generated. Please wait or cancel it."), TEXT("テクスチャを生成中です。完了するまで待つか、キャンセルしてください。"));
+        ShowNotification(Msg, false);
+        return FReply::Handled();
+    }
 
-        const uint8* PtrR = TempR;
-        const uint8* PtrG = TempG;
-        const uint8* PtrB = TempB;
-        const uint8* PtrA = TempA;
+    Batch->Start(FMath::Max(1, CVarChannelPackBatchJobsInFlight.GetValueOnGameThread()));
+    if (Batch->IsRunning())
+    {
+        BatchTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FTextureChannelPackerModule::TickBatch), 0.0f);
+    }
+    return FReply::Handled();
+}
 
-        if (!PtrR)
-        {
-            DefaultR.Init(0, Width * Height);
-            if (bInvertR) InvertChannel(DefaultR);
-            PtrR = DefaultR.GetData();
-        }
-        if (!PtrG)
-        {
-            DefaultG.Init(0, Width * Height);
-            if (bInvertG) InvertChannel(DefaultG);
-            PtrG = DefaultG.GetData();
-        }
-        if (!PtrB)
-        {
-            DefaultB.Init(0, Width * Height);
-            if (bInvertB) InvertChannel(DefaultB);
-            PtrB = DefaultB.GetData();
-        }
-        if (!PtrA)
-        {
-            DefaultA.Init(255, Width * Height);
-            if (bInvertA) InvertChannel(DefaultA);
-            PtrA = DefaultA.GetData();
-        }
+FReply FTextureChannelPackerModule::OnClearQueueClicked()
+{
+    Batch->ClearFinishedAndPending();
+    BatchListView->RequestListRefresh();
+    return FReply::Handled();
+}
 
-        // Parallel, branch-free pixel writing
-        ParallelFor(Width * Height, [MipData, PtrR, PtrG, PtrB, PtrA](int32 i)
-        {
-            int32 Offset = i * 4;
-            MipData[Offset + 0] = PtrB[i]; // B
-            MipData[Offset + 1] = PtrG[i]; // G
-            MipData[Offset + 2] = PtrR[i]; // R
-            MipData[Offset + 3] = PtrA[i]; // A
-        });
+bool FTextureChannelPackerModule::TickBatch(float DeltaTime)
+{
+    if (Batch->Tick(BatchTickBudgetSeconds))
+    {
+        return true;
     }
-    NewTexture->Source.UnlockMip(0);
-#endif
 
-    SlowTask.EnterProgressFrame(1.0f, GetLocalizedMessage(
-        TEXT("ProgressFinalizing"),
-        TEXT("Finalizing texture..."),
-        TEXT("テクスチャを最終処理中...")
-    ));
+    BatchTickerHandle.Reset();
+    ScheduleScratchArenaTrim();
+
+    const int32 NumSucceeded = Batch->GetNumItems(EChannelPackBatchItemState::Succeeded);
+    const int32 NumFailed = Batch->GetNumItems(EChannelPackBatchItemState::Failed);
+    FText Msg = FText::Format(
+        GetLocalizedMessage(TEXT("BatchFinished"), TEXT("Batch finished: {0} succeeded, {1} failed"), TEXT("バッチ完了: 成功 {0} / 失敗 {1}")),
+        FText::AsNumber(NumSucceeded),
+        FText::AsNumber(NumFailed));
+    ShowNotification(Msg, NumFailed == 0);
+    return false;
+}
 
-    if (SlowTask.ShouldCancel())
+bool FTextureChannelPackerModule::TickScratchArenaTrim(float DeltaTime)
+{
+    FChannelPackScratchArena& Arena = FChannelPackScratchArena::Get();
+    Arena.TrimIdle();
+    if (Arena.GetStats().CachedBytes > 0)
     {
-        CleanupOnEarlyExit();
-        FText CancelMsg = GetLocalizedMessage(
-            TEXT("OperationCancelled"),
-            TEXT("Texture generation was cancelled by user."),
-            TEXT("テクスチャ生成がユーザーによってキャンセルされました。")
-        );
-        ShowNotification(CancelMsg, false);
-        return;
+        return true;
     }
 
-    // Final settings
-    NewTexture->CompressionSettings = GetSelectedCompressionSettings();
-
-    // Even if TC_Default is selected, treat it as linear (sRGB=false) for channel packing purposes.
-    NewTexture->SRGB = false;
+    ScratchArenaTrimTickerHandle.Reset();
+    return false;
+}
 
-    NewTexture->UpdateResource();
-    NewTexture->PostEditChange();
+void FTextureChannelPackerModule::ScheduleScratchArenaTrim()
+{
+    if (!ScratchArenaTrimTickerHandle.IsValid())
+    {
+        ScratchArenaTrimTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FTextureChannelPackerModule::TickScratchArenaTrim), 1.0f);
+    }
+}
 
-    Package->MarkPackageDirty();
-    FAssetRegistryModule::AssetCreated(NewTexture);
+TSharedRef<ITableRow> FTextureChannelPackerModule::GenerateBatchItemRow(TSharedPtr<FChannelPackBatchItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(STableRow<TSharedPtr<FChannelPackBatchItem>>, OwnerTable)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            .VAlign(VAlign_Center)
+            [
+                SNew(STextBlock)
+                .Text(FText::FromString(FPackageName::GetShortName(Item->PackageName)))
+                .ToolTipText(FText::FromString(Item->PackageName))
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            [
+                SNew(STextBlock)
+                .Text_Lambda([Item]()
+                {
+                    switch (Item->State)
+                    {
+                    case EChannelPackBatchItemState::Running:
+                        return GetLocalizedMessage(TEXT("BatchItemRunning"), TEXT("Running"), TEXT("処理中"));
+                    case EChannelPackBatchItemState::Succeeded:
+                    {
+                        if (Item->bUpToDate)
+                        {
+                            return GetLocalizedMessage(TEXT("BatchItemUpToDate"), TEXT("Up to date"), TEXT("最新"));
+                        }
 
-    FText FormatPattern = GetLocalizedMessage(TEXT("SuccessTextureSaved"), TEXT("Texture Saved: {0}"), TEXT("テクスチャを保存しました: {0}"));
-    ShowNotification(FText::Format(FormatPattern, FText::FromString(PackageName)), true);
+                        FNumberFormattingOptions SecondsFormat;
+                        SecondsFormat.SetMaximumFractionalDigits(2);
+                        return FText::Format(
+                            GetLocalizedMessage(TEXT("BatchItemSucceeded"), TEXT("Done ({0} s)"), TEXT("完了 ({0} 秒)")),
+                            FText::AsNumber(Item->LoadSeconds + Item->DecodeSeconds + Item->PackSeconds + Item->FinishSeconds, &SecondsFormat));
+                    }
+                    case EChannelPackBatchItemState::Failed:
+                        return GetLocalizedMessage(TEXT("BatchItemFailed"), TEXT("Failed"), TEXT("失敗"));
+                    case EChannelPackBatchItemState::Cancelled:
+                        return GetLocalizedMessage(TEXT("BatchItemCancelled"), TEXT("Cancelled"), TEXT("キャンセル"));
+                    default:
+                        return GetLocalizedMessage(TEXT("BatchItemPending"), TEXT("Pending"), TEXT("待機中"));
+                    }
+                })
+                .ToolTipText_Lambda([Item]()
+                {
+                    return FText::FromString(Item->Error);
+                })
+            ]
+        ];
 }
 
 void FTextureChannelPackerModule::ShowNotification(const FText& Message, bool bSuccess)
@@ -1235,6 +1559,15 @@ TextureCompressionSettings FTextureChannelPackerModule::GetSelectedCompressionSe
     return TC_Masks; // Fallback
 }
 
+ETextureResizeFilter FTextureChannelPackerModule::GetSelectedResizeFilter() const
+{
+    if (CurrentResizeFilterOption.IsValid())
+    {
+        return CurrentResizeFilterOption->Filter;
+    }
+    return ETextureResizeFilter::Bilinear; // Fallback
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FTextureChannelPackerModule, TextureChannelPacker)
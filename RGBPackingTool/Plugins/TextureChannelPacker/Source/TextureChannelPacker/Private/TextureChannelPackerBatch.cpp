@@ -0,0 +1,642 @@
+#include "TextureChannelPackerBatch.h"
+#include "Engine/Texture2D.h"
+#include "UObject/Package.h"
+#include "Misc/PackageName.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/Csv/CsvParser.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/PlatformTime.h"
+
+/** Output channel names used as manifest column suffixes (InputR, InvertR, ChannelR, ...). */
+static const TCHAR* const ChannelPackSlotNames[4] = { TEXT("R"), TEXT("G"), TEXT("B"), TEXT("A") };
+
+// ---------------------------------------------------------
+// Manifest Parsing
+// ---------------------------------------------------------
+
+static bool ParseCompressionName(const FString& Name, TextureCompressionSettings& OutSettings)
+{
+    if (Name == TEXT("Masks"))     { OutSettings = TC_Masks; return true; }
+    if (Name == TEXT("Grayscale")) { OutSettings = TC_Grayscale; return true; }
+    if (Name == TEXT("Default"))   { OutSettings = TC_Default; return true; }
+    return false;
+}
+
+static bool ParseResizeFilterName(const FString& Name, ETextureResizeFilter& OutFilter)
+{
+    if (Name == TEXT("Box"))        { OutFilter = ETextureResizeFilter::Box; return true; }
+    if (Name == TEXT("Bilinear"))   { OutFilter = ETextureResizeFilter::Bilinear; return true; }
+    if (Name == TEXT("Mitchell"))   { OutFilter = ETextureResizeFilter::Mitchell; return true; }
+    if (Name == TEXT("CatmullRom")) { OutFilter = ETextureResizeFilter::CatmullRom; return true; }
+    if (Name == TEXT("Lanczos3"))   { OutFilter = ETextureResizeFilter::Lanczos3; return true; }
+    return false;
+}
+
+static bool ParseSourceChannelName(const FString& Name, ETextureSourceChannel& OutChannel)
+{
+    if (Name == TEXT("Red") || Name == TEXT("R"))       { OutChannel = ETextureSourceChannel::Red; return true; }
+    if (Name == TEXT("Green") || Name == TEXT("G"))     { OutChannel = ETextureSourceChannel::Green; return true; }
+    if (Name == TEXT("Blue") || Name == TEXT("B"))      { OutChannel = ETextureSourceChannel::Blue; return true; }
+    if (Name == TEXT("Alpha") || Name == TEXT("A"))     { OutChannel = ETextureSourceChannel::Alpha; return true; }
+    if (Name == TEXT("Luminance") || Name == TEXT("L")) { OutChannel = ETextureSourceChannel::Luminance; return true; }
+    return false;
+}
+
+/**
+ * @brief Applies the settings found in one manifest row (or the JSON "Defaults" object) on top of OutSettings.
+ *
+ * Keys are case-insensitive; missing or empty values keep the current setting.
+ */
+static bool ParseManifestSettings(const TMap<FString, FString>& Row, FChannelPackSettings& OutSettings, FString& OutError)
+{
+    const FString* Value = Row.Find(TEXT("Width"));
+    if (Value && !Value->IsEmpty())
+    {
+        OutSettings.Width = FCString::Atoi(**Value);
+    }
+
+    Value = Row.Find(TEXT("Height"));
+    if (Value && !Value->IsEmpty())
+    {
+        OutSettings.Height = FCString::Atoi(**Value);
+    }
+
+    if (OutSettings.Width < 1 || OutSettings.Width > ChannelPackMaxResolution || OutSettings.Height < 1 || OutSettings.Height > ChannelPackMaxResolution)
+    {
+        OutError = FString::Printf(TEXT("Width and Height must each be between 1 and %d (got %d x %d)"), ChannelPackMaxResolution, OutSettings.Width, OutSettings.Height);
+        return false;
+    }
+
+    Value = Row.Find(TEXT("Compression"));
+    if (Value && !Value->IsEmpty() && !ParseCompressionName(*Value, OutSettings.CompressionSettings))
+    {
+        OutError = FString::Printf(TEXT("Unknown Compression '%s' (expected Masks, Grayscale or Default)"), **Value);
+        return false;
+    }
+
+    Value = Row.Find(TEXT("Filter"));
+    if (Value && !Value->IsEmpty() && !ParseResizeFilterName(*Value, OutSettings.Filter))
+    {
+        OutError = FString::Printf(TEXT("Unknown Filter '%s' (expected Box, Bilinear, Mitchell, CatmullRom or Lanczos3)"), **Value);
+        return false;
+    }
+
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        Value = Row.Find(FString(TEXT("Invert")) + ChannelPackSlotNames[Slot]);
+        if (Value && !Value->IsEmpty())
+        {
+            OutSettings.bInvert[Slot] = FCString::ToBool(**Value);
+        }
+
+        Value = Row.Find(FString(TEXT("Channel")) + ChannelPackSlotNames[Slot]);
+        if (Value && !Value->IsEmpty() && !ParseSourceChannelName(*Value, OutSettings.SourceChannels[Slot]))
+        {
+            OutError = FString::Printf(TEXT("Unknown Channel%s '%s' (expected Red, Green, Blue, Alpha or Luminance)"), ChannelPackSlotNames[Slot], **Value);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** Turns one manifest row into a batch item, starting from the manifest defaults. */
+static bool ParseManifestItem(const TMap<FString, FString>& Row, const FChannelPackSettings& Defaults, FChannelPackBatchItem& OutItem, FString& OutError)
+{
+    const FString* Output = Row.Find(TEXT("Output"));
+    if (!Output || Output->IsEmpty())
+    {
+        OutError = TEXT("Missing Output");
+        return false;
+    }
+
+    OutItem.PackageName = *Output;
+    if (!FPackageName::IsValidLongPackageName(OutItem.PackageName))
+    {
+        OutError = FString::Printf(TEXT("Output '%s' is not a valid long package name (e.g., /Game/Textures/T_Rock_ORM)"), *OutItem.PackageName);
+        return false;
+    }
+
+    bool bHasInput = false;
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        const FString* Input = Row.Find(FString(TEXT("Input")) + ChannelPackSlotNames[Slot]);
+        FString InputPath = Input ? Input->TrimStartAndEnd() : FString();
+        if (InputPath.IsEmpty())
+        {
+            continue;
+        }
+
+        // Accept package names ("/Game/T_AO") as well as object paths ("/Game/T_AO.T_AO")
+        if (!InputPath.Contains(TEXT(".")))
+        {
+            InputPath += TEXT(".") + FPackageName::GetShortName(InputPath);
+        }
+        OutItem.Inputs[Slot] = FSoftObjectPath(InputPath);
+        bHasInput = true;
+    }
+
+    if (!bHasInput)
+    {
+        OutError = TEXT("At least one of InputR, InputG, InputB or InputA is required");
+        return false;
+    }
+
+    OutItem.Settings = Defaults;
+    if (!ParseManifestSettings(Row, OutItem.Settings, OutError))
+    {
+        return false;
+    }
+
+    const FString* Variants = Row.Find(TEXT("Variants"));
+    return !Variants || ParseChannelPackVariants(*Variants, OutItem.PackageName, OutItem.Settings.Width, OutItem.Settings.Height, OutItem.Variants, OutError);
+}
+
+/** Flattens a JSON object into a key/value row. Numbers and booleans are converted to strings. */
+static TMap<FString, FString> JsonObjectToManifestRow(const FJsonObject& Object)
+{
+    TMap<FString, FString> Row;
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+    {
+        FString Value;
+        if (Field.Value.IsValid() && Field.Value->TryGetString(Value))
+        {
+            Row.Add(Field.Key, Value);
+        }
+    }
+    return Row;
+}
+
+/**
+ * @brief Reads a JSON manifest: { "Defaults": { ... }, "Jobs": [ { "Output": ..., "InputR": ..., ... } ] }.
+ */
+static bool LoadJsonManifest(const FString& Contents, TArray<FChannelPackBatchItem>& OutItems, FString& OutError)
+{
+    TSharedPtr<FJsonObject> Root;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Invalid JSON: %s"), *Reader->GetErrorMessage());
+        return false;
+    }
+
+    FChannelPackSettings Defaults;
+    const TSharedPtr<FJsonObject>* DefaultsObject = nullptr;
+    if (Root->TryGetObjectField(TEXT("Defaults"), DefaultsObject) && !ParseManifestSettings(JsonObjectToManifestRow(**DefaultsObject), Defaults, OutError))
+    {
+        OutError = TEXT("Defaults: ") + OutError;
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Jobs = nullptr;
+    if (!Root->TryGetArrayField(TEXT("Jobs"), Jobs))
+    {
+        OutError = TEXT("Missing \"Jobs\" array");
+        return false;
+    }
+
+    for (int32 Index = 0; Index < Jobs->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* JobObject = nullptr;
+        if (!(*Jobs)[Index]->TryGetObject(JobObject))
+        {
+            OutError = FString::Printf(TEXT("Jobs[%d] is not an object"), Index);
+            return false;
+        }
+
+        FChannelPackBatchItem Item;
+        if (!ParseManifestItem(JsonObjectToManifestRow(**JobObject), Defaults, Item, OutError))
+        {
+            OutError = FString::Printf(TEXT("Jobs[%d]: %s"), Index, *OutError);
+            return false;
+        }
+        OutItems.Add(MoveTemp(Item));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads a CSV manifest. The first row holds the column names (Output, InputR, ..., Width, ...).
+ */
+static bool LoadCsvManifest(const FString& Contents, TArray<FChannelPackBatchItem>& OutItems, FString& OutError)
+{
+    const FCsvParser Parser(Contents);
+    const FCsvParser::FRows& Rows = Parser.GetRows();
+    if (Rows.Num() == 0)
+    {
+        OutError = TEXT("Empty CSV");
+        return false;
+    }
+
+    const TArray<const TCHAR*>& Header = Rows[0];
+    const FChannelPackSettings Defaults;
+    for (int32 RowIndex = 1; RowIndex < Rows.Num(); ++RowIndex)
+    {
+        // Skip blank lines
+        if (Rows[RowIndex].Num() == 0 || (Rows[RowIndex].Num() == 1 && FCString::Strlen(Rows[RowIndex][0]) == 0))
+        {
+            continue;
+        }
+
+        TMap<FString, FString> Row;
+        for (int32 Column = 0; Column < Header.Num() && Column < Rows[RowIndex].Num(); ++Column)
+        {
+            Row.Add(FString(Header[Column]).TrimStartAndEnd(), FString(Rows[RowIndex][Column]).TrimStartAndEnd());
+        }
+
+        FChannelPackBatchItem Item;
+        if (!ParseManifestItem(Row, Defaults, Item, OutError))
+        {
+            OutError = FString::Printf(TEXT("Line %d: %s"), RowIndex + 1, *OutError);
+            return false;
+        }
+        OutItems.Add(MoveTemp(Item));
+    }
+
+    return true;
+}
+
+bool LoadChannelPackManifest(const FString& ManifestPath, TArray<FChannelPackBatchItem>& OutItems, FString& OutError)
+{
+    FString Contents;
+    if (!FFileHelper::LoadFileToString(Contents, *ManifestPath))
+    {
+        OutError = FString::Printf(TEXT("Failed to read %s"), *ManifestPath);
+        return false;
+    }
+
+    const bool bIsCsv = FPaths::GetExtension(ManifestPath).Equals(TEXT("csv"), ESearchCase::IgnoreCase);
+    return bIsCsv ? LoadCsvManifest(Contents, OutItems, OutError) : LoadJsonManifest(Contents, OutItems, OutError);
+}
+
+
+// ---------------------------------------------------------
+// FChannelPackBatch
+// ---------------------------------------------------------
+
+/** Returns the error of the first input the job could not read, or an empty string if it read them all (so far). */
+static FString GetUnreadableInputError(const FChannelPackJob& Job)
+{
+    for (const FTextureRawData& Raw : Job.RawInputs)
+    {
+        if (!Raw.bIsValid && !Raw.TextureName.IsEmpty())
+        {
+            return FString::Printf(TEXT("Failed to read input %s"), *Raw.TextureName);
+        }
+    }
+    return FString();
+}
+
+void FChannelPackBatch::Add(const FChannelPackBatchItem& Item)
+{
+    check(!bRunning);
+    Items.Add(MakeShared<FChannelPackBatchItem>(Item));
+}
+
+void FChannelPackBatch::ClearFinishedAndPending()
+{
+    Items.RemoveAll([](const TSharedPtr<FChannelPackBatchItem>& Item)
+    {
+        return Item->State != EChannelPackBatchItemState::Running;
+    });
+    NextItemIndex = 0;
+}
+
+void FChannelPackBatch::Start(int32 InMaxJobsInFlight)
+{
+    check(IsInGameThread());
+    if (bRunning)
+    {
+        return;
+    }
+
+    MaxJobsInFlight = FMath::Max(1, InMaxJobsInFlight);
+    NextItemIndex = 0;
+    NumItemsInRun = GetNumItems(EChannelPackBatchItemState::Pending);
+    NumFinishedInRun = 0;
+    bCancelRequested = false;
+    bRunning = NumItemsInRun > 0;
+}
+
+bool FChannelPackBatch::Tick(double TimeBudgetSeconds)
+{
+    check(IsInGameThread());
+    if (!bRunning)
+    {
+        return false;
+    }
+
+    const double TickStartTime = FPlatformTime::Seconds();
+
+    // Finalize completed jobs first, so their buffers are released before new inputs are extracted
+    for (int32 Index = 0; Index < Running.Num();)
+    {
+        FChannelPackJob& Job = *Running[Index].Job;
+        const bool bWasExtracted = Job.bInputsExtracted;
+        bool bKeepRunning = !Job.Task.IsCompleted() || AdvanceChannelPackJob(Job);
+
+        // A job waiting for the plane cache extracts its inputs when it advances
+        if (!bWasExtracted && Job.bInputsExtracted)
+        {
+            FChannelPackBatchItem& Item = *Running[Index].Item;
+            Item.LoadSeconds += Job.ExtractSeconds;
+            Item.Error = GetUnreadableInputError(Job);
+            if (!Item.Error.IsEmpty())
+            {
+                Job.Control.Cancel();
+                Job.Task.Wait();
+                Job.bSucceeded = false;
+                bKeepRunning = false;
+            }
+        }
+
+        if (!bKeepRunning)
+        {
+            const FRunningItem Completed = Running[Index];
+            Running.RemoveAt(Index);
+            FinishItem(*Completed.Item, Completed.Job.Get());
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    // Keep the workers fed: start pending jobs while there is room
+    ReleaseSavedOutputs();
+    bool bStartedAny = false;
+    while (!bCancelRequested && Running.Num() < MaxJobsInFlight
+        && (!bStartedAny || TimeBudgetSeconds <= 0.0 || FPlatformTime::Seconds() - TickStartTime < TimeBudgetSeconds))
+    {
+        TSharedPtr<FChannelPackBatchItem> Item = FindNextPendingItem();
+        if (!Item.IsValid())
+        {
+            break;
+        }
+
+        // A job that does not fit waits for a running one to finish; a lone job always starts
+        if (Running.Num() > 0 && !FitsMemoryBudget(*Item))
+        {
+            break;
+        }
+
+        StartItem(Item);
+        bStartedAny = true;
+    }
+
+    if (Running.Num() == 0 && (bCancelRequested || !FindNextPendingItem().IsValid()))
+    {
+        bRunning = false;
+
+        // The charges of unsaved outputs only hold back the jobs of this run; nothing would release them
+        // if the user never saves
+        UnsavedOutputs.Reset();
+
+        const FChannelPackScratchArenaStats ArenaStats = FChannelPackScratchArena::Get().GetStats();
+        UE_LOG(LogTexturePacker, Log, TEXT("Scratch arena after the batch: %lld buffers, %.1f%% reused, %.1f MB cached (peak %.1f MB), %lld blocks freed"),
+            ArenaStats.NumAcquired, ArenaStats.GetReuseRate() * 100.0, ArenaStats.CachedBytes / (1024.0 * 1024.0),
+            ArenaStats.PeakCachedBytes / (1024.0 * 1024.0), ArenaStats.NumFreed);
+    }
+    return bRunning;
+}
+
+void FChannelPackBatch::WaitForAnyJob() const
+{
+    if (Running.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<UE::Tasks::FTask> Tasks;
+    for (const FRunningItem& RunningItem : Running)
+    {
+        Tasks.Add(RunningItem.Job->Task);
+    }
+    UE::Tasks::WaitAny(Tasks);
+}
+
+void FChannelPackBatch::Cancel()
+{
+    bCancelRequested = true;
+    for (const FRunningItem& RunningItem : Running)
+    {
+        RunningItem.Job->Control.Cancel();
+    }
+}
+
+float FChannelPackBatch::GetProgress() const
+{
+    if (NumItemsInRun == 0)
+    {
+        return 0.0f;
+    }
+
+    float Finished = (float)NumFinishedInRun;
+    for (const FRunningItem& RunningItem : Running)
+    {
+        Finished += RunningItem.Job->GetProgress();
+    }
+    return FMath::Clamp(Finished / NumItemsInRun, 0.0f, 1.0f);
+}
+
+int32 FChannelPackBatch::GetNumItems(EChannelPackBatchItemState State) const
+{
+    int32 Count = 0;
+    for (const TSharedPtr<FChannelPackBatchItem>& Item : Items)
+    {
+        Count += (Item->State == State) ? 1 : 0;
+    }
+    return Count;
+}
+
+TSharedPtr<FChannelPackBatchItem> FChannelPackBatch::FindNextPendingItem()
+{
+    while (NextItemIndex < Items.Num() && Items[NextItemIndex]->State != EChannelPackBatchItemState::Pending)
+    {
+        ++NextItemIndex;
+    }
+    if (NextItemIndex < Items.Num())
+    {
+        return Items[NextItemIndex];
+    }
+    return nullptr;
+}
+
+bool FChannelPackBatch::LoadItemInputs(FChannelPackBatchItem& Item, UTexture2D* (&OutInputs)[4])
+{
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        OutInputs[Slot] = nullptr;
+        if (Item.Inputs[Slot].IsNull())
+        {
+            continue;
+        }
+
+        OutInputs[Slot] = Cast<UTexture2D>(Item.Inputs[Slot].TryLoad());
+        if (!OutInputs[Slot])
+        {
+            Item.Error = FString::Printf(TEXT("Input %s not found or not a Texture2D"), *Item.Inputs[Slot].ToString());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FChannelPackBatch::FitsMemoryBudget(FChannelPackBatchItem& Item) const
+{
+    if (Item.EstimatedPeakBytes == 0)
+    {
+        UTexture2D* Inputs[4];
+        if (!LoadItemInputs(Item, Inputs))
+        {
+            Item.Error.Reset();
+            return true;
+        }
+        Item.EstimatedPeakBytes = EstimateChannelPackJobBytes(Inputs, Item.Settings, Item.Variants);
+    }
+
+    // Jobs are charged by their tracked buffers as they go; before that, their estimate holds their place.
+    // The global tracker also counts the unsaved outputs and the blocks cached by the scratch arena.
+    auto GetReservedBytes = [this]()
+    {
+        int64 ReservedBytes = 0;
+        for (const FRunningItem& RunningItem : Running)
+        {
+            const FChannelPackJob& Job = *RunningItem.Job;
+            ReservedBytes += FMath::Max(Job.EstimatedPeakBytes, Job.Memory.GetCurrentBytes());
+        }
+        return FMath::Max(ReservedBytes, FChannelPackMemoryTracker::GetGlobal().GetCurrentBytes());
+    };
+
+    const int64 Budget = GetChannelPackMemoryBudget();
+    if (GetReservedBytes() + Item.EstimatedPeakBytes <= Budget)
+    {
+        return true;
+    }
+
+    // Cached scratch blocks only save allocations; give them up before holding back a job
+    FChannelPackScratchArena& Arena = FChannelPackScratchArena::Get();
+    if (Arena.GetStats().CachedBytes == 0)
+    {
+        return false;
+    }
+    Arena.Trim(0.0);
+    return GetReservedBytes() + Item.EstimatedPeakBytes <= Budget;
+}
+
+void FChannelPackBatch::StartItem(const TSharedPtr<FChannelPackBatchItem>& Item)
+{
+    Item->State = EChannelPackBatchItemState::Running;
+    Item->Error.Reset();
+    Item->bUpToDate = false;
+
+    const double LoadStartTime = FPlatformTime::Seconds();
+    UTexture2D* Inputs[4];
+    TSharedPtr<FChannelPackJob> Job;
+    if (LoadItemInputs(*Item, Inputs))
+    {
+        FText Error;
+        Job = BeginChannelPackJob(Item->PackageName, Inputs, Item->Settings, Item->Variants, &Error);
+        if (!Job.IsValid())
+        {
+            Item->Error = !Error.IsEmpty() ? Error.ToString() : TEXT("Failed to create package");
+        }
+    }
+
+    // Unlike a single pack from the editor tab, a batch item never packs a default value in place of an
+    // unreadable input. A job waiting for the plane cache is checked once it has extracted them (see Tick).
+    if (Job.IsValid() && Job->bInputsExtracted)
+    {
+        Item->Error = GetUnreadableInputError(*Job);
+        if (!Item->Error.IsEmpty())
+        {
+            Job->Control.Cancel();
+            Job->Task.Wait();
+            Job->bSucceeded = false;
+        }
+    }
+    Item->LoadSeconds = FPlatformTime::Seconds() - LoadStartTime;
+
+    if (Job.IsValid() && Item->Error.IsEmpty() && Job->Task.IsValid())
+    {
+        Running.Add({ Item, Job });
+    }
+    else
+    {
+        FinishItem(*Item, Job.Get());
+    }
+}
+
+void FChannelPackBatch::FinishItem(FChannelPackBatchItem& Item, FChannelPackJob* Job)
+{
+    if (Job)
+    {
+        const double FinishStartTime = FPlatformTime::Seconds();
+        FinishChannelPackJob(*Job);
+        Item.DecodeSeconds = Job->GetDecodeSeconds();
+        Item.PackSeconds = Job->PackSeconds;
+        Item.PeakBytes = Job->Memory.GetPeakBytes();
+        Item.bUpToDate = Job->bUpToDate;
+
+        if (Job->bSucceeded)
+        {
+            if (OnJobFinalized)
+            {
+                OnJobFinalized(Item, *Job);
+            }
+            TrackUnsavedOutputs(*Job);
+        }
+        else if (Item.Error.IsEmpty() && !Job->Control.IsCancelRequested())
+        {
+            // Jobs packed in several passes only read their later inputs when the pass starts
+            Item.Error = GetUnreadableInputError(*Job);
+            if (Item.Error.IsEmpty())
+            {
+                Item.Error = TEXT("Failed to write the output texture data");
+            }
+        }
+        Item.FinishSeconds = FPlatformTime::Seconds() - FinishStartTime;
+
+        Item.State = !Item.Error.IsEmpty() ? EChannelPackBatchItemState::Failed
+            : Job->bSucceeded ? EChannelPackBatchItemState::Succeeded
+            : EChannelPackBatchItemState::Cancelled;
+    }
+    else
+    {
+        Item.State = EChannelPackBatchItemState::Failed;
+    }
+
+    ++NumFinishedInRun;
+    if (OnItemFinished)
+    {
+        OnItemFinished(Item);
+    }
+}
+
+void FChannelPackBatch::TrackUnsavedOutputs(const FChannelPackJob& Job)
+{
+    if (!Job.bUpToDate && Job.Package.IsValid() && Job.Package->IsDirty())
+    {
+        FUnsavedOutput& Output = UnsavedOutputs.AddDefaulted_GetRef();
+        Output.Package = Job.Package.Get();
+        Output.Charge = FChannelPackMemoryCharge((int64)Job.Settings.Width * Job.Settings.Height * 4, FChannelPackMemoryTracker::GetGlobal());
+    }
+
+    for (const TSharedPtr<FChannelPackJob>& VariantJob : Job.VariantJobs)
+    {
+        TrackUnsavedOutputs(*VariantJob);
+    }
+}
+
+void FChannelPackBatch::ReleaseSavedOutputs()
+{
+    UnsavedOutputs.RemoveAll([](const FUnsavedOutput& Output)
+    {
+        const UPackage* Package = Output.Package.Get();
+        return !Package || !Package->IsDirty();
+    });
+}
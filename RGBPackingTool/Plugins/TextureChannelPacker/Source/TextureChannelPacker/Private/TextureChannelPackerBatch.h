@@ -0,0 +1,183 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "TextureChannelPackerJob.h"
+
+/** Lifecycle of one item of an FChannelPackBatch. */
+enum class EChannelPackBatchItemState : uint8
+{
+    Pending,
+    Running,
+    Succeeded,
+    Failed,
+    Cancelled,
+};
+
+/**
+ * @struct FChannelPackBatchItem
+ * @brief One texture set of a batch: the output asset, its inputs and settings, and the outcome.
+ */
+struct FChannelPackBatchItem
+{
+    /** Long package name of the output asset (e.g., "/Game/Textures/T_Rock_ORM"). */
+    FString PackageName;
+
+    /** Input textures for R, G, B and A. Null paths leave the slot empty. */
+    FSoftObjectPath Inputs[4];
+
+    FChannelPackSettings Settings;
+
+    /** Smaller outputs resampled from the same pack (see FChannelPackVariant). */
+    TArray<FChannelPackVariant> Variants;
+
+    EChannelPackBatchItemState State = EChannelPackBatchItemState::Pending;
+
+    /** Why the item failed. Empty unless State is Failed. */
+    FString Error;
+
+    /** The output asset already matched the recipe and was not repacked. Only set when State is Succeeded. */
+    bool bUpToDate = false;
+
+    /** Game Thread time spent loading and extracting the inputs and starting the job. */
+    double LoadSeconds = 0.0;
+
+    /** Worker time spent decoding compressed inputs, before the packing task starts. */
+    double DecodeSeconds = 0.0;
+
+    /** Worker time of the packing task. */
+    double PackSeconds = 0.0;
+
+    /** Game Thread time spent finalizing (and, in the commandlet, saving) the asset. */
+    double FinishSeconds = 0.0;
+
+    /** Peak memory the job is expected to need (EstimateChannelPackJobBytes), set when the item is considered for starting. */
+    int64 EstimatedPeakBytes = 0;
+
+    /** Peak memory the job's buffers actually used, counted by its FChannelPackMemoryTracker. */
+    int64 PeakBytes = 0;
+};
+
+/**
+ * @class FChannelPackBatch
+ * @brief Runs many pack jobs so that the Game Thread stages of one job overlap the packing of others.
+ *
+ * Pending items are started in order on the Game Thread (input loading, extraction,
+ * Source.Init/LockMip) while up to MaxJobsInFlight packing tasks run and the estimated peak of the
+ * next job fits in GetChannelPackMemoryBudget() next to the jobs in flight, and completed jobs are
+ * finalized (PostEditChange) as soon as they finish. Each pack is split into band-pulling tasks,
+ * one per worker; the task scheduler's workers steal queued tasks from each other, so a worker
+ * that runs out of bands in one job picks up the band tasks of the other jobs in flight instead
+ * of idling while the Game Thread prepares the next job.
+ *
+ * Used by the editor tab's batch queue (ticked with a time budget) and by the commandlet
+ * (ticked in a blocking loop with WaitForAnyJob). All methods must be called on the Game Thread.
+ */
+class FChannelPackBatch
+{
+public:
+    /** Called after a successful job has been finalized. Setting Item.Error fails the item (e.g., save errors). */
+    TFunction<void(FChannelPackBatchItem& Item, FChannelPackJob& Job)> OnJobFinalized;
+
+    /** Called whenever an item reaches Succeeded, Failed or Cancelled. */
+    TFunction<void(const FChannelPackBatchItem& Item)> OnItemFinished;
+
+    /** Appends an item in the Pending state. Items cannot be added while the batch is running. */
+    void Add(const FChannelPackBatchItem& Item);
+
+    /** Removes every item that is not running. */
+    void ClearFinishedAndPending();
+
+    /** All items in queue order. */
+    const TArray<TSharedPtr<FChannelPackBatchItem>>& GetItems() const { return Items; }
+
+    /** Starts running the pending items with at most MaxJobsInFlight packing tasks at a time. */
+    void Start(int32 InMaxJobsInFlight);
+
+    /**
+     * @brief Finalizes completed jobs and starts pending ones.
+     *
+     * @param TimeBudgetSeconds Stops starting new jobs once this much time has been spent (0 = no limit).
+     *                          At least one job is started per call if there is room.
+     * @return true while the batch is running.
+     */
+    bool Tick(double TimeBudgetSeconds = 0.0);
+
+    /** Blocks until at least one running job has completed its packing task. */
+    void WaitForAnyJob() const;
+
+    /** Cancels the running jobs and stops starting new ones. Pending items stay pending. */
+    void Cancel();
+
+    bool IsRunning() const { return bRunning; }
+
+    /** Fraction of the items of the current run that have finished, counting partial progress of running jobs. */
+    float GetProgress() const;
+
+    /** Number of items in the given state. */
+    int32 GetNumItems(EChannelPackBatchItemState State) const;
+
+private:
+    struct FRunningItem
+    {
+        TSharedPtr<FChannelPackBatchItem> Item;
+        TSharedPtr<FChannelPackJob> Job;
+    };
+
+    /** A finished output whose package has not been saved yet: its BGRA8 source stays in memory. */
+    struct FUnsavedOutput
+    {
+        TWeakObjectPtr<UPackage> Package;
+        FChannelPackMemoryCharge Charge;
+    };
+
+    /** Loads the input textures of an item. Returns false with Item.Error set if one of them cannot be loaded. */
+    static bool LoadItemInputs(FChannelPackBatchItem& Item, UTexture2D* (&OutInputs)[4]);
+
+    /**
+     * Returns whether the estimated peak of Item fits in the memory budget next to the running jobs, each
+     * counted at its estimate or its current tracked bytes, whichever is larger, the finished outputs that
+     * are not saved yet and the blocks cached by the scratch arena. The arena is trimmed before an item is held back. Items whose inputs cannot be
+     * loaded always fit, so that StartItem reports them.
+     */
+    bool FitsMemoryBudget(FChannelPackBatchItem& Item) const;
+
+    /** Loads the inputs and begins the job. Items that fail to start are finished immediately. */
+    void StartItem(const TSharedPtr<FChannelPackBatchItem>& Item);
+
+    /** Finalizes a job (which may not have been started) and records the outcome on its item. */
+    void FinishItem(FChannelPackBatchItem& Item, FChannelPackJob* Job);
+
+    /**
+     * Keeps charging the global tracker for the outputs of a finalized job that OnJobFinalized did not
+     * save (the editor leaves them dirty for the user to save), so that admission counts them. The
+     * charges are dropped when they are saved or unloaded, and all of them when the run ends or is cancelled.
+     */
+    void TrackUnsavedOutputs(const FChannelPackJob& Job);
+
+    /** Drops the charges of unsaved outputs that have since been saved or unloaded. */
+    void ReleaseSavedOutputs();
+
+    /** Returns the next pending item at or after NextItemIndex, or null. */
+    TSharedPtr<FChannelPackBatchItem> FindNextPendingItem();
+
+    TArray<TSharedPtr<FChannelPackBatchItem>> Items;
+    TArray<FRunningItem> Running;
+    TArray<FUnsavedOutput> UnsavedOutputs;
+    int32 NextItemIndex = 0;
+    int32 MaxJobsInFlight = 2;
+    int32 NumItemsInRun = 0;
+    int32 NumFinishedInRun = 0;
+    bool bRunning = false;
+    bool bCancelRequested = false;
+};
+
+/**
+ * @brief Reads a JSON or CSV job manifest (chosen by file extension) into batch items.
+ *
+ * JSON: { "Defaults": { settings }, "Jobs": [ { "Output": ..., "InputR": ..., settings }, ... ] }.
+ * CSV: the first row names the columns (Output, InputR, ..., Width, ...). See Docs/API.md for the keys.
+ *
+ * @return false with OutError set if the file cannot be read or a job is invalid.
+ */
+bool LoadChannelPackManifest(const FString& ManifestPath, TArray<FChannelPackBatchItem>& OutItems, FString& OutError);
@@ -0,0 +1,1542 @@
+#include "TextureChannelPackerJob.h"
+#include "TextureChannelPackerRecipe.h"
+#include "TextureChannelPackerPlaneCache.h"
+#include "TextureChannelPackerStats.h"
+#include "TextureChannelPackerResampler.h"
+#include "Engine/Texture2D.h"
+#include "UObject/Package.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "ObjectTools.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeExit.h"
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/Culture.h"
+#include "IImageWrapperModule.h"
+#include "IImageWrapper.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogTexturePacker);
+
+DECLARE_CYCLE_STAT(TEXT("Extract"), STAT_ChannelPack_Extract, STATGROUP_TextureChannelPacker);
+DECLARE_CYCLE_STAT(TEXT("Decode"), STAT_ChannelPack_Decode, STATGROUP_TextureChannelPacker);
+DECLARE_CYCLE_STAT(TEXT("UpdateResource"), STAT_ChannelPack_UpdateResource, STATGROUP_TextureChannelPacker);
+DECLARE_CYCLE_STAT(TEXT("PostEditChange"), STAT_ChannelPack_PostEditChange, STATGROUP_TextureChannelPacker);
+
+static TAutoConsoleVariable<bool> CVarChannelPackUseSourceMips(
+    TEXT("TextureChannelPacker.UseSourceMips"),
+    true,
+    TEXT("Read the source mip of exactly the output size, if the source has one, instead of resizing mip 0. Other sizes always read mip 0."));
+
+static TAutoConsoleVariable<bool> CVarChannelPackAsyncSourceDecode(
+    TEXT("TextureChannelPacker.AsyncSourceDecode"),
+    true,
+    TEXT("Decode PNG and JPEG compressed sources on worker threads instead of on the Game Thread during extraction."));
+
+static TAutoConsoleVariable<bool> CVarChannelPackPipelined(
+    TEXT("TextureChannelPacker.Pipelined"),
+    true,
+    TEXT("When two or more inputs are extracted, convert and resize each input as soon as it is extracted and decoded, while the next input is read, and interleave each band once every input has produced it, instead of packing after all inputs."));
+
+static TAutoConsoleVariable<int32> CVarChannelPackMemoryBudgetMB(
+    TEXT("TextureChannelPacker.MemoryBudgetMB"),
+    0,
+    TEXT("Memory budget of the packs in flight in MB. Packs whose inputs and output do not fit together are written one input at a time, and a batch starts another job only if it fits next to the running ones. 0 uses a quarter of the physical memory."));
+
+FText GetLocalizedMessage(const FString& Key, const FString& EnglishText, const FString& JapaneseText)
+{
+    FString CultureName = FInternationalization::Get().GetCurrentCulture()->GetTwoLetterISOLanguageName();
+    if (CultureName == TEXT("ja"))
+    {
+        return FText::FromString(JapaneseText);
+    }
+    // We return FText::FromString to avoid unsafe usage of internal localization macros with dynamic strings.
+    return FText::FromString(EnglishText);
+}
+
+EChannelPackSourceFormat GetChannelPackSourceFormat(ETextureSourceFormat Format)
+{
+    switch (Format)
+    {
+    case TSF_G8:      return EChannelPackSourceFormat::G8;
+    case TSF_BGRA8:   return EChannelPackSourceFormat::BGRA8;
+    case TSF_G16:     return EChannelPackSourceFormat::G16;
+    case TSF_R16F:    return EChannelPackSourceFormat::R16F;
+    case TSF_R32F:    return EChannelPackSourceFormat::R32F;
+    case TSF_RGBA32F: return EChannelPackSourceFormat::RGBA32F;
+    default:          return EChannelPackSourceFormat::Invalid;
+    }
+}
+
+int32 SelectChannelPackSourceMip(UTexture2D* SourceTex, int32 Width, int32 Height)
+{
+#if WITH_EDITORONLY_DATA
+    if (!SourceTex || Width <= 0 || Height <= 0 || !CVarChannelPackUseSourceMips.GetValueOnGameThread())
+    {
+        return 0;
+    }
+
+    const FTextureSource& Source = SourceTex->Source;
+    return FindChannelPackSourceMipOfSize(Source.GetSizeX(), Source.GetSizeY(), Source.GetNumMips(), Width, Height);
+#else
+    return 0;
+#endif
+}
+
+#if WITH_EDITORONLY_DATA
+/** Returns the image format of a source stored as a single PNG or JPEG image, or EImageFormat::Invalid. */
+static EImageFormat GetCompressedSourceImageFormat(const FTextureSource& Source)
+{
+    if (Source.GetNumMips() != 1 || Source.GetNumLayers() != 1 || Source.GetNumBlocks() != 1)
+    {
+        return EImageFormat::Invalid;
+    }
+
+    switch (Source.GetSourceCompression())
+    {
+    case TSCF_PNG:
+        return EImageFormat::PNG;
+    case TSCF_JPEG:
+        return EImageFormat::JPEG;
+    default:
+        return EImageFormat::Invalid;
+    }
+}
+#endif
+
+FTextureRawData ExtractTextureSourceData(UTexture2D* SourceTex, int32 Width, int32 Height)
+{
+    CHANNEL_PACK_STAGE_SCOPE("Extract", STAT_ChannelPack_Extract);
+
+    FTextureRawData Result;
+    if (!SourceTex)
+    {
+        return Result;
+    }
+
+    Result.TextureName = SourceTex->GetName();
+
+#if WITH_EDITORONLY_DATA
+    Result.MipIndex = SelectChannelPackSourceMip(SourceTex, Width, Height);
+    Result.Width = FMath::Max(1, SourceTex->Source.GetSizeX() >> Result.MipIndex);
+    Result.Height = FMath::Max(1, SourceTex->Source.GetSizeY() >> Result.MipIndex);
+    Result.Format = SourceTex->Source.GetFormat();
+
+    // Validation 0: Reject formats the packing engine cannot read before touching the mip data
+    if (!IsChannelPackSourceFormatSupported(GetChannelPackSourceFormat(Result.Format)))
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Unsupported Source Format: %d for texture: %s"), (int32)Result.Format, *Result.TextureName);
+        Result.ErrorMessage = GetLocalizedMessage(
+            TEXT("ErrorUnsupportedFormat"),
+            TEXT("Texture format not supported. Please convert to PNG or TGA."),
+            TEXT("テクスチャ形式がサポートされていません。PNGまたはTGAに変換してください。")
+        );
+        return Result;
+    }
+
+    IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>("ImageWrapper");
+
+    // PNG and JPEG sources: only fetch the payload here, the pixels are decoded on a worker (DecodeTextureSourceData)
+    const EImageFormat CompressedFormat = GetCompressedSourceImageFormat(SourceTex->Source);
+    if (CompressedFormat != EImageFormat::Invalid && CVarChannelPackAsyncSourceDecode.GetValueOnGameThread())
+    {
+        FSharedBuffer Payload;
+        SourceTex->Source.OperateOnLoadedBulkData([&Payload](const FSharedBuffer& BulkData) { Payload = BulkData; });
+        TSharedPtr<IImageWrapper> Decoder = ImageWrapperModule.CreateImageWrapper(CompressedFormat);
+        if (!Payload.IsNull() && Decoder.IsValid())
+        {
+            Result.CompressedData = MoveTemp(Payload);
+            Result.Decoder = MoveTemp(Decoder);
+            Result.bIsValid = true;
+            return Result;
+        }
+    }
+
+    FTextureSource::FMipData MipData = SourceTex->Source.GetMipData(&ImageWrapperModule);
+    FSharedBuffer SrcData = MipData.GetMipData(0, 0, Result.MipIndex);
+    if (!SrcData.IsNull())
+    {
+        int32 BytesPerPixel = SourceTex->Source.GetBytesPerPixel();
+
+        // Validation 1: Check if BytesPerPixel is valid
+        if (BytesPerPixel == 0)
+        {
+            UE_LOG(LogTexturePacker, Error,
+                TEXT("GetBytesPerPixel() returned 0 for texture: %s (Format: %d). This format may not be supported."),
+                *Result.TextureName, (int32)Result.Format);
+            return Result;  // Return invalid result
+        }
+
+        int64 TotalBytes = (int64)Result.Width * Result.Height * BytesPerPixel;
+
+        // Validation 2: Check if TotalBytes is valid and covered by the mip data
+        if (TotalBytes <= 0 || (int64)SrcData.GetSize() < TotalBytes)
+        {
+            UE_LOG(LogTexturePacker, Error,
+                TEXT("Invalid total bytes (%lld, mip data: %llu) for texture: %s (Width: %d, Height: %d, BPP: %d)"),
+                TotalBytes, (uint64)SrcData.GetSize(), *Result.TextureName, Result.Width, Result.Height, BytesPerPixel);
+            return Result;  // Return invalid result
+        }
+
+        // Data is valid; share it with the workers without copying
+        Result.RawData = MoveTemp(SrcData);
+        Result.bIsValid = true;
+
+        if (Result.MipIndex > 0)
+        {
+            UE_LOG(LogTexturePacker, Log, TEXT("Reading mip %d (%d x %d) of %s for a %d x %d pack"),
+                Result.MipIndex, Result.Width, Result.Height, *Result.TextureName, Width, Height);
+        }
+    }
+    else
+    {
+        UE_LOG(LogTexturePacker, Warning, TEXT("Failed to read source mip for texture: %s"), *Result.TextureName);
+        Result.ErrorMessage = GetLocalizedMessage(
+            TEXT("ErrorLockFailed"),
+            TEXT("Failed to access texture data. The texture may be corrupted or in use. Try reimporting the texture."),
+            TEXT("テクスチャデータへのアクセスに失敗しました。テクスチャが破損しているか、使用中の可能性があります。テクスチャを再インポートしてください。")
+        );
+    }
+#else
+    UE_LOG(LogTexturePacker, Error, TEXT("TextureChannelPacker requires WITH_EDITORONLY_DATA to access Source."));
+    Result.ErrorMessage = GetLocalizedMessage(
+        TEXT("ErrorNoEditorData"),
+        TEXT("This plugin requires Editor-only data to function. Ensure the project is built with editor support."),
+        TEXT("このプラグインはエディター専用データが必要です。プロジェクトがエディターサポート付きでビルドされていることを確認してください。")
+    );
+#endif
+
+    return Result;
+}
+
+bool DecodeTextureSourceData(FTextureRawData& Raw)
+{
+    if (!Raw.NeedsDecode())
+    {
+        return Raw.bIsValid && !Raw.RawData.IsNull();
+    }
+
+    CHANNEL_PACK_STAGE_SCOPE("Decode", STAT_ChannelPack_Decode);
+
+    // Decode to the layout the source format describes
+    ERGBFormat RGBFormat = ERGBFormat::Invalid;
+    int32 BitDepth = 8;
+    int32 BytesPerPixel = 1;
+    switch (Raw.Format)
+    {
+    case TSF_G8:
+        RGBFormat = ERGBFormat::Gray;
+        break;
+    case TSF_G16:
+        RGBFormat = ERGBFormat::Gray;
+        BitDepth = 16;
+        BytesPerPixel = 2;
+        break;
+    case TSF_BGRA8:
+        RGBFormat = ERGBFormat::BGRA;
+        BytesPerPixel = 4;
+        break;
+    default:
+        return false;
+    }
+
+    TArray64<uint8> Pixels;
+    if (!Raw.Decoder->SetCompressed(Raw.CompressedData.GetData(), Raw.CompressedData.GetSize())
+        || Raw.Decoder->GetWidth() != Raw.Width || Raw.Decoder->GetHeight() != Raw.Height
+        || !Raw.Decoder->GetRaw(RGBFormat, BitDepth, Pixels)
+        || Pixels.Num() != (int64)Raw.Width * Raw.Height * BytesPerPixel)
+    {
+        return false;
+    }
+
+    Raw.RawData = MakeSharedBufferFromArray(MoveTemp(Pixels));
+    Raw.CompressedData.Reset();
+    Raw.Decoder.Reset();
+    return true;
+}
+
+// ---------------------------------------------------------
+// Plane Cache
+// ---------------------------------------------------------
+
+/** Returns the first slot with the same plane cache key as Slot (Slot itself if none), or INDEX_NONE if Slot is not cached. */
+static int32 FindPlaneCacheOwner(const FChannelPackJob& Job, int32 Slot)
+{
+    if (Job.PlaneCacheKeys[Slot].IsEmpty())
+    {
+        return INDEX_NONE;
+    }
+
+    int32 Owner = 0;
+    while (Job.PlaneCacheKeys[Owner] != Job.PlaneCacheKeys[Slot])
+    {
+        ++Owner;
+    }
+    return Owner;
+}
+
+/**
+ * Builds the plane cache key of every slot worth caching and looks up the planes in the cache.
+ * @return true if lookups were issued; Job.Task then completes once they have.
+ */
+static bool RequestCachedPlanes(FChannelPackJob& Job, UTexture2D* const (&Inputs)[4])
+{
+    TArray<FString> Keys;
+    TArray<int32> KeySlots;
+#if WITH_EDITORONLY_DATA
+    const FChannelPackSettings& Settings = Job.Settings;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        UTexture2D* Input = Inputs[i];
+        if (!Input || !Input->Source.IsValid())
+        {
+            continue;
+        }
+
+        const FTextureSource& Source = Input->Source;
+        const int32 SourceMip = SelectChannelPackSourceMip(Input, Settings.Width, Settings.Height);
+        const int32 SourceWidth = FMath::Max(1, Source.GetSizeX() >> SourceMip);
+        const int32 SourceHeight = FMath::Max(1, Source.GetSizeY() >> SourceMip);
+        if (!ShouldCacheChannelPackPlane(SourceWidth, SourceHeight, Source.GetFormat(), Settings.Width, Settings.Height))
+        {
+            continue;
+        }
+
+        // Single-channel formats provide the same plane whichever channel is selected
+        const ETextureSourceChannel SourceChannel = IsSingleChannelFormat(GetChannelPackSourceFormat(Source.GetFormat())) ? ETextureSourceChannel::Red : Settings.SourceChannels[i];
+        Job.PlaneCacheKeys[i] = MakeChannelPackPlaneCacheKey(Source.GetId(), SourceMip, SourceChannel, Settings.Width, Settings.Height, Settings.Filter);
+
+        // Slots reading the same plane share one lookup
+        if (FindPlaneCacheOwner(Job, i) == i)
+        {
+            Keys.Add(Job.PlaneCacheKeys[i]);
+            KeySlots.Add(i);
+        }
+    }
+#endif
+    if (Keys.Num() == 0)
+    {
+        return false;
+    }
+
+    // The responses arrive on the cache's threads; each one writes the plane of its own slot
+    FChannelPackJob* JobPtr = &Job;
+    Job.PlaneCacheLookupStartTime = FPlatformTime::Seconds();
+    Job.NumPendingPlaneLookups = Keys.Num();
+    Job.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, []() {}, UE::Tasks::Prerequisites(Job.PlaneCacheLookupsDone));
+    RequestChannelPackPlanes(Keys, (int64)Job.Settings.Width * Job.Settings.Height, Job.PlaneCacheRequest,
+        [JobPtr, KeySlots](int32 KeyIndex, FChannelPackCachedPlane&& Plane)
+    {
+        JobPtr->CachedPlanes[KeySlots[KeyIndex]] = MoveTemp(Plane);
+        if (JobPtr->NumPendingPlaneLookups.fetch_sub(1) == 1)
+        {
+            JobPtr->PlaneCacheLookupsDone.Trigger();
+        }
+    });
+    return true;
+}
+
+/** Counts the planes fetched by RequestCachedPlanes against the job, once the lookups have completed. */
+static void ChargeCachedPlanes(FChannelPackJob& Job)
+{
+    int64 CachedBytes = 0;
+    for (const FChannelPackCachedPlane& CachedPlane : Job.CachedPlanes)
+    {
+        CachedBytes += (int64)CachedPlane.Payload.GetSize();
+    }
+    Job.CachedPlanesCharge = FChannelPackMemoryCharge(CachedBytes, Job.Memory);
+}
+
+/** Returns whether every slot reading the input of Slot gets its plane from the cache, so the input need not be extracted. */
+static bool AreAllPlanesOfInputCached(const FChannelPackJob& Job, int32 Slot)
+{
+    for (int32 i = 0; i < 4; ++i)
+    {
+        if (Job.FirstSlotOfInput[i] == Slot)
+        {
+            const int32 Owner = FindPlaneCacheOwner(Job, i);
+            if (Owner == INDEX_NONE || !Job.CachedPlanes[Owner].IsValid())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** Describes an input that is not extracted now (its planes all come from the cache, or a later pass extracts it): valid, but without source data. */
+static FTextureRawData DescribeUnextractedInput(UTexture2D* SourceTex, int32 Width, int32 Height)
+{
+    FTextureRawData Result;
+    Result.TextureName = SourceTex->GetName();
+#if WITH_EDITORONLY_DATA
+    Result.MipIndex = SelectChannelPackSourceMip(SourceTex, Width, Height);
+    Result.Width = FMath::Max(1, SourceTex->Source.GetSizeX() >> Result.MipIndex);
+    Result.Height = FMath::Max(1, SourceTex->Source.GetSizeY() >> Result.MipIndex);
+    Result.Format = SourceTex->Source.GetFormat();
+#endif
+    Result.bIsValid = true;
+    return Result;
+}
+
+/** Stores the planes resized by a successful job in the cache and logs the cache results. */
+static void StoreCapturedPlanes(FChannelPackJob& Job)
+{
+    int32 Hits = 0;
+    int32 Misses = 0;
+    int32 NumProducedChannels = 0;
+    double SavedSeconds = -Job.PlaneCacheFetchSeconds;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        Hits += Job.CachedPlanes[i].IsValid() ? 1 : 0;
+        Misses += Job.CapturedPlanes[i].IsValid() ? 1 : 0;
+        NumProducedChannels += Job.Channels[i].Source.IsValid() ? 1 : 0;
+        if (Job.CachedPlanes[i].IsValid())
+        {
+            SavedSeconds += Job.CachedPlanes[i].ProduceSeconds;
+        }
+    }
+
+    // The pack time is not measured per plane; split it evenly over the channels that read a source
+    const double SecondsPerPlane = Job.PackSeconds / FMath::Max(1, NumProducedChannels);
+    for (int32 i = 0; i < 4; ++i)
+    {
+        if (Job.CapturedPlanes[i].IsValid())
+        {
+            StoreChannelPackPlane(Job.PlaneCacheKeys[i], MoveTemp(Job.CapturedPlanes[i]), SecondsPerPlane);
+        }
+        Job.CachedPlanes[i] = FChannelPackCachedPlane();
+    }
+    Job.CachedPlanesCharge.Reset();
+
+    RecordChannelPackPlaneCacheResults(Job.PackageName, Hits, Misses, SavedSeconds);
+}
+
+// ---------------------------------------------------------
+// Outputs and Variants
+// ---------------------------------------------------------
+
+bool ParseChannelPackVariants(const FString& Text, const FString& PackageName, int32 Width, int32 Height, TArray<FChannelPackVariant>& OutVariants, FString& OutError)
+{
+    OutVariants.Reset();
+
+    TArray<FString> Entries;
+    Text.Replace(TEXT(","), TEXT(";")).ParseIntoArray(Entries, TEXT(";"), true);
+    for (FString Entry : Entries)
+    {
+        Entry.TrimStartAndEndInline();
+        if (Entry.IsEmpty())
+        {
+            continue;
+        }
+
+        FString Size = Entry;
+        FString Output;
+        Entry.Split(TEXT("="), &Size, &Output);
+        Size.TrimStartAndEndInline();
+        Output.TrimStartAndEndInline();
+
+        FChannelPackVariant Variant;
+        FString SizeX;
+        FString SizeY;
+        if (Size.Split(TEXT("x"), &SizeX, &SizeY, ESearchCase::IgnoreCase))
+        {
+            Variant.Width = FCString::Atoi(*SizeX);
+            Variant.Height = FCString::Atoi(*SizeY);
+        }
+        else
+        {
+            // Keep the aspect ratio of the main output
+            Variant.Width = FCString::Atoi(*Size);
+            Variant.Height = FMath::Max(1, FMath::RoundToInt32((double)Variant.Width * Height / Width));
+        }
+
+        if (Variant.Width < 1 || Variant.Height < 1 || Variant.Width > Width || Variant.Height > Height)
+        {
+            OutError = FString::Printf(TEXT("Variant '%s' must be between 1 x 1 and the output size (%d x %d)"), *Entry, Width, Height);
+            return false;
+        }
+
+        if (Output.IsEmpty())
+        {
+            Variant.PackageName = Size.Contains(TEXT("x"), ESearchCase::IgnoreCase)
+                ? FString::Printf(TEXT("%s_%dx%d"), *PackageName, Variant.Width, Variant.Height)
+                : FString::Printf(TEXT("%s_%d"), *PackageName, Variant.Width);
+        }
+        else
+        {
+            Variant.PackageName = Output.StartsWith(TEXT("/")) ? Output : FPackageName::GetLongPackagePath(PackageName) / Output;
+        }
+
+        if (!FPackageName::IsValidLongPackageName(Variant.PackageName))
+        {
+            OutError = FString::Printf(TEXT("Variant output '%s' is not a valid long package name"), *Variant.PackageName);
+            return false;
+        }
+
+        if (Variant.PackageName == PackageName || OutVariants.ContainsByPredicate([&Variant](const FChannelPackVariant& Other) { return Other.PackageName == Variant.PackageName; }))
+        {
+            OutError = FString::Printf(TEXT("Variant output '%s' is used twice"), *Variant.PackageName);
+            return false;
+        }
+
+        OutVariants.Add(MoveTemp(Variant));
+    }
+
+    return true;
+}
+
+/** Returns the variants from the largest to the smallest, so that every variant comes after the outputs it can be resampled from. */
+static TArray<FChannelPackVariant> SortVariantsBySize(const TArray<FChannelPackVariant>& Variants)
+{
+    TArray<FChannelPackVariant> Sorted = Variants;
+    Sorted.StableSort([](const FChannelPackVariant& A, const FChannelPackVariant& B)
+    {
+        return (int64)A.Width * A.Height > (int64)B.Width * B.Height;
+    });
+    return Sorted;
+}
+
+/** Returns the smallest variant already in Job.VariantJobs that covers Width x Height, or INDEX_NONE for the main output. */
+static int32 FindVariantParent(const FChannelPackJob& Job, int32 Width, int32 Height)
+{
+    int32 ParentIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < Job.VariantJobs.Num(); ++Index)
+    {
+        const FChannelPackSettings& Candidate = Job.VariantJobs[Index]->Settings;
+        if (Candidate.Width >= Width && Candidate.Height >= Height)
+        {
+            ParentIndex = Index; // Sorted by size, so later candidates are smaller
+        }
+    }
+    return ParentIndex;
+}
+
+/**
+ * Creates the job of one output: loads its package and checks whether the existing asset already matches Fingerprint.
+ * Fails, leaving the asset untouched, if the output name is taken by an asset that is not a texture.
+ */
+static TSharedPtr<FChannelPackJob> CreateChannelPackOutputJob(const FString& PackageName, const FChannelPackSettings& Settings, const FString& Fingerprint, FText* OutError)
+{
+    // Create the package using TStrongObjectPtr for RAII
+    TStrongObjectPtr<UPackage> PackagePtr(CreatePackage(*PackageName));
+    UPackage* Package = PackagePtr.Get();
+
+    if (!Package)
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Failed to create package: %s"), *PackageName);
+        return nullptr;
+    }
+
+    Package->FullyLoad();
+
+    const UObject* ExistingObject = StaticFindObjectFast(nullptr, Package, FName(*FPaths::GetBaseFilename(PackageName)));
+    if (ExistingObject && !ExistingObject->IsA<UTexture2D>())
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Cannot pack %s: a %s of that name already exists"), *PackageName, *ExistingObject->GetClass()->GetName());
+        if (OutError)
+        {
+            *OutError = FText::Format(GetLocalizedMessage(
+                TEXT("ErrorOutputNotTexture"),
+                TEXT("{0} already exists and is not a texture. Choose another output name."),
+                TEXT("{0} は既に存在し、テクスチャではありません。別の出力名を指定してください。")
+            ), FText::FromString(PackageName));
+        }
+        return nullptr;
+    }
+
+    TSharedPtr<FChannelPackJob> Job = MakeShared<FChannelPackJob>();
+    Job->PackageName = PackageName;
+    Job->Settings = Settings;
+    Job->Package.Reset(Package);
+    Job->Fingerprint = Fingerprint;
+    Job->StartTime = FPlatformTime::Seconds();
+    Job->Control.Memory = &Job->Memory;
+    Job->TraceLabel = FString::Printf(TEXT("TextureChannelPacker %s %dx%d"), *FPackageName::GetShortName(PackageName), Settings.Width, Settings.Height);
+
+    UTexture2D* ExistingTexture = FindObject<UTexture2D>(Package, *FPaths::GetBaseFilename(PackageName));
+    if (Settings.bSkipUnchanged && !Fingerprint.IsEmpty() && GetChannelPackFingerprint(ExistingTexture) == Fingerprint)
+    {
+        Job->Texture.Reset(ExistingTexture);
+        Job->bUpToDate = true;
+        Job->bSucceeded = true;
+    }
+    return Job;
+}
+
+/**
+ * Creates the new texture of an output that is (re)packed. It is built in the transient package, so that
+ * the existing asset stays untouched until MoveChannelPackOutputIntoPackage replaces it after a successful pack.
+ */
+static UTexture2D* CreateChannelPackOutputTexture(FChannelPackJob& Job)
+{
+    Job.bUpToDate = false;
+    Job.bSucceeded = false;
+
+    UPackage* TransientPackage = GetTransientPackage();
+    const FName TextureName = MakeUniqueObjectName(TransientPackage, UTexture2D::StaticClass(), FName(*FPaths::GetBaseFilename(Job.PackageName)));
+    UTexture2D* NewTexture = NewObject<UTexture2D>(TransientPackage, TextureName, RF_Public | RF_Standalone);
+    Job.Texture.Reset(NewTexture);
+    return NewTexture;
+}
+
+/**
+ * Moves the packed texture from the transient package into the output package. An existing texture of the
+ * same name is moved out of the way and discarded; loaded assets that referenced it are pointed at the new texture.
+ * Any other asset of that name is left untouched, and false is returned.
+ */
+static bool MoveChannelPackOutputIntoPackage(FChannelPackJob& Job)
+{
+    UPackage* Package = Job.Package.Get();
+    UTexture2D* NewTexture = Job.Texture.Get();
+    const FString TextureName = FPaths::GetBaseFilename(Job.PackageName);
+    const ERenameFlags RenameFlags = REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty;
+
+    if (UObject* ExistingObject = StaticFindObjectFast(nullptr, Package, FName(*TextureName)))
+    {
+        // Checked when the job was created; the asset may have been created while packing
+        if (!ExistingObject->IsA<UTexture2D>())
+        {
+            UE_LOG(LogTexturePacker, Error, TEXT("Cannot pack %s: a %s of that name already exists"), *Job.PackageName, *ExistingObject->GetClass()->GetName());
+            return false;
+        }
+
+        TArray<UObject*> ObjectsToReplace = { ExistingObject };
+        ObjectTools::ForceReplaceReferences(NewTexture, ObjectsToReplace);
+        ExistingObject->Rename(nullptr, GetTransientPackage(), RenameFlags);
+        ExistingObject->ClearFlags(RF_Public | RF_Standalone);
+        ExistingObject->MarkAsGarbage();
+    }
+
+    NewTexture->Rename(*TextureName, Package, RenameFlags);
+    return true;
+}
+
+/** Launches the last pass of a job with variants: resamples each variant from its parent's packed pixels. */
+static void LaunchChannelPackVariants(FChannelPackJob& Job)
+{
+    Job.PassStages.Reset();
+
+    FChannelPackJob* JobPtr = &Job;
+    Job.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [JobPtr]()
+    {
+        const double PackStartTime = FPlatformTime::Seconds();
+        bool bSucceeded = true;
+        for (const TSharedPtr<FChannelPackJob>& VariantJob : JobPtr->VariantJobs)
+        {
+            // Progress restarts for every variant; each one is spread over every worker
+            JobPtr->Control.CompletedBands.store(0, std::memory_order_relaxed);
+            const FChannelPackSettings& VariantSettings = VariantJob->Settings;
+            TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*VariantJob->TraceLabel);
+            VariantJob->bSucceeded = VariantJob->MipData
+                && PackChannelsToBGRA8(VariantJob->Channels, VariantSettings.Width, VariantSettings.Height, VariantSettings.Filter, VariantJob->MipData, 0, &JobPtr->Control);
+            if (!VariantJob->bSucceeded)
+            {
+                bSucceeded = false;
+                break;
+            }
+        }
+        JobPtr->bSucceeded = bSucceeded;
+        JobPtr->PackSeconds += FPlatformTime::Seconds() - PackStartTime;
+    });
+}
+
+// ---------------------------------------------------------
+// Memory Budget and Passes
+// ---------------------------------------------------------
+
+int64 GetChannelPackMemoryBudget()
+{
+    const int32 BudgetMB = CVarChannelPackMemoryBudgetMB.GetValueOnAnyThread();
+    if (BudgetMB > 0)
+    {
+        return (int64)BudgetMB * 1024 * 1024;
+    }
+    return (int64)(FPlatformMemory::GetConstants().TotalPhysical / 4);
+}
+
+/** Returns the size of the extracted (decompressed) source mip of an input, or 0 if the packing engine cannot read it. */
+static int64 GetExtractedInputBytes(UTexture2D* Input, int32 Width, int32 Height)
+{
+#if WITH_EDITORONLY_DATA
+    const FTextureSource& Source = Input->Source;
+    if (Source.IsValid() && IsChannelPackSourceFormatSupported(GetChannelPackSourceFormat(Source.GetFormat())))
+    {
+        const int32 MipIndex = SelectChannelPackSourceMip(Input, Width, Height);
+        return (int64)FMath::Max(1, Source.GetSizeX() >> MipIndex) * FMath::Max(1, Source.GetSizeY() >> MipIndex) * Source.GetBytesPerPixel();
+    }
+#endif
+    return 0;
+}
+
+/**
+ * Estimates the peak memory of the pack. If the output and the inputs exceed the memory budget together,
+ * plans one pass per input so that only one input is held at a time. Returns whether the planes captured
+ * for the plane cache fit in the budget as well.
+ */
+static bool PlanChannelPackPasses(FChannelPackJob& Job, UTexture2D* const (&Inputs)[4])
+{
+    const int64 Budget = GetChannelPackMemoryBudget();
+    const int64 PlaneBytes = (int64)Job.Settings.Width * Job.Settings.Height;
+
+    int64 InputBytes = 0;
+    int64 LargestInputBytes = 0;
+    int64 CaptureBytes = 0;
+    TArray<int32> InputSlots;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        if (Job.FirstSlotOfInput[i] == i && Inputs[i] && !AreAllPlanesOfInputCached(Job, i))
+        {
+            const int64 Bytes = GetExtractedInputBytes(Inputs[i], Job.Settings.Width, Job.Settings.Height);
+            InputBytes += Bytes;
+            LargestInputBytes = FMath::Max(LargestInputBytes, Bytes);
+            if (Bytes > 0)
+            {
+                InputSlots.Add(i);
+            }
+        }
+
+        if (FindPlaneCacheOwner(Job, i) == i && !Job.CachedPlanes[i].IsValid())
+        {
+            CaptureBytes += PlaneBytes;
+        }
+    }
+
+    int64 OutputBytes = PlaneBytes * 4;
+    for (const TSharedPtr<FChannelPackJob>& VariantJob : Job.VariantJobs)
+    {
+        OutputBytes += (int64)VariantJob->Settings.Width * VariantJob->Settings.Height * 4;
+    }
+
+    int64 PeakBytes = OutputBytes + InputBytes;
+    if (PeakBytes + CaptureBytes > Budget && InputSlots.Num() > 1)
+    {
+        // The first input is extracted right away, the others by the passes that follow
+        InputSlots.RemoveAt(0);
+        Job.PendingPassSlots = MoveTemp(InputSlots);
+        Job.NumPasses = 1 + Job.PendingPassSlots.Num();
+        PeakBytes = OutputBytes + LargestInputBytes;
+
+        UE_LOG(LogTexturePacker, Log, TEXT("Packing %s in %d passes, one input at a time, to stay within the memory budget of %lld MB"),
+            *Job.PackageName, Job.NumPasses, Budget >> 20);
+    }
+
+    // Captured planes only speed up later packs, so they are the first thing to give up
+    const bool bCapturePlanes = PeakBytes + CaptureBytes <= Budget;
+    if (bCapturePlanes)
+    {
+        PeakBytes += CaptureBytes;
+    }
+    Job.EstimatedPeakBytes = PeakBytes;
+
+    if (PeakBytes > Budget)
+    {
+        UE_LOG(LogTexturePacker, Warning, TEXT("%s needs about %lld MB, more than the memory budget of %lld MB (TextureChannelPacker.MemoryBudgetMB)"),
+            *Job.PackageName, PeakBytes >> 20, Budget >> 20);
+    }
+    return bCapturePlanes;
+}
+
+/**
+ * Charges an extracted input to the job's memory tracker: the source mip, or the compressed payload plus
+ * the pixels it decodes to. The charge travels with the input's copies in the slots that share it and is
+ * returned when the last of them is released.
+ */
+static void ChargeRawInput(FChannelPackJob& Job, FTextureRawData& Raw)
+{
+    int64 Bytes = (int64)Raw.RawData.GetSize() + (int64)Raw.CompressedData.GetSize();
+    if (Raw.NeedsDecode())
+    {
+        Bytes += (int64)Raw.Width * Raw.Height * GetChannelPackSourceBytesPerPixel(GetChannelPackSourceFormat(Raw.Format));
+    }
+    Raw.MemoryCharge = MakeShared<FChannelPackMemoryCharge>(Bytes, Job.Memory);
+}
+
+int64 EstimateChannelPackJobBytes(UTexture2D* const (&Inputs)[4], const FChannelPackSettings& Settings, const TArray<FChannelPackVariant>& Variants)
+{
+    int64 OutputBytes = (int64)Settings.Width * Settings.Height * 4;
+    for (const FChannelPackVariant& Variant : Variants)
+    {
+        OutputBytes += (int64)Variant.Width * Variant.Height * 4;
+    }
+
+    // Like PlanChannelPackPasses, without the plane cache: a cached input only lowers the real peak
+    int64 InputBytes = 0;
+    int64 LargestInputBytes = 0;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        bool bFirstSlotOfInput = Inputs[i] != nullptr;
+        for (int32 Previous = 0; Previous < i && bFirstSlotOfInput; ++Previous)
+        {
+            bFirstSlotOfInput = Inputs[Previous] != Inputs[i];
+        }
+        if (bFirstSlotOfInput)
+        {
+            const int64 Bytes = GetExtractedInputBytes(Inputs[i], Settings.Width, Settings.Height);
+            InputBytes += Bytes;
+            LargestInputBytes = FMath::Max(LargestInputBytes, Bytes);
+        }
+    }
+
+    return (OutputBytes + InputBytes > GetChannelPackMemoryBudget()) ? OutputBytes + LargestInputBytes : OutputBytes + InputBytes;
+}
+
+/** Points a channel at the pixels of an extracted input. Inputs without source data leave the channel without a source. */
+static void SetChannelSource(FChannelPackDesc& Channel, const FTextureRawData& Raw)
+{
+    Channel.Source.Data = static_cast<const uint8*>(Raw.RawData.GetData());
+    Channel.Source.Width = Raw.Width;
+    Channel.Source.Height = Raw.Height;
+    Channel.Source.Format = GetChannelPackSourceFormat(Raw.Format);
+}
+
+/** Marks the channels the current pass leaves untouched. PassInputSlot is the input packed by the pass, or INDEX_NONE for the first pass. */
+static void SelectPassChannels(FChannelPackJob& Job, int32 PassInputSlot)
+{
+    for (int32 i = 0; i < 4; ++i)
+    {
+        const int32 InputSlot = Job.FirstSlotOfInput[i];
+        Job.Channels[i].bPreserveOutput = (PassInputSlot == INDEX_NONE)
+            ? Job.PendingPassSlots.Contains(InputSlot)
+            : InputSlot != PassInputSlot;
+    }
+}
+
+/**
+ * Launches a task that decodes the compressed input of Slot (its first slot) and points the input's
+ * channels at the pixels, and adds it to Job.DecodeTasks. The task only writes the RawData of the
+ * input's slots and their channels, which the Game Thread does not read until the pass has completed.
+ *
+ * @return The decode task, or an empty task if the input needs no decoding.
+ */
+static UE::Tasks::FTask LaunchSourceDecode(FChannelPackJob& Job, int32 Slot)
+{
+    if (!Job.RawInputs[Slot].NeedsDecode())
+    {
+        return UE::Tasks::FTask();
+    }
+
+    FChannelPackJob* JobPtr = &Job;
+    return Job.DecodeTasks.Add_GetRef(UE::Tasks::Launch(UE_SOURCE_LOCATION, [JobPtr, Slot]()
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*JobPtr->TraceLabel);
+        const uint64 DecodeStartCycles = FPlatformTime::Cycles64();
+        FTextureRawData& Raw = JobPtr->RawInputs[Slot];
+        if (DecodeTextureSourceData(Raw))
+        {
+            for (int32 i = 0; i < 4; ++i)
+            {
+                if (JobPtr->FirstSlotOfInput[i] == Slot)
+                {
+                    JobPtr->RawInputs[i].RawData = Raw.RawData;
+                    if (!JobPtr->Channels[i].CachedPlane)
+                    {
+                        SetChannelSource(JobPtr->Channels[i], Raw);
+                    }
+                }
+            }
+        }
+        JobPtr->DecodeCycles.fetch_add(FPlatformTime::Cycles64() - DecodeStartCycles, std::memory_order_relaxed);
+    }));
+}
+
+/** Launches a decode task (LaunchSourceDecode) for every compressed input of the current pass. */
+static void LaunchSourceDecodes(FChannelPackJob& Job)
+{
+    Job.DecodeTasks.Reset();
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        if (Job.FirstSlotOfInput[Slot] == Slot && !Job.Channels[Slot].bPreserveOutput)
+        {
+            LaunchSourceDecode(Job, Slot);
+        }
+    }
+}
+
+/** Fails every input of the current pass whose decode failed, so it is reported like an unreadable input. Returns false if there was one. */
+static bool ReportFailedDecodes(FChannelPackJob& Job)
+{
+    bool bAllDecoded = true;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        FTextureRawData& Raw = Job.RawInputs[i];
+        if (!Job.Channels[i].bPreserveOutput && Raw.NeedsDecode())
+        {
+            if (Job.FirstSlotOfInput[i] == i)
+            {
+                UE_LOG(LogTexturePacker, Error, TEXT("Failed to decode the compressed source of %s"), *Raw.TextureName);
+            }
+            Raw.bIsValid = false;
+            Raw.ErrorMessage = GetLocalizedMessage(
+                TEXT("ErrorDecodeFailed"),
+                TEXT("Failed to decode the compressed texture source. Try reimporting the texture."),
+                TEXT("圧縮されたテクスチャソースのデコードに失敗しました。テクスチャを再インポートしてください。")
+            );
+            bAllDecoded = false;
+        }
+    }
+    return bAllDecoded;
+}
+
+/** Launches the packing task of the current pass, after the compressed inputs of the pass have been decoded. */
+static void LaunchChannelPackPass(FChannelPackJob& Job)
+{
+    Job.Control.CompletedBands.store(0, std::memory_order_relaxed);
+    Job.PassStages.Reset();
+    LaunchSourceDecodes(Job);
+
+    FChannelPackJob* JobPtr = &Job;
+    Job.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [JobPtr]()
+    {
+        // A failed decode leaves its input compressed; the Game Thread reports it (ReportFailedDecodes)
+        for (int32 i = 0; i < 4; ++i)
+        {
+            if (!JobPtr->Channels[i].bPreserveOutput && JobPtr->RawInputs[i].NeedsDecode())
+            {
+                JobPtr->bSucceeded = false;
+                return;
+            }
+        }
+
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*JobPtr->TraceLabel);
+        const double PackStartTime = FPlatformTime::Seconds();
+        JobPtr->bSucceeded = PackChannelsToBGRA8(JobPtr->Channels, JobPtr->Settings.Width, JobPtr->Settings.Height, JobPtr->Settings.Filter, JobPtr->MipData, 0, &JobPtr->Control);
+        JobPtr->PackSeconds += FPlatformTime::Seconds() - PackStartTime;
+    }, UE::Tasks::Prerequisites(Job.DecodeTasks));
+}
+
+/** Describes how output channel Slot is produced: from its extracted input, from the plane cache or as its default value. */
+static void DescribeChannel(FChannelPackJob& Job, int32 Slot, bool bHasInput, bool bCapturePlanes)
+{
+    const FChannelPackSettings& Settings = Job.Settings;
+    const FTextureRawData& Raw = Job.RawInputs[Slot];
+    FChannelPackDesc& Channel = Job.Channels[Slot];
+    if (bHasInput && !Raw.bIsValid)
+    {
+        // The outputs will not match the recipe, so do not let a later pack skip them
+        Job.Fingerprint.Reset();
+        for (const TSharedPtr<FChannelPackJob>& VariantJob : Job.VariantJobs)
+        {
+            VariantJob->Fingerprint.Reset();
+        }
+    }
+
+    const int32 PlaneOwner = FindPlaneCacheOwner(Job, Slot);
+    if (PlaneOwner != INDEX_NONE && Job.CachedPlanes[PlaneOwner].IsValid())
+    {
+        Channel.CachedPlane = Job.CachedPlanes[PlaneOwner].GetPixels();
+    }
+    else if (Raw.bIsValid)
+    {
+        SetChannelSource(Channel, Raw);
+
+        // Keep the resized plane of a cache miss, to store it once the job has succeeded
+        if (PlaneOwner == Slot && bCapturePlanes)
+        {
+            Job.CapturedPlanes[Slot].Allocate((int64)Settings.Width * Settings.Height, Job.Memory);
+            Channel.CapturePlane = Job.CapturedPlanes[Slot].GetPixels();
+        }
+    }
+    Channel.DefaultValue = (Slot == 3) ? 255 : 0;
+    Channel.bInvert = Settings.bInvert[Slot];
+    Channel.SourceChannel = Settings.SourceChannels[Slot];
+}
+
+/**
+ * Initializes the source of every output as BGRA8 and keeps mip 0 locked until the job is finalized.
+ * Variants read all four channels from the packed pixels of their parent (VariantParents, see FindVariantParent).
+ */
+static void LockChannelPackOutputs(FChannelPackJob& Job, const TArray<int32>& VariantParents)
+{
+#if WITH_EDITORONLY_DATA
+    Job.Texture->Source.Init(Job.Settings.Width, Job.Settings.Height, 1, 1, TSF_BGRA8);
+    Job.MipData = Job.Texture->Source.LockMip(0);
+    if (Job.MipData)
+    {
+        Job.OutputCharge = FChannelPackMemoryCharge((int64)Job.Settings.Width * Job.Settings.Height * 4, Job.Memory);
+    }
+
+    for (int32 Index = 0; Index < Job.VariantJobs.Num(); ++Index)
+    {
+        FChannelPackJob& VariantJob = *Job.VariantJobs[Index];
+        VariantJob.Texture->Source.Init(VariantJob.Settings.Width, VariantJob.Settings.Height, 1, 1, TSF_BGRA8);
+        VariantJob.MipData = VariantJob.Texture->Source.LockMip(0);
+        if (VariantJob.MipData)
+        {
+            VariantJob.OutputCharge = FChannelPackMemoryCharge((int64)VariantJob.Settings.Width * VariantJob.Settings.Height * 4, VariantJob.Memory);
+        }
+
+        // Every channel is read from the parent's packed pixels, which is a single BGRA8 source
+        const FChannelPackJob& Parent = (VariantParents[Index] == INDEX_NONE) ? Job : *Job.VariantJobs[VariantParents[Index]];
+        for (int32 i = 0; i < 4; ++i)
+        {
+            VariantJob.Channels[i].Source = { Parent.MipData, Parent.Settings.Width, Parent.Settings.Height, EChannelPackSourceFormat::BGRA8 };
+            VariantJob.Channels[i].SourceChannel = (ETextureSourceChannel)i;
+        }
+    }
+#endif
+}
+
+// ---------------------------------------------------------
+// Pipelined Passes
+// ---------------------------------------------------------
+
+/**
+ * Returns whether the first pass should be pipelined: the channels of each input are converted and
+ * resized into full planes as soon as the input is extracted (and decoded), and each band is interleaved
+ * once every input has produced its rows. This overlaps the packing of the earlier inputs with the Game
+ * Thread extracting the later ones, whether they are decoded on a worker or read on the Game Thread, so
+ * it needs at least two inputs to extract, a single pass over the inputs, and room in the memory budget
+ * for the planes, which are added to EstimatedPeakBytes. OutNumInputStages receives the number of inputs
+ * to extract, each of which gets a stage.
+ */
+static bool ShouldPipelineChannelPack(FChannelPackJob& Job, UTexture2D* const (&Inputs)[4], bool bCapturePlanes, int32& OutNumInputStages)
+{
+    OutNumInputStages = 0;
+    if (!CVarChannelPackPipelined.GetValueOnGameThread() || Job.PendingPassSlots.Num() > 0)
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < 4; ++i)
+    {
+        if (Job.FirstSlotOfInput[i] == i && Inputs[i] && !AreAllPlanesOfInputCached(Job, i))
+        {
+            ++OutNumInputStages;
+        }
+    }
+    if (OutNumInputStages < 2)
+    {
+        return false;
+    }
+
+    // The inputs' channels are held as full planes until their bands are interleaved; captured planes are counted already
+    int64 StagedPlaneBytes = 0;
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        const int32 InputSlot = Job.FirstSlotOfInput[Slot];
+        const int32 PlaneOwner = FindPlaneCacheOwner(Job, Slot);
+        const bool bCached = PlaneOwner != INDEX_NONE && Job.CachedPlanes[PlaneOwner].IsValid();
+        const bool bCaptured = !bCached && bCapturePlanes && PlaneOwner == Slot;
+        if (Inputs[InputSlot] && !AreAllPlanesOfInputCached(Job, InputSlot) && !bCached && !bCaptured)
+        {
+            StagedPlaneBytes += (int64)Job.Settings.Width * Job.Settings.Height;
+        }
+    }
+    if (Job.EstimatedPeakBytes + StagedPlaneBytes > GetChannelPackMemoryBudget())
+    {
+        return false;
+    }
+    Job.EstimatedPeakBytes += StagedPlaneBytes;
+    return true;
+}
+
+/**
+ * Launches a stage of a pipelined pass (FChannelPackStagedPack::PackStage) that packs the slots in
+ * SlotMask: those of one input (InputSlot is its first slot), once it is decoded, or with an InputSlot
+ * of INDEX_NONE, the slots no input stage packs. The stages run at the same time, and each band is
+ * interleaved by the last stage to produce its rows. Each copies only its own channel descriptions,
+ * since those of the other inputs may still be written by the Game Thread.
+ */
+static void LaunchPipelinedStage(FChannelPackJob& Job, int32 InputSlot, uint32 SlotMask)
+{
+    TArray<UE::Tasks::FTask, TInlineAllocator<1>> Prerequisites;
+    if (InputSlot != INDEX_NONE)
+    {
+        UE::Tasks::FTask DecodeTask = LaunchSourceDecode(Job, InputSlot);
+        if (DecodeTask.IsValid())
+        {
+            Prerequisites.Add(MoveTemp(DecodeTask));
+        }
+    }
+
+    FChannelPackJob* JobPtr = &Job;
+    Job.PassStages.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [JobPtr, InputSlot, SlotMask]()
+    {
+        // A failed decode leaves its input compressed; the Game Thread reports it (ReportFailedDecodes)
+        if (InputSlot != INDEX_NONE && JobPtr->RawInputs[InputSlot].NeedsDecode())
+        {
+            return false;
+        }
+
+        FChannelPackDesc StageChannels[4];
+        for (int32 i = 0; i < 4; ++i)
+        {
+            if (SlotMask & (1u << i))
+            {
+                StageChannels[i] = JobPtr->Channels[i];
+            }
+            else
+            {
+                StageChannels[i].bPreserveOutput = true;
+            }
+        }
+
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*JobPtr->TraceLabel);
+        return JobPtr->StagedPack->PackStage(StageChannels, 0, &JobPtr->Control);
+    }, UE::Tasks::Prerequisites(Prerequisites)));
+}
+
+/**
+ * Launches the job's Task for a pipelined pass, which completes once every stage has: the output is
+ * then fully interleaved, and only the staged planes are left to release.
+ */
+static void LaunchPipelinedCompletion(FChannelPackJob& Job, double PassStartTime)
+{
+    TArray<UE::Tasks::FTask> Prerequisites;
+    for (const UE::Tasks::TTask<bool>& Stage : Job.PassStages)
+    {
+        Prerequisites.Add(Stage);
+    }
+
+    FChannelPackJob* JobPtr = &Job;
+    Job.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [JobPtr, PassStartTime]()
+    {
+        bool bSucceeded = true;
+        for (UE::Tasks::TTask<bool>& Stage : JobPtr->PassStages)
+        {
+            bSucceeded &= Stage.GetResult();
+        }
+
+        JobPtr->StagedPack.Reset();
+        JobPtr->bSucceeded = bSucceeded;
+        JobPtr->PackSeconds += FPlatformTime::Seconds() - PassStartTime;
+    }, UE::Tasks::Prerequisites(Prerequisites));
+}
+
+/** Adds the source format and size of every slot to the job's trace label, e.g. " R=BGRA8 4096x4096 G=- ...". */
+static void AppendInputsToTraceLabel(FChannelPackJob& Job, UTexture2D* const (&Inputs)[4])
+{
+    static const TCHAR* const SlotNames[4] = { TEXT("R"), TEXT("G"), TEXT("B"), TEXT("A") };
+    for (int32 i = 0; i < 4; ++i)
+    {
+#if WITH_EDITORONLY_DATA
+        if (Inputs[i])
+        {
+            const FTextureSource& Source = Inputs[i]->Source;
+            Job.TraceLabel += FString::Printf(TEXT(" %s=%s %dx%d"), SlotNames[i],
+                GetChannelPackSourceFormatName(GetChannelPackSourceFormat(Source.GetFormat())), Source.GetSizeX(), Source.GetSizeY());
+            continue;
+        }
+#endif
+        Job.TraceLabel += FString::Printf(TEXT(" %s=-"), SlotNames[i]);
+    }
+}
+
+/**
+ * Extracts the inputs of the first pass and launches it: all inputs, or the first one when the job is
+ * written in several passes (see PlanChannelPackPasses). Inputs whose planes all come from the plane
+ * cache are not extracted, so this runs once the plane cache lookups have completed.
+ */
+static void BeginChannelPackFirstPass(FChannelPackJob& Job, UTexture2D* const (&Inputs)[4])
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Job.TraceLabel);
+
+    // ---------------------------------------------------------
+    // STEP 1: Extract Raw Data from Inputs (Game Thread)
+    // ---------------------------------------------------------
+    const double ExtractStartTime = FPlatformTime::Seconds();
+    bool bCapturePlanes = true;
+    bool bPipelined = false;
+    uint32 StagedSlots = 0;
+    {
+        // Only shows a dialog if extraction takes noticeably long
+        FScopedSlowTask SlowTask(4.0f, GetLocalizedMessage(
+            TEXT("ProgressExtracting"),
+            TEXT("Extracting source data..."),
+            TEXT("ソースデータを抽出中...")
+        ));
+        SlowTask.MakeDialogDelayed(0.5f);
+
+        ChargeCachedPlanes(Job);
+        bCapturePlanes = PlanChannelPackPasses(Job, Inputs);
+
+        // The outputs are locked before extraction, so that a pipelined pass can start writing right away
+        LockChannelPackOutputs(Job, Job.VariantParents);
+        int32 NumInputStages = 0;
+        bPipelined = Job.MipData && ShouldPipelineChannelPack(Job, Inputs, bCapturePlanes, NumInputStages);
+        if (bPipelined)
+        {
+            // One stage per input, and one for the empty and cached slots
+            const FChannelPackSettings& Settings = Job.Settings;
+            Job.StagedPack = MakeUnique<FChannelPackStagedPack>(Settings.Width, Settings.Height, Settings.Filter, Job.MipData, NumInputStages + 1);
+        }
+
+        Job.RawInputs.SetNum(4); // R, G, B, A
+        for (int32 i = 0; i < 4; ++i)
+        {
+            SlowTask.EnterProgressFrame(1.0f);
+
+            if (Job.FirstSlotOfInput[i] != i)
+            {
+                continue; // Extracted with the first slot that uses the texture
+            }
+
+            if (Inputs[i] && AreAllPlanesOfInputCached(Job, i))
+            {
+                Job.RawInputs[i] = DescribeUnextractedInput(Inputs[i], Job.Settings.Width, Job.Settings.Height);
+                UE_LOG(LogTexturePacker, Log, TEXT("Input %s is served from the plane cache"), *Job.RawInputs[i].TextureName);
+            }
+            else if (Job.PendingPassSlots.Contains(i))
+            {
+                Job.RawInputs[i] = DescribeUnextractedInput(Inputs[i], Job.Settings.Width, Job.Settings.Height);
+                Job.PendingInputs[i].Reset(Inputs[i]);
+            }
+            else
+            {
+                Job.RawInputs[i] = ExtractTextureSourceData(Inputs[i], Job.Settings.Width, Job.Settings.Height);
+                ChargeRawInput(Job, Job.RawInputs[i]);
+            }
+
+            for (int32 Shared = i + 1; Shared < 4; ++Shared)
+            {
+                if (Job.FirstSlotOfInput[Shared] == i)
+                {
+                    Job.RawInputs[Shared] = Job.RawInputs[i];
+                    UE_LOG(LogTexturePacker, Log, TEXT("Input %s is shared by slots %d and %d"), *Job.RawInputs[i].TextureName, i, Shared);
+                }
+            }
+
+            // Pipelined: pack this input while the next one is extracted; empty and cached slots are
+            // left to the stage launched after the loop
+            if (bPipelined)
+            {
+                uint32 InputSlots = 0;
+                for (int32 Slot = i; Slot < 4; ++Slot)
+                {
+                    if (Job.FirstSlotOfInput[Slot] == i)
+                    {
+                        DescribeChannel(Job, Slot, Inputs[Slot] != nullptr, bCapturePlanes);
+                        InputSlots |= 1u << Slot;
+                    }
+                }
+                if (Inputs[i] && !AreAllPlanesOfInputCached(Job, i))
+                {
+                    LaunchPipelinedStage(Job, i, InputSlots);
+                    StagedSlots |= InputSlots;
+                }
+            }
+        }
+    }
+    Job.ExtractSeconds = FPlatformTime::Seconds() - ExtractStartTime;
+    Job.bInputsExtracted = true;
+
+    if (!bPipelined)
+    {
+        for (int32 i = 0; i < 4; ++i)
+        {
+            DescribeChannel(Job, i, Inputs[i] != nullptr, bCapturePlanes);
+        }
+    }
+
+    // The variants are packed by a last pass, once the main output is complete
+    if (Job.VariantJobs.Num() > 0)
+    {
+        ++Job.NumPasses;
+    }
+
+    // ---------------------------------------------------------
+    // STEP 2: Decode, Convert, Resize, Invert and Interleave (Background Tasks)
+    // ---------------------------------------------------------
+    if (bPipelined)
+    {
+        LaunchPipelinedStage(Job, INDEX_NONE, ~StagedSlots & 0xf);
+        UE_LOG(LogTexturePacker, Log, TEXT("Packing %s in a pipelined pass (%d stages)"), *Job.PackageName, Job.PassStages.Num());
+        LaunchPipelinedCompletion(Job, ExtractStartTime);
+    }
+    else if (Job.MipData)
+    {
+        SelectPassChannels(Job, INDEX_NONE);
+        LaunchChannelPackPass(Job);
+    }
+}
+
+TSharedPtr<FChannelPackJob> BeginChannelPackJob(const FString& PackageName, UTexture2D* const (&Inputs)[4], const FChannelPackSettings& Settings, const TArray<FChannelPackVariant>& Variants, FText* OutError)
+{
+    check(IsInGameThread());
+
+    TSharedPtr<FChannelPackJob> Job = CreateChannelPackOutputJob(PackageName, Settings, ComputeChannelPackFingerprint(Inputs, Settings), OutError);
+    if (!Job.IsValid())
+    {
+        return nullptr;
+    }
+
+    bool bUpToDate = Job->bUpToDate;
+    TArray<int32> VariantParents;
+    for (const FChannelPackVariant& Variant : SortVariantsBySize(Variants))
+    {
+        FChannelPackSettings VariantSettings = Settings;
+        VariantSettings.Width = Variant.Width;
+        VariantSettings.Height = Variant.Height;
+
+        const int32 ParentIndex = FindVariantParent(*Job, Variant.Width, Variant.Height);
+        const FChannelPackJob& Parent = (ParentIndex == INDEX_NONE) ? *Job : *Job->VariantJobs[ParentIndex];
+        TSharedPtr<FChannelPackJob> VariantJob = CreateChannelPackOutputJob(Variant.PackageName, VariantSettings,
+            ComputeChannelPackVariantFingerprint(Parent.Fingerprint, Variant.Width, Variant.Height, Settings.Filter), OutError);
+        if (!VariantJob.IsValid())
+        {
+            return nullptr;
+        }
+
+        // A variant's buffers count towards the peak of the job that packs it
+        VariantJob->Memory.SetParent(&Job->Memory);
+        bUpToDate &= VariantJob->bUpToDate;
+        Job->VariantJobs.Add(VariantJob);
+        VariantParents.Add(ParentIndex);
+    }
+
+    // Skip everything if the existing assets were packed from the same inputs and settings
+    if (bUpToDate)
+    {
+        UE_LOG(LogTexturePacker, Log, TEXT("%s is up to date (recipe %s)"), *PackageName, *Job->Fingerprint);
+        return Job;
+    }
+
+    AppendInputsToTraceLabel(*Job, Inputs);
+    TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Job->TraceLabel);
+
+    // Create the Texture2D of every output
+    CreateChannelPackOutputTexture(*Job);
+    for (const TSharedPtr<FChannelPackJob>& VariantJob : Job->VariantJobs)
+    {
+        CreateChannelPackOutputTexture(*VariantJob);
+    }
+
+    // A texture plugged into several slots is extracted once; the slots share its buffer,
+    // which also lets the packing engine decode and resample it once.
+    for (int32 i = 0; i < 4; ++i)
+    {
+        Job->FirstSlotOfInput[i] = i;
+        for (int32 Previous = 0; Previous < i; ++Previous)
+        {
+            if (Inputs[i] && Inputs[Previous] == Inputs[i])
+            {
+                Job->FirstSlotOfInput[i] = Previous;
+                break;
+            }
+        }
+    }
+
+    // Which inputs need extracting depends on the cached planes, so extraction waits for the lookups
+    // (see AdvanceChannelPackJob) when there are any
+    Job->VariantParents = MoveTemp(VariantParents);
+    if (RequestCachedPlanes(*Job, Inputs))
+    {
+        Job->bAwaitingPlaneCache = true;
+        for (int32 i = 0; i < 4; ++i)
+        {
+            Job->LookupInputs[i].Reset(Inputs[i]);
+        }
+        return Job;
+    }
+
+    BeginChannelPackFirstPass(*Job, Inputs);
+    return Job;
+}
+
+bool AdvanceChannelPackJob(FChannelPackJob& Job)
+{
+    check(IsInGameThread());
+
+    Job.Task.Wait();
+    if (Job.bAwaitingPlaneCache)
+    {
+        Job.bAwaitingPlaneCache = false;
+        Job.PlaneCacheFetchSeconds = FPlatformTime::Seconds() - Job.PlaneCacheLookupStartTime;
+        UTexture2D* Inputs[4];
+        for (int32 i = 0; i < 4; ++i)
+        {
+            Inputs[i] = Job.LookupInputs[i].Get();
+        }
+        if (!Job.Control.IsCancelRequested())
+        {
+            BeginChannelPackFirstPass(Job, Inputs);
+        }
+        for (TStrongObjectPtr<UTexture2D>& Input : Job.LookupInputs)
+        {
+            Input.Reset();
+        }
+        return !Job.Control.IsCancelRequested();
+    }
+
+    if (!ReportFailedDecodes(Job) || Job.NumCompletedPasses + 1 >= Job.NumPasses || !Job.bSucceeded || Job.Control.IsCancelRequested())
+    {
+        return false;
+    }
+
+    ++Job.NumCompletedPasses;
+
+    // Release the input of the finished pass before extracting the next one
+    for (int32 i = 0; i < 4; ++i)
+    {
+        if (!Job.Channels[i].bPreserveOutput)
+        {
+            Job.RawInputs[i].RawData.Reset();
+            Job.RawInputs[i].CompressedData.Reset();
+            Job.RawInputs[i].Decoder.Reset();
+            Job.RawInputs[i].MemoryCharge.Reset();
+            Job.Channels[i].Source.Data = nullptr;
+        }
+    }
+
+    if (Job.PendingPassSlots.Num() == 0)
+    {
+        UE_LOG(LogTexturePacker, Log, TEXT("Resampling %d variants of %s"), Job.VariantJobs.Num(), *Job.PackageName);
+        LaunchChannelPackVariants(Job);
+        return true;
+    }
+
+    const int32 InputSlot = Job.PendingPassSlots[0];
+    Job.PendingPassSlots.RemoveAt(0);
+
+    const double ExtractStartTime = FPlatformTime::Seconds();
+    FTextureRawData Raw = ExtractTextureSourceData(Job.PendingInputs[InputSlot].Get(), Job.Settings.Width, Job.Settings.Height);
+    Job.PendingInputs[InputSlot].Reset();
+    ChargeRawInput(Job, Raw);
+    Job.ExtractSeconds += FPlatformTime::Seconds() - ExtractStartTime;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        if (Job.FirstSlotOfInput[i] == InputSlot)
+        {
+            Job.RawInputs[i] = Raw;
+            SetChannelSource(Job.Channels[i], Raw);
+        }
+    }
+
+    if (!Raw.bIsValid)
+    {
+        UE_LOG(LogTexturePacker, Error, TEXT("Failed to read input %s in pass %d of %s"), *Raw.TextureName, Job.NumCompletedPasses + 1, *Job.PackageName);
+        Job.bSucceeded = false;
+        return false;
+    }
+
+    UE_LOG(LogTexturePacker, Log, TEXT("Pass %d of %d of %s: %s"), Job.NumCompletedPasses + 1, Job.NumPasses, *Job.PackageName, *Raw.TextureName);
+    SelectPassChannels(Job, InputSlot);
+    LaunchChannelPackPass(Job);
+    return true;
+}
+
+/**
+ * Logs the time of every stage of a finished job on one line, for comparing captures and logs across runs.
+ * Decode, convert, resize and interleave are CPU time summed over the worker threads.
+ */
+static void LogChannelPackStages(const FChannelPackJob& Job)
+{
+    const FChannelPackControl& Control = Job.Control;
+    UE_LOG(LogTexturePacker, Log,
+        TEXT("Stages of %s: extract=%.3fs decode=%.3fs convert=%.3fs resize=%.3fs interleave=%.3fs update_resource=%.3fs post_edit_change=%.3fs read=%.1fMB written=%.1fMB peak=%.1fMB scratch=%lld reused=%.0f%%"),
+        *Job.PackageName, Job.ExtractSeconds, Job.GetDecodeSeconds(),
+        FPlatformTime::ToSeconds64(Control.ConvertCycles.load(std::memory_order_relaxed)),
+        FPlatformTime::ToSeconds64(Control.ResizeCycles.load(std::memory_order_relaxed)),
+        FPlatformTime::ToSeconds64(Control.InterleaveCycles.load(std::memory_order_relaxed)),
+        Job.UpdateResourceSeconds, Job.PostEditChangeSeconds,
+        Control.SourceBytesRead.load(std::memory_order_relaxed) / (1024.0 * 1024.0),
+        Control.OutputBytesWritten.load(std::memory_order_relaxed) / (1024.0 * 1024.0),
+        Job.Memory.GetPeakBytes() / (1024.0 * 1024.0),
+        Job.Memory.GetNumAllocations(), 100.0 * Job.Memory.GetNumReusedAllocations() / FMath::Max<int64>(1, Job.Memory.GetNumAllocations()));
+}
+
+void FinishChannelPackJob(FChannelPackJob& Job)
+{
+    check(IsInGameThread());
+
+    // The task has normally completed already; waiting only matters during shutdown
+    Job.Task.Wait();
+    ReportFailedDecodes(Job);
+
+    // Variants share the outcome of the job; a failed or cancelled pack discards them all
+    ON_SCOPE_EXIT
+    {
+        for (const TSharedPtr<FChannelPackJob>& VariantJob : Job.VariantJobs)
+        {
+            VariantJob->bSucceeded = Job.bSucceeded && (Job.bUpToDate || VariantJob->bSucceeded);
+            FinishChannelPackJob(*VariantJob);
+        }
+    };
+
+    if (Job.bUpToDate)
+    {
+        // The pixels are unchanged; only touch the settings that are applied after packing
+        UTexture2D* ExistingTexture = Job.Texture.Get();
+        if (ExistingTexture->CompressionSettings != Job.Settings.CompressionSettings || ExistingTexture->SRGB)
+        {
+            ExistingTexture->Modify();
+            ExistingTexture->CompressionSettings = Job.Settings.CompressionSettings;
+            ExistingTexture->SRGB = false;
+            ExistingTexture->PostEditChange();
+            UE_LOG(LogTexturePacker, Log, TEXT("Updated compression settings of %s without repacking"), *Job.PackageName);
+        }
+        return;
+    }
+
+    UPackage* Package = Job.Package.Get();
+    UTexture2D* NewTexture = Job.Texture.Get();
+
+#if WITH_EDITORONLY_DATA
+    if (Job.MipData)
+    {
+        NewTexture->Source.UnlockMip(0);
+        Job.MipData = nullptr;
+        Job.OutputCharge.Reset();
+    }
+#endif
+
+    if (Job.bSucceeded && !MoveChannelPackOutputIntoPackage(Job))
+    {
+        Job.bSucceeded = false;
+    }
+
+    if (!Job.bSucceeded)
+    {
+        // Cleanup on early exit (Cancel/Error): the new texture never left the transient package,
+        // so an existing asset is untouched and only a package created for this job is discarded
+        UE_LOG(LogTexturePacker, Warning, TEXT("Package creation cancelled. Cleaning up: %s"), *Job.PackageName);
+        if (NewTexture)
+        {
+            NewTexture->ClearFlags(RF_Public | RF_Standalone);
+            NewTexture->MarkAsGarbage();
+            Job.Texture.Reset();
+        }
+        if (Package && !Package->IsDirty() && !StaticFindObjectFast(nullptr, Package, FName(*FPaths::GetBaseFilename(Job.PackageName))))
+        {
+            Package->MarkAsGarbage();
+        }
+        return;
+    }
+
+    UE_LOG(LogTexturePacker, Log, TEXT("Packed %s (%d x %d) in %.2f s (extract %.2f s, decode %.2f s, pack %.2f s)"),
+        *Job.PackageName, Job.Settings.Width, Job.Settings.Height, FPlatformTime::Seconds() - Job.StartTime,
+        Job.ExtractSeconds, Job.GetDecodeSeconds(), Job.PackSeconds);
+
+    StoreCapturedPlanes(Job);
+
+    // Remember the recipe so an unchanged repack can be skipped
+    SetChannelPackFingerprint(NewTexture, Job.Fingerprint);
+
+    // Final settings
+    NewTexture->CompressionSettings = Job.Settings.CompressionSettings;
+
+    // Even if TC_Default is selected, treat it as linear (sRGB=false) for channel packing purposes.
+    NewTexture->SRGB = false;
+
+    {
+        CHANNEL_PACK_STAGE_SCOPE("UpdateResource", STAT_ChannelPack_UpdateResource);
+        const double UpdateResourceStartTime = FPlatformTime::Seconds();
+        NewTexture->UpdateResource();
+        Job.UpdateResourceSeconds = FPlatformTime::Seconds() - UpdateResourceStartTime;
+    }
+    {
+        CHANNEL_PACK_STAGE_SCOPE("PostEditChange", STAT_ChannelPack_PostEditChange);
+        const double PostEditChangeStartTime = FPlatformTime::Seconds();
+        NewTexture->PostEditChange();
+        Job.PostEditChangeSeconds = FPlatformTime::Seconds() - PostEditChangeStartTime;
+    }
+
+    LogChannelPackStages(Job);
+
+    Package->MarkPackageDirty();
+    FAssetRegistryModule::AssetCreated(NewTexture);
+}
@@ -0,0 +1,434 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Memory/SharedBuffer.h"
+#include "Tasks/Task.h"
+#include "DerivedDataRequestOwner.h"
+#include "Algo/AnyOf.h"
+#include "HAL/PlatformTime.h"
+#include "TextureChannelPackerEngine.h"
+#include "TextureChannelPackerPlaneCache.h"
+
+class UPackage;
+class IImageWrapper;
+class UTexture2D;
+class SNotificationItem;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTexturePacker, Log, All);
+
+/**
+ * @brief Retrieves a localized message based on the current culture.
+ *
+ * This helper function returns either the Japanese text (if the current culture is Japanese)
+ * or the English text (for all other cultures).
+ *
+ * @param Key A unique identifier for the localization key (currently unused but good for future expansion).
+ * @param EnglishText The text to display in English.
+ * @param JapaneseText The text to display in Japanese.
+ * @return FText The localized text.
+ */
+FText GetLocalizedMessage(const FString& Key, const FString& EnglishText, const FString& JapaneseText);
+
+/**
+ * @struct FTextureRawData
+ * @brief Holds raw texture data extracted from a UTexture2D.
+ *
+ * This struct is used to transfer texture data from the Game Thread (where UTexture2D is accessible)
+ * to background threads for processing. RawData is a ref-counted, read-only view of the source mip,
+ * so the pixels are shared with the texture instead of copied and stay valid even if the texture is
+ * modified or reimported while a job is running. RawData is null (with bIsValid set) for an input
+ * whose resized planes all came from the plane cache.
+ */
+struct FTextureRawData
+{
+    FSharedBuffer RawData;
+    int32 Width = 0;
+    int32 Height = 0;
+    ETextureSourceFormat Format = TSF_Invalid;
+    FString TextureName;
+    bool bIsValid = false;
+
+    /** Source mip the data was read from (see SelectChannelPackSourceMip). Width and Height are the size of that mip. */
+    int32 MipIndex = 0;
+
+    /**
+     * Compressed (PNG or JPEG) source payload, set instead of RawData when the source is decoded on a
+     * worker thread by DecodeTextureSourceData. Decoder is created for it on the Game Thread.
+     */
+    FSharedBuffer CompressedData;
+    TSharedPtr<IImageWrapper> Decoder;
+
+    /** Counts RawData (or CompressedData) against the job's memory tracker. Shared by the slots that share the input. */
+    TSharedPtr<FChannelPackMemoryCharge> MemoryCharge;
+
+    /**
+     * User-facing error message if extraction failed.
+     * Empty if no error occurred.
+     */
+    FText ErrorMessage;
+
+    /** @return true if the pixels still have to be decoded from CompressedData. */
+    bool NeedsDecode() const { return bIsValid && RawData.IsNull() && !CompressedData.IsNull(); }
+};
+
+/**
+ * @brief Returns the source mip a pack of the given size reads from a texture.
+ *
+ * This is the mip of the source's mip chain of exactly Width x Height (FindChannelPackSourceMipOfSize),
+ * or 0 if there is none or TextureChannelPacker.UseSourceMips is 0. The selected mip is packed texel for
+ * texel, so the result is exact: the source's own mip, or mip 0 resized with the chosen filter.
+ *
+ * @param SourceTex The source texture (may be null, which returns 0).
+ * @param Width Output width (0 selects mip 0).
+ * @param Height Output height (0 selects mip 0).
+ */
+int32 SelectChannelPackSourceMip(UTexture2D* SourceTex, int32 Width, int32 Height);
+
+/**
+ * @brief Maps a texture source format to the packing engine's format.
+ *
+ * @return EChannelPackSourceFormat::Invalid for formats the engine cannot read.
+ */
+EChannelPackSourceFormat GetChannelPackSourceFormat(ETextureSourceFormat Format);
+
+/**
+ * @brief Extracts raw pixel data from a UTexture2D on the Game Thread.
+ *
+ * This function accesses the source data of a texture asset and takes a shared reference to
+ * one mip through FTextureSource::GetMipData. Uncompressed sources are not copied at all.
+ * For sources stored as PNG or JPEG, only the compressed payload is fetched (CompressedData) and
+ * the pixels are decoded later on a worker thread by DecodeTextureSourceData, unless
+ * TextureChannelPacker.AsyncSourceDecode is 0; other compressed sources are decompressed here.
+ * This MUST be called on the Game Thread.
+ *
+ * @param SourceTex The source UTexture2D asset.
+ * @param Width Output width of the pack. With Height, selects the mip to read (see SelectChannelPackSourceMip); 0 reads mip 0.
+ * @param Height Output height of the pack.
+ * @return FTextureRawData A struct containing the shared mip data and metadata.
+ */
+FTextureRawData ExtractTextureSourceData(UTexture2D* SourceTex, int32 Width = 0, int32 Height = 0);
+
+/**
+ * @brief Decodes the compressed payload fetched by ExtractTextureSourceData into RawData.
+ *
+ * Safe to call on any thread; touches nothing but Raw. On success, CompressedData and Decoder are
+ * released. On failure, Raw is left unchanged (NeedsDecode() stays true) so the Game Thread can report it.
+ *
+ * @return true if Raw holds decoded pixels afterwards.
+ */
+bool DecodeTextureSourceData(FTextureRawData& Raw);
+
+/** Largest output width or height. Larger packs are written in one pass per input if they exceed the memory budget. */
+static constexpr int32 ChannelPackMaxResolution = 16384;
+
+/**
+ * @brief Returns the memory budget of the packs in flight in bytes (TextureChannelPacker.MemoryBudgetMB).
+ *
+ * Covers the output mips, the extracted inputs, the planes captured for the plane cache and the
+ * engine's scratch buffers. A single pack that exceeds it is written one input at a time, and a
+ * batch only starts another job if its estimate fits in what the jobs in flight leave of it.
+ */
+int64 GetChannelPackMemoryBudget();
+
+/**
+ * @struct FChannelPackSettings
+ * @brief Everything that defines a packed texture apart from its input textures.
+ *
+ * Filled from the UI state by the editor tab and from a manifest row by the commandlet.
+ * Arrays are indexed by output channel (R, G, B, A).
+ */
+struct FChannelPackSettings
+{
+    int32 Width = 2048;
+    int32 Height = 2048;
+    ETextureResizeFilter Filter = ETextureResizeFilter::Bilinear;
+    TextureCompressionSettings CompressionSettings = TC_Masks;
+    bool bInvert[4] = { false, false, false, false };
+    ETextureSourceChannel SourceChannels[4] = { ETextureSourceChannel::Red, ETextureSourceChannel::Red, ETextureSourceChannel::Red, ETextureSourceChannel::Red };
+
+    /** Reuse the existing output asset if its stored recipe fingerprint matches. Not part of the fingerprint. */
+    bool bSkipUnchanged = true;
+};
+
+/**
+ * @struct FChannelPackVariant
+ * @brief An additional, smaller output of a pack, resampled from the pack's output instead of from the inputs.
+ */
+struct FChannelPackVariant
+{
+    /** Long package name of the variant asset (e.g., "/Game/Textures/T_Rock_ORM_1024"). */
+    FString PackageName;
+
+    /** Size of the variant. At most the size of the main output. */
+    int32 Width = 0;
+    int32 Height = 0;
+};
+
+/**
+ * @brief Parses a list of output variants such as "1024; 512" or "2048x1024=/Game/T_Rock_ORM_2K".
+ *
+ * Entries are separated by ';' or ','. Each entry is a size ("N" keeps the aspect ratio of the main
+ * output with a width of N, "WxH" is explicit), optionally followed by "=" and the output: a long
+ * package name, or an asset name placed next to the main output. Without an output, the variant is
+ * named after the main output with a "_N" (or "_WxH") suffix.
+ *
+ * @param Text The variant list. An empty string yields no variants.
+ * @param PackageName Long package name of the main output.
+ * @param Width Width of the main output.
+ * @param Height Height of the main output.
+ * @return false with OutError set if an entry is malformed, larger than the main output or names an asset twice.
+ */
+bool ParseChannelPackVariants(const FString& Text, const FString& PackageName, int32 Width, int32 Height, TArray<FChannelPackVariant>& OutVariants, FString& OutError);
+
+/**
+ * @struct FChannelPackJob
+ * @brief State of a texture generation that runs in the background.
+ *
+ * Created and finalized on the Game Thread. While the task runs, worker threads only read
+ * RawInputs and write to the locked output mip; every UObject is touched on the Game Thread only.
+ */
+struct FChannelPackJob
+{
+    FString PackageName;
+
+    /** Names the job's CPU events in Unreal Insights: output name and size and the format and size of every input. */
+    FString TraceLabel;
+
+    /**
+     * Counts every buffer of the job while it is held: extracted inputs, cached and captured planes,
+     * the output mips and the engine's scratch (through Control.Memory). Variants count toward the
+     * tracker of their main job. Declared before the buffers so that it outlives them.
+     */
+    FChannelPackMemoryTracker Memory;
+
+    /** Settings captured when the job started, so UI changes during the job do not affect it. */
+    FChannelPackSettings Settings;
+
+    /**
+     * Keep the package and texture alive until the job is finalized. A new texture is built in the
+     * transient package and moved into Package only when the pack succeeds.
+     */
+    TStrongObjectPtr<UPackage> Package;
+    TStrongObjectPtr<UTexture2D> Texture;
+
+    /** Shared source data referenced by Channels. Must outlive the task. */
+    TArray<FTextureRawData> RawInputs;
+    FChannelPackDesc Channels[4];
+
+    /** Recipe fingerprint stored on the output asset (see ComputeChannelPackFingerprint). */
+    FString Fingerprint;
+
+    /**
+     * The existing output asset was packed from the same recipe, so no task was launched and
+     * Texture is that asset. FinishChannelPackJob only updates its compression settings if needed.
+     */
+    bool bUpToDate = false;
+
+    /** For each slot, the first slot that uses the same input texture (itself if none). */
+    int32 FirstSlotOfInput[4] = { 0, 1, 2, 3 };
+
+    /** Plane cache key per slot. Empty if the slot's resized plane is not cached. */
+    FString PlaneCacheKeys[4];
+
+    /** Resized planes fetched from the plane cache, referenced by Channels[].CachedPlane. Must outlive the task. */
+    FChannelPackCachedPlane CachedPlanes[4];
+
+    /** Counts CachedPlanes against Memory. */
+    FChannelPackMemoryCharge CachedPlanesCharge;
+
+    /** Resized planes written by the task (Channels[].CapturePlane), stored in the cache once the job succeeds. */
+    FChannelPackCapturedPlane CapturedPlanes[4];
+
+    /** Plane cache lookups still in flight; the last one to complete triggers PlaneCacheLookupsDone. */
+    std::atomic<int32> NumPendingPlaneLookups{0};
+    UE::Tasks::FTaskEvent PlaneCacheLookupsDone{ UE_SOURCE_LOCATION };
+
+    /**
+     * The plane cache lookups, issued by BeginChannelPackJob and filling CachedPlanes from the cache's
+     * threads. Declared after what they write, so that destroying the job cancels them first.
+     */
+    UE::DerivedData::FRequestOwner PlaneCacheRequest{ UE::DerivedData::EPriority::Normal };
+
+    /**
+     * Set while the first pass waits for the plane cache lookups (Task completes with them). The inputs
+     * and the parent of every variant are kept until AdvanceChannelPackJob extracts them.
+     */
+    bool bAwaitingPlaneCache = false;
+    double PlaneCacheLookupStartTime = 0.0;
+    TStrongObjectPtr<UTexture2D> LookupInputs[4];
+    TArray<int32> VariantParents;
+
+    /**
+     * RawInputs holds the inputs of the first pass, extracted by BeginChannelPackJob or, after the plane
+     * cache lookups, by AdvanceChannelPackJob. Callers report extraction errors once this is set.
+     */
+    bool bInputsExtracted = false;
+
+    /**
+     * The pack shared by the stages of a pipelined pass (see PassStages), which holds the planes that
+     * are not captured until their bands are interleaved. Released once every stage has completed.
+     */
+    TUniquePtr<FChannelPackStagedPack> StagedPack;
+
+    /** Time from issuing the plane cache lookups until the inputs were extracted after them. */
+    double PlaneCacheFetchSeconds = 0.0;
+
+    /** Game Thread time spent extracting the inputs (reading mips, fetching compressed payloads), summed over passes. */
+    double ExtractSeconds = 0.0;
+
+    /** Tasks decoding the compressed inputs of the current pass. The packing task of the pass starts once they complete. */
+    TArray<UE::Tasks::FTask> DecodeTasks;
+
+    /**
+     * Stages of a pipelined first pass (TextureChannelPacker.Pipelined): one task per input, launched as
+     * soon as the input is extracted, that converts and resizes its channels into full planes once it is
+     * decoded, and one for the empty and cached slots. Each band is interleaved by the last stage to
+     * produce its rows (FChannelPackStagedPack). Each returns whether it completed. Task completes once
+     * they all have. Empty for other passes.
+     */
+    TArray<UE::Tasks::TTask<bool>> PassStages;
+
+    /** Worker time spent in DecodeTasks, summed over inputs and passes (in cycles, see GetDecodeSeconds). */
+    std::atomic<uint64> DecodeCycles{0};
+
+    /** Estimated peak memory of the pack in bytes (output, extracted inputs and captured planes). */
+    int64 EstimatedPeakBytes = 0;
+
+    /**
+     * Slots (first slot of each input) whose inputs are packed by later passes, in order. Empty unless
+     * the inputs do not fit in the memory budget together; the job then holds one input at a time
+     * and writes only that input's channels in each pass (see AdvanceChannelPackJob).
+     */
+    TArray<int32> PendingPassSlots;
+
+    /** Inputs of PendingPassSlots, indexed by slot, kept alive until their pass extracts them. */
+    TStrongObjectPtr<UTexture2D> PendingInputs[4];
+
+    int32 NumPasses = 1;
+    int32 NumCompletedPasses = 0;
+
+    /**
+     * Jobs of the variants (see FChannelPackVariant), ordered so that each one is resampled from the
+     * main output or an earlier variant: the smallest one that is at least as large. They are packed
+     * by a last pass of this job and finalized together with it.
+     */
+    TArray<TSharedPtr<FChannelPackJob>> VariantJobs;
+
+    /** Mip 0 of Texture->Source, locked while the task runs. Null if the lock failed. */
+    uint8* MipData = nullptr;
+
+    /** Counts MipData against Memory while it is locked. */
+    FChannelPackMemoryCharge OutputCharge;
+
+    /** Cancellation token and per-band progress shared with the task. */
+    FChannelPackControl Control;
+
+    /**
+     * The background packing task of the current pass, launched with DecodeTasks (or PassStages) as prerequisites.
+     * Written by the task: bSucceeded, PackSeconds (summed over passes; the wall time of a pipelined pass).
+     */
+    UE::Tasks::FTask Task;
+    bool bSucceeded = false;
+    double PackSeconds = 0.0;
+
+    /** Game Thread time spent in UpdateResource and PostEditChange of the finished texture. */
+    double UpdateResourceSeconds = 0.0;
+    double PostEditChangeSeconds = 0.0;
+
+    /** Non-modal progress notification with a Cancel button (editor tab only). */
+    TSharedPtr<SNotificationItem> Notification;
+
+    double StartTime = 0.0;
+
+    /** @return true while compressed inputs of the current pass are being decoded. */
+    bool IsDecodingSources() const
+    {
+        return Algo::AnyOf(DecodeTasks, [](const UE::Tasks::FTask& DecodeTask) { return !DecodeTask.IsCompleted(); });
+    }
+
+    /** @return The worker time spent decoding compressed inputs so far. */
+    double GetDecodeSeconds() const
+    {
+        return FPlatformTime::ToSeconds64(DecodeCycles.load(std::memory_order_relaxed));
+    }
+
+    /** @return The fraction of the pack done so far over all passes, from 0 to 1. */
+    float GetProgress() const
+    {
+        // The stages of a pipelined pass count a band once it is interleaved
+        return FMath::Clamp((NumCompletedPasses + Control.GetProgress()) / NumPasses, 0.0f, 1.0f);
+    }
+};
+
+/**
+ * @brief Estimates the peak memory of packing Inputs with Settings before the job is started, in bytes.
+ *
+ * Counts the output and variant mips and the extracted inputs, or only the largest input if they do
+ * not fit in GetChannelPackMemoryBudget() together (the job is then written one input at a time).
+ * Game Thread only. Used by FChannelPackBatch to decide whether a job fits next to the jobs in flight.
+ */
+int64 EstimateChannelPackJobBytes(UTexture2D* const (&Inputs)[4], const FChannelPackSettings& Settings, const TArray<FChannelPackVariant>& Variants);
+
+/**
+ * @brief Creates the output asset, extracts the inputs and launches the packing task.
+ *
+ * Must be called on the Game Thread. Empty slots (null inputs) are filled with black (RGB) or
+ * white (Alpha). Extraction errors are stored in RawInputs for the caller to report. If the
+ * output mip cannot be locked, no task is launched and the job finishes as failed.
+ *
+ * Resized planes of unchanged inputs are fetched from the Derived Data Cache (see
+ * TextureChannelPackerPlaneCache.h); an input whose planes all hit the cache is not extracted. The
+ * lookups do not block: if there are any, the job returns with bAwaitingPlaneCache set and Job.Task
+ * completing once they have, and AdvanceChannelPackJob then extracts the inputs and launches the
+ * first pass. Until bInputsExtracted is set, RawInputs is empty.
+ *
+ * If the output and the inputs together exceed GetChannelPackMemoryBudget(), only the first input is
+ * extracted; the others are extracted one by one by AdvanceChannelPackJob, each after the previous
+ * pass has released its input.
+ *
+ * Otherwise, with two or more inputs to extract, the first pass is pipelined: each input's channels are
+ * packed by their own stage as soon as the input is extracted (and decoded), while the Game Thread
+ * extracts the next input (see FChannelPackJob::PassStages).
+ *
+ * Variants are created as their own assets. The inputs are extracted once for the main output, and
+ * each variant is then resampled, in a last pass, from the nearest larger level of the packed outputs. The job is
+ * only up to date if the main output and every variant are.
+ *
+ * If Settings.bSkipUnchanged is set and the existing output asset stores the same recipe
+ * fingerprint, nothing is extracted or packed: the job is returned already succeeded with bUpToDate set.
+ *
+ * @param PackageName Long package name of the output asset (e.g., "/Game/Textures/T_Rock_ORM").
+ * @param Inputs Input textures for R, G, B and A; may be null.
+ * @param Settings Output resolution, filter, compression and per-slot options.
+ * @param Variants Smaller outputs to create from the same pack (see ParseChannelPackVariants).
+ * @param OutError Optional; receives the reason when nullptr is returned because an output name is
+ *        taken by an asset that is not a texture. That asset is left untouched.
+ * @return The running job, or nullptr if a package could not be created or an output name is taken.
+ */
+TSharedPtr<FChannelPackJob> BeginChannelPackJob(const FString& PackageName, UTexture2D* const (&Inputs)[4], const FChannelPackSettings& Settings, const TArray<FChannelPackVariant>& Variants = TArray<FChannelPackVariant>(), FText* OutError = nullptr);
+
+/**
+ * @brief Starts the next pass of a job written in several passes, once the current pass has completed.
+ *
+ * Must be called on the Game Thread after Job.Task has completed. Once the plane cache lookups of
+ * BeginChannelPackJob have completed, extracts the inputs and launches the first pass. After a pass,
+ * releases its input, extracts the next one and launches its task. A job that fails to read the next
+ * input fails.
+ *
+ * @return true if another pass was launched; false once the job is ready for FinishChannelPackJob.
+ */
+bool AdvanceChannelPackJob(FChannelPackJob& Job);
+
+/**
+ * @brief Waits for the packing task and finalizes the output asset on the Game Thread.
+ *
+ * On success, moves the new texture into the output package in place of the existing asset (loaded
+ * references to it are redirected), stores the newly resized planes in the plane cache and the recipe
+ * fingerprint on the texture, applies the compression settings, updates the texture resource and
+ * registers the asset. On failure or cancellation (Job.bSucceeded is false), the new texture is
+ * discarded, an existing asset is left untouched and a package created for the job is dropped. For an
+ * up-to-date job, only changed compression settings are applied. Variants are finalized with the same outcome.
+ */
+void FinishChannelPackJob(FChannelPackJob& Job);
@@ -0,0 +1,166 @@
+#include "TextureChannelPackerPlaneCache.h"
+#include "TextureChannelPackerEngine.h"
+#include "TextureChannelPackerJob.h"
+#include "DerivedDataCache.h"
+#include "DerivedDataCacheKey.h"
+#include "DerivedDataRequestOwner.h"
+#include "DerivedDataValue.h"
+#include "IO/IoHash.h"
+#include "Tasks/Task.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarChannelPackPlaneCache(
+    TEXT("TextureChannelPacker.PlaneCache"),
+    true,
+    TEXT("Store resized input channels in the Derived Data Cache so unchanged channels are not resized again by later packs."));
+
+static TAutoConsoleVariable<int32> CVarChannelPackPlaneCacheMaxMB(
+    TEXT("TextureChannelPacker.PlaneCacheMaxMB"),
+    64,
+    TEXT("Largest resized plane stored in the plane cache, in MB (64 holds an 8K plane). Larger planes are resized on every pack. 0 removes the limit."));
+
+/** Change when the packing engine produces different planes, so stale cache entries are ignored. */
+static const TCHAR* const ChannelPackPlaneCacheVersion = TEXT("5C0E4A7F3B2D4E1A9F60B1C2D3E4F501");
+
+/** Stored in front of the plane bytes. */
+struct FChannelPackPlaneCacheHeader
+{
+    int64 NumBytes = 0;
+    double ProduceSeconds = 0.0;
+};
+
+/** Session totals, for the hit rate and time saved logged after every job. */
+struct FChannelPackPlaneCacheStats
+{
+    int32 Hits = 0;
+    int32 Misses = 0;
+    double SavedSeconds = 0.0;
+};
+
+static FChannelPackPlaneCacheStats GChannelPackPlaneCacheStats;
+
+const uint8* FChannelPackCachedPlane::GetPixels() const
+{
+    return (const uint8*)Payload.GetData() + sizeof(FChannelPackPlaneCacheHeader);
+}
+
+void FChannelPackCapturedPlane::Allocate(int64 NumBytes, FChannelPackMemoryTracker& Tracker)
+{
+    Payload = FUniqueBuffer::Alloc(sizeof(FChannelPackPlaneCacheHeader) + NumBytes);
+    Charge = FChannelPackMemoryCharge((int64)Payload.GetSize(), Tracker);
+}
+
+void FChannelPackCapturedPlane::Reset()
+{
+    Payload.Reset();
+    Charge.Reset();
+}
+
+uint8* FChannelPackCapturedPlane::GetPixels()
+{
+    return (uint8*)Payload.GetData() + sizeof(FChannelPackPlaneCacheHeader);
+}
+
+/** The plane cache entries live in their own bucket; the key text (see MakeChannelPackPlaneCacheKey) is hashed into the key. */
+static UE::DerivedData::FCacheKey GetChannelPackPlaneCacheKey(const FString& Key)
+{
+    static const UE::DerivedData::FCacheBucket Bucket(TEXTVIEW("TextureChannelPackerPlane"));
+    return { Bucket, FIoHash::HashBuffer(*Key, Key.Len() * sizeof(TCHAR)) };
+}
+
+bool ShouldCacheChannelPackPlane(int32 SourceWidth, int32 SourceHeight, ETextureSourceFormat SourceFormat, int32 Width, int32 Height)
+{
+    if (!CVarChannelPackPlaneCache.GetValueOnGameThread())
+    {
+        return false;
+    }
+
+    const int64 MaxBytes = (int64)CVarChannelPackPlaneCacheMaxMB.GetValueOnGameThread() * 1024 * 1024;
+    if (MaxBytes > 0 && (int64)Width * Height > MaxBytes)
+    {
+        return false;
+    }
+
+    const bool bResize = SourceWidth != Width || SourceHeight != Height;
+    const bool b8Bit = SourceFormat == TSF_G8 || SourceFormat == TSF_BGRA8;
+    return bResize || !b8Bit;
+}
+
+FString MakeChannelPackPlaneCacheKey(const FGuid& SourceId, int32 SourceMip, ETextureSourceChannel SourceChannel, int32 Width, int32 Height, ETextureResizeFilter Filter)
+{
+    return FString::Printf(TEXT("%s_%s_%d_%d_%dx%d_%d"), ChannelPackPlaneCacheVersion, *SourceId.ToString(EGuidFormats::Digits), SourceMip, (int32)SourceChannel, Width, Height, (int32)Filter);
+}
+
+void RequestChannelPackPlanes(TConstArrayView<FString> Keys, int64 NumBytes, UE::DerivedData::IRequestOwner& Owner,
+    TUniqueFunction<void(int32 KeyIndex, FChannelPackCachedPlane&& Plane)> OnFetched)
+{
+    using namespace UE::DerivedData;
+
+    TArray<FCacheGetValueRequest> Requests;
+    for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); ++KeyIndex)
+    {
+        Requests.Add({ FSharedString(Keys[KeyIndex]), GetChannelPackPlaneCacheKey(Keys[KeyIndex]), ECachePolicy::Default, (uint64)KeyIndex });
+    }
+
+    GetCache().GetValue(Requests, Owner, [KeyNames = TArray<FString>(Keys), NumBytes, OnFetched = MoveTemp(OnFetched)](FCacheGetValueResponse&& Response)
+    {
+        FChannelPackCachedPlane Plane;
+        if (Response.Status == EStatus::Ok)
+        {
+            FSharedBuffer Payload = Response.Value.GetData().Decompress();
+            FChannelPackPlaneCacheHeader Header;
+            if (Payload.GetSize() >= sizeof(Header))
+            {
+                FMemory::Memcpy(&Header, Payload.GetData(), sizeof(Header));
+            }
+            if (Header.NumBytes == NumBytes && (int64)Payload.GetSize() == (int64)sizeof(Header) + NumBytes)
+            {
+                Plane.Payload = MoveTemp(Payload);
+                Plane.ProduceSeconds = Header.ProduceSeconds;
+            }
+            else
+            {
+                UE_LOG(LogTexturePacker, Warning, TEXT("Ignoring plane cache entry with unexpected size: %s"), *KeyNames[(int32)Response.UserData]);
+            }
+        }
+        OnFetched((int32)Response.UserData, MoveTemp(Plane));
+    });
+}
+
+void StoreChannelPackPlane(const FString& Key, FChannelPackCapturedPlane&& Plane, double ProduceSeconds)
+{
+    check(IsInGameThread());
+
+    FChannelPackPlaneCacheHeader Header;
+    Header.NumBytes = (int64)Plane.Payload.GetSize() - (int64)sizeof(Header);
+    Header.ProduceSeconds = ProduceSeconds;
+    FMemory::Memcpy(Plane.Payload.GetData(), &Header, sizeof(Header));
+
+    // Hashing and compressing a plane takes a while for 8K planes; keep it off the Game Thread
+    FSharedBuffer Payload = Plane.Payload.MoveToShared();
+    Plane.Reset();
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Key, Payload = MoveTemp(Payload)]()
+    {
+        using namespace UE::DerivedData;
+        FRequestOwner Owner(EPriority::Low);
+        GetCache().PutValue({ { FSharedString(Key), GetChannelPackPlaneCacheKey(Key), FValue::Compress(Payload) } }, Owner);
+        Owner.KeepAlive();
+    }, LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+void RecordChannelPackPlaneCacheResults(const FString& PackageName, int32 Hits, int32 Misses, double SavedSeconds)
+{
+    if (Hits + Misses == 0)
+    {
+        return;
+    }
+
+    FChannelPackPlaneCacheStats& Stats = GChannelPackPlaneCacheStats;
+    Stats.Hits += Hits;
+    Stats.Misses += Misses;
+    Stats.SavedSeconds += SavedSeconds;
+
+    UE_LOG(LogTexturePacker, Log, TEXT("Plane cache for %s: %d hits, %d misses, saved ~%.2f s (session: %.0f%% hit rate, saved ~%.2f s)"),
+        *PackageName, Hits, Misses, SavedSeconds,
+        100.0 * Stats.Hits / (Stats.Hits + Stats.Misses), Stats.SavedSeconds);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture.h"
+#include "Memory/SharedBuffer.h"
+#include "TextureChannelPackerMemory.h"
+#include "TextureChannelPackerTypes.h"
+
+namespace UE::DerivedData { class IRequestOwner; }
+
+/**
+ * @struct FChannelPackCachedPlane
+ * @brief One converted and resized 8-bit channel plane fetched from the Derived Data Cache.
+ */
+struct FChannelPackCachedPlane
+{
+    /** Header and pixels as stored in the cache. Null if nothing was fetched. */
+    FSharedBuffer Payload;
+
+    /** Worker time it took to produce the plane when it was stored, used to estimate the time saved. */
+    double ProduceSeconds = 0.0;
+
+    bool IsValid() const { return !Payload.IsNull(); }
+
+    /** @return The Width * Height plane bytes (before inversion). */
+    const uint8* GetPixels() const;
+};
+
+/**
+ * @struct FChannelPackCapturedPlane
+ * @brief A resized plane written by the packing task to be stored in the cache.
+ *
+ * The buffer leaves room for the cache header in front of the pixels, so that StoreChannelPackPlane
+ * hands it to the cache without copying it. Move-only.
+ */
+struct FChannelPackCapturedPlane
+{
+    /** Allocates a plane of NumBytes, counted against Tracker until it is stored or reset. */
+    void Allocate(int64 NumBytes, FChannelPackMemoryTracker& Tracker);
+
+    void Reset();
+
+    bool IsValid() const { return !Payload.IsNull(); }
+
+    /** @return The NumBytes of plane pixels the task writes. */
+    uint8* GetPixels();
+
+    /** Header and pixels. */
+    FUniqueBuffer Payload;
+
+    FChannelPackMemoryCharge Charge;
+};
+
+/**
+ * @brief Returns whether a slot's resized plane is worth caching.
+ *
+ * The cache is skipped for 8-bit sources that already have the output size: reading them back
+ * from the cache would cost about as much as converting them again. Planes larger than
+ * TextureChannelPacker.PlaneCacheMaxMB are skipped as well, so that a 16K pack does not hold and
+ * write hundreds of megabytes per input. Controlled by the TextureChannelPacker.PlaneCache console variable.
+ */
+bool ShouldCacheChannelPackPlane(int32 SourceWidth, int32 SourceHeight, ETextureSourceFormat SourceFormat, int32 Width, int32 Height);
+
+/**
+ * @brief Builds the cache key of a resized plane.
+ *
+ * @param SourceId Content ID of the source (FTextureSource::GetId), which changes with the source pixels.
+ * @param SourceMip The source mip the plane is resized from (see SelectChannelPackSourceMip).
+ * @param SourceChannel The channel read from the source (Red for single-channel formats).
+ * @param Width Output width.
+ * @param Height Output height.
+ * @param Filter Resize filter.
+ */
+FString MakeChannelPackPlaneCacheKey(const FGuid& SourceId, int32 SourceMip, ETextureSourceChannel SourceChannel, int32 Width, int32 Height, ETextureResizeFilter Filter);
+
+/**
+ * @brief Looks up planes of NumBytes in the Derived Data Cache without waiting for them.
+ *
+ * Issues one request per key in Owner; cancelling or destroying Owner cancels them. OnFetched is
+ * called once per key, on any thread, with the index of the key and the plane, which is invalid on a
+ * miss or if the cached data does not have the expected size.
+ */
+void RequestChannelPackPlanes(TConstArrayView<FString> Keys, int64 NumBytes, UE::DerivedData::IRequestOwner& Owner,
+    TUniqueFunction<void(int32 KeyIndex, FChannelPackCachedPlane&& Plane)> OnFetched);
+
+/**
+ * @brief Stores a captured plane in the Derived Data Cache and returns at once. Game Thread only.
+ *
+ * The plane is handed over without a copy; a background task hashes it and writes it to the cache.
+ *
+ * @param ProduceSeconds Estimated worker time the plane cost, reported as time saved by later hits.
+ */
+void StoreChannelPackPlane(const FString& Key, FChannelPackCapturedPlane&& Plane, double ProduceSeconds);
+
+/**
+ * @brief Adds the plane cache results of one job to the session totals and logs both.
+ *
+ * @param Hits Number of planes fetched from the cache.
+ * @param Misses Number of planes produced and stored.
+ * @param SavedSeconds Estimated worker time saved by the hits, minus the time spent fetching them.
+ */
+void RecordChannelPackPlaneCacheResults(const FString& PackageName, int32 Hits, int32 Misses, double SavedSeconds);
@@ -0,0 +1,80 @@
+#include "TextureChannelPackerRecipe.h"
+#include "TextureChannelPackerJob.h"
+#include "Engine/Texture2D.h"
+#include "Hash/Blake3.h"
+
+/** Bump when a change to the packing engine changes the output pixels, so existing assets are repacked. */
+static constexpr uint32 ChannelPackRecipeVersion = 1;
+
+template <typename T>
+static void HashValue(FBlake3& Hasher, const T& Value)
+{
+    Hasher.Update(&Value, sizeof(T));
+}
+
+FString ComputeChannelPackFingerprint(UTexture2D* const (&Inputs)[4], const FChannelPackSettings& Settings)
+{
+    FBlake3 Hasher;
+    HashValue(Hasher, ChannelPackRecipeVersion);
+    HashValue(Hasher, Settings.Width);
+    HashValue(Hasher, Settings.Height);
+    HashValue(Hasher, (uint8)Settings.Filter);
+
+    for (int32 i = 0; i < 4; ++i)
+    {
+        FGuid SourceId;
+        int32 SourceMip = 0;
+#if WITH_EDITORONLY_DATA
+        if (Inputs[i])
+        {
+            if (!Inputs[i]->Source.IsValid())
+            {
+                return FString();
+            }
+            SourceId = Inputs[i]->Source.GetId();
+            SourceMip = SelectChannelPackSourceMip(Inputs[i], Settings.Width, Settings.Height);
+        }
+#endif
+        HashValue(Hasher, SourceId);
+        HashValue(Hasher, SourceMip);
+        HashValue(Hasher, (uint8)Settings.SourceChannels[i]);
+        HashValue(Hasher, (uint8)Settings.bInvert[i]);
+    }
+
+    return LexToString(Hasher.Finalize());
+}
+
+FString ComputeChannelPackVariantFingerprint(const FString& ParentFingerprint, int32 Width, int32 Height, ETextureResizeFilter Filter)
+{
+    if (ParentFingerprint.IsEmpty())
+    {
+        return FString();
+    }
+
+    FBlake3 Hasher;
+    HashValue(Hasher, ChannelPackRecipeVersion);
+    Hasher.Update(*ParentFingerprint, ParentFingerprint.Len() * sizeof(TCHAR));
+    HashValue(Hasher, Width);
+    HashValue(Hasher, Height);
+    HashValue(Hasher, (uint8)Filter);
+    return LexToString(Hasher.Finalize());
+}
+
+FString GetChannelPackFingerprint(UTexture2D* Texture)
+{
+    const UTextureChannelPackRecipe* Recipe = Texture ? Texture->GetAssetUserData<UTextureChannelPackRecipe>() : nullptr;
+    return Recipe ? Recipe->Fingerprint : FString();
+}
+
+void SetChannelPackFingerprint(UTexture2D* Texture, const FString& Fingerprint)
+{
+    Texture->RemoveUserDataOfClass(UTextureChannelPackRecipe::StaticClass());
+    if (Fingerprint.IsEmpty())
+    {
+        return;
+    }
+
+    UTextureChannelPackRecipe* Recipe = NewObject<UTextureChannelPackRecipe>(Texture);
+    Recipe->Fingerprint = Fingerprint;
+    Texture->AddAssetUserData(Recipe);
+}
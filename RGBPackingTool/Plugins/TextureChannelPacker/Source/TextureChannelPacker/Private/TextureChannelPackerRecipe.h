@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "TextureChannelPackerTypes.h"
+#include "TextureChannelPackerRecipe.generated.h"
+
+class UTexture2D;
+struct FChannelPackSettings;
+
+/**
+ * @class UTextureChannelPackRecipe
+ * @brief Asset user data stored on every packed texture: the fingerprint of the recipe that produced it.
+ *
+ * Lets a later pack of the same output detect that its inputs and settings are unchanged and
+ * skip the extraction, resize and interleave. Editor-only, so it is stripped when cooking.
+ */
+UCLASS()
+class UTextureChannelPackRecipe : public UAssetUserData
+{
+    GENERATED_BODY()
+
+public:
+    /** Hash of everything that determines the packed pixels (see ComputeChannelPackFingerprint). */
+    UPROPERTY(VisibleAnywhere, Category = "Texture Channel Packer")
+    FString Fingerprint;
+
+    //~ Begin UObject Interface
+    virtual bool IsEditorOnly() const override { return true; }
+    //~ End UObject Interface
+};
+
+/**
+ * @brief Hashes the recipe of a packed texture.
+ *
+ * Covers the source content of each input (FTextureSource::GetId, which changes whenever the
+ * source pixels change), the slot mapping, source channels, invert flags, resolution and filter.
+ * Compression and sRGB are not included: they do not change the packed pixels and are applied
+ * to an up-to-date asset without repacking.
+ *
+ * @return A hex string, or an empty string if an input has no source data.
+ */
+FString ComputeChannelPackFingerprint(UTexture2D* const (&Inputs)[4], const FChannelPackSettings& Settings);
+
+/**
+ * @brief Hashes the recipe of an output variant: the fingerprint of the output it is resampled from, its size and filter.
+ *
+ * @return A hex string, or an empty string if ParentFingerprint is empty.
+ */
+FString ComputeChannelPackVariantFingerprint(const FString& ParentFingerprint, int32 Width, int32 Height, ETextureResizeFilter Filter);
+
+/** Returns the fingerprint stored on a packed texture, or an empty string. */
+FString GetChannelPackFingerprint(UTexture2D* Texture);
+
+/** Stores the fingerprint on a packed texture, replacing any previous one. */
+void SetChannelPackFingerprint(UTexture2D* Texture, const FString& Fingerprint);
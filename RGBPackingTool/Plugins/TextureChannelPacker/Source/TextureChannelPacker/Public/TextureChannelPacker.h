@@ -4,10 +4,20 @@
 #include "Modules/ModuleManager.h"
 #include "Input/Reply.h"
 #include "Engine/Texture.h"
+#include "Containers/Ticker.h"
+#include "TextureChannelPackerTypes.h"
 
 class SDockTab;
 class FSpawnTabArgs;
 class UTexture2D;
+class ITableRow;
+class STableViewBase;
+template <typename ItemType> class SListView;
+struct FChannelPackJob;
+struct FChannelPackSettings;
+struct FChannelPackBatchItem;
+struct FChannelPackVariant;
+class FChannelPackBatch;
 
 /**
  * @struct FCompressionOption
@@ -37,6 +47,59 @@ struct FCompressionOption
     FText GetDisplayName() const;
 };
 
+/**
+ * @struct FResizeFilterOption
+ * @brief Represents a resize filter option shown in the UI.
+ *
+ * Mirrors FCompressionOption: a locale-independent identifier, the filter enum used by the
+ * packing engine, and localized display names.
+ */
+struct FResizeFilterOption
+{
+    /** Internal identifier for comparison and logic (locale-independent, e.g., "Bilinear"). */
+    FString InternalName;
+
+    /** The resize filter used by the packing engine. */
+    ETextureResizeFilter Filter;
+
+    /** Display name in English. */
+    FString DisplayNameEn;
+
+    /** Display name in Japanese. */
+    FString DisplayNameJa;
+
+    /**
+     * @brief Returns the display name localized for the current editor language.
+     * @return FText The localized display name.
+     */
+    FText GetDisplayName() const;
+};
+
+/**
+ * @struct FSourceChannelOption
+ * @brief Represents a source channel option (R, G, B, A, Luminance) shown next to each input slot.
+ */
+struct FSourceChannelOption
+{
+    /** Internal identifier for comparison and logic (locale-independent, e.g., "Green"). */
+    FString InternalName;
+
+    /** The source channel read by the packing engine. */
+    ETextureSourceChannel Channel;
+
+    /** Display name in English. */
+    FString DisplayNameEn;
+
+    /** Display name in Japanese. */
+    FString DisplayNameJa;
+
+    /**
+     * @brief Returns the display name localized for the current editor language.
+     * @return FText The localized display name.
+     */
+    FText GetDisplayName() const;
+};
+
 /**
  * @class FTextureChannelPackerModule
  * @brief The main module class for the Texture Channel Packer plugin.
@@ -80,6 +143,23 @@ private:
      */
     FReply OnGenerateClicked();
 
+    /**
+     * @brief Validates the inputs and output settings shown in the UI and builds the output package name.
+     *
+     * Shared by 'Generate Texture' and 'Add to Queue'. Shows a notification for invalid settings
+     * and asks for confirmation before an existing asset is overwritten.
+     *
+     * @param OutPackageName Receives the full package name (output path + file name).
+     * @param OutVariants Receives the output variants parsed from VariantSizes.
+     * @return false if the settings are invalid or the user declined to overwrite.
+     */
+    bool ValidateOutputAndGetPackageName(FString& OutPackageName, TArray<FChannelPackVariant>& OutVariants);
+
+    /**
+     * @brief Builds the pack settings (resolution, filter, compression, per-slot options) from the UI state.
+     */
+    FChannelPackSettings GetChannelPackSettings() const;
+
     /**
      * @brief Automatically generates a suggested output file name based on the input textures.
      *
@@ -90,16 +170,94 @@ private:
     void AutoGenerateFileName();
 
     /**
-     * @brief Creates the packed texture asset.
+     * @brief Starts creating the packed texture asset.
      *
-     * Executes the packing workflow: extracting source data, processing it in parallel,
-     * and writing the final pixels to a new UTexture2D asset.
+     * Creates the package and texture and extracts the source data on the Game Thread, then
+     * launches the packing as a background task and returns immediately. When planes are looked
+     * up in the plane cache, extraction waits for the lookups and TickActivePackJob() runs it.
+     * The editor stays interactive while the task runs; TickActivePackJob() reports progress and
+     * commits the asset once the task has finished.
      *
      * @param PackageName The full package path and name for the new asset.
      * @param Width The target width for the output texture.
      * @param Height The target height for the output texture.
+     * @param Variants Smaller outputs resampled from the same pack.
+     */
+    void CreateTexture(const FString& PackageName, int32 Width, int32 Height, const TArray<FChannelPackVariant>& Variants);
+
+    /**
+     * @brief Core ticker callback that follows the running pack job on the Game Thread.
+     *
+     * Updates the progress notification and, once the background task has completed,
+     * finalizes (or discards) the asset.
+     *
+     * @param DeltaTime Time since the last tick (unused).
+     * @return true to keep ticking while a job is active.
+     */
+    bool TickActivePackJob(float DeltaTime);
+
+    /**
+     * @brief Finalizes the active pack job after its background task has completed.
+     *
+     * Commits the texture on success. On cancellation or failure, the new package is discarded.
+     */
+    void FinishActivePackJob();
+
+    /**
+     * @brief Requests cancellation of the active pack job. The job stops before its next band.
      */
-    void CreateTexture(const FString& PackageName, int32 Width, int32 Height);
+    void CancelActivePackJob();
+
+    /**
+     * @brief Handles the 'Add to Queue' button: appends the current inputs and settings to the batch queue.
+     */
+    FReply OnAddToQueueClicked();
+
+    /**
+     * @brief Handles the 'Import Manifest...' button: appends every job of a JSON or CSV manifest to the batch queue.
+     */
+    FReply OnImportManifestClicked();
+
+    /**
+     * @brief Handles the 'Run Queue' / 'Cancel Queue' button.
+     */
+    FReply OnRunQueueClicked();
+
+    /**
+     * @brief Handles the 'Clear Queue' button: removes every item that is not running.
+     */
+    FReply OnClearQueueClicked();
+
+    /**
+     * @brief Core ticker callback that drives the batch queue on the Game Thread.
+     *
+     * Finalizes completed jobs and starts pending ones within a small time budget per tick,
+     * so the editor stays responsive while the queue runs.
+     *
+     * @param DeltaTime Time since the last tick (unused).
+     * @return true to keep ticking while the batch is running.
+     */
+    bool TickBatch(float DeltaTime);
+
+    /**
+     * @brief Core ticker callback that frees the scratch blocks left idle after a pack or a batch.
+     *
+     * Calls FChannelPackScratchArena::TrimIdle once a second until the arena holds no blocks.
+     *
+     * @param DeltaTime Time since the last tick (unused).
+     * @return true to keep ticking while the arena still caches blocks.
+     */
+    bool TickScratchArenaTrim(float DeltaTime);
+
+    /**
+     * @brief Registers TickScratchArenaTrim() unless it is already registered.
+     */
+    void ScheduleScratchArenaTrim();
+
+    /**
+     * @brief Creates a row of the batch queue list (output name and state).
+     */
+    TSharedRef<ITableRow> GenerateBatchItemRow(TSharedPtr<FChannelPackBatchItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
 
     /**
      * @brief Displays a notification toast in the editor.
@@ -109,6 +267,13 @@ private:
      */
     void ShowNotification(const FText& Message, bool bSuccess);
 
+    /**
+     * @brief Notifies the errors from the extraction of a job's inputs, once per texture.
+     *
+     * The channels of unreadable inputs are filled with default values.
+     */
+    void ShowExtractionErrors(const FChannelPackJob& Job);
+
     /**
      * @brief Converts the currently selected compression option string to the corresponding Unreal Engine enum.
      *
@@ -116,6 +281,13 @@ private:
      */
     TextureCompressionSettings GetSelectedCompressionSettings() const;
 
+    /**
+     * @brief Returns the resize filter selected in the UI.
+     *
+     * @return The ETextureResizeFilter value (defaults to Bilinear if nothing is selected).
+     */
+    ETextureResizeFilter GetSelectedResizeFilter() const;
+
     /**
      * @brief Creates a UI widget for a single texture input channel.
      *
@@ -124,10 +296,17 @@ private:
      * @param LabelText The display name for the channel (e.g., "Red Channel").
      * @param TargetTexturePtr A reference to the member variable that will hold the selected texture.
      * @param bInvertFlag A reference to the boolean flag controlling channel inversion.
+     * @param SourceChannel A reference to the member variable selecting which channel of the texture is read.
      * @param TooltipText Optional tooltip text describing the channel's usage.
      * @return A shared reference to the created widget.
      */
-    TSharedRef<SWidget> CreateChannelInputSlot(const FText& LabelText, TWeakObjectPtr<UTexture2D>& TargetTexturePtr, bool& bInvertFlag, const FText& TooltipText = FText::GetEmpty());
+    TSharedRef<SWidget> CreateChannelInputSlot(const FText& LabelText, TWeakObjectPtr<UTexture2D>& TargetTexturePtr, bool& bInvertFlag, ETextureSourceChannel& SourceChannel, const FText& TooltipText = FText::GetEmpty());
+
+    /**
+     * @brief Finds the dropdown option for a source channel.
+     * @return The matching option, or nullptr if none exists.
+     */
+    TSharedPtr<FSourceChannelOption> FindSourceChannelOption(ETextureSourceChannel Channel) const;
 
     // ========== Input Textures ==========
 
@@ -143,6 +322,18 @@ private:
     /** Flag to invert the Alpha channel input (255 - Value). */
     bool bInvertA = false;
 
+    /** Channel of InputTextureR that is read (only matters for RGBA inputs). */
+    ETextureSourceChannel SourceChannelR = ETextureSourceChannel::Red;
+
+    /** Channel of InputTextureG that is read (only matters for RGBA inputs). */
+    ETextureSourceChannel SourceChannelG = ETextureSourceChannel::Red;
+
+    /** Channel of InputTextureB that is read (only matters for RGBA inputs). */
+    ETextureSourceChannel SourceChannelB = ETextureSourceChannel::Red;
+
+    /** Channel of InputTextureA that is read (only matters for RGBA inputs). */
+    ETextureSourceChannel SourceChannelA = ETextureSourceChannel::Red;
+
     /** Texture to be packed into the Red channel of the output (e.g., Ambient Occlusion) */
     TWeakObjectPtr<UTexture2D> InputTextureR;
 
@@ -166,12 +357,21 @@ private:
     /** The filename for the generated texture asset (without extension) */
     FString OutputFileName = "T_Packed_Texture";
 
-    /** Target width for the output texture (in pixels). Valid range: 1-8192. */
+    /** Target width for the output texture (in pixels). Valid range: 1-16384. */
     int32 TargetWidth = 2048;
 
-    /** Target height for the output texture (in pixels). Valid range: 1-8192. */
+    /** Target height for the output texture (in pixels). Valid range: 1-16384. */
     int32 TargetHeight = 2048;
 
+    /**
+     * Additional output sizes resampled from the same pack, e.g. "1024, 512" (see ParseChannelPackVariants).
+     * Each variant is saved next to the output with a size suffix (e.g., T_Rock_ORM_1024).
+     */
+    FString VariantSizes;
+
+    /** Skip packing when the output asset was already packed from the same inputs and settings. */
+    bool bSkipUnchanged = true;
+
     // ========== Compression Settings ==========
 
     /** Available compression options for the dropdown menu ("Masks", "Grayscale", "Default") */
@@ -180,6 +380,17 @@ private:
     /** The currently selected compression option from the dropdown */
     TSharedPtr<FCompressionOption> CurrentCompressionOption;
 
+    // ========== Resize Settings ==========
+
+    /** Available resize filters for the dropdown menu ("Box", "Bilinear", "Mitchell", "CatmullRom", "Lanczos3") */
+    TArray<TSharedPtr<FResizeFilterOption>> ResizeFilterOptions;
+
+    /** The currently selected resize filter from the dropdown */
+    TSharedPtr<FResizeFilterOption> CurrentResizeFilterOption;
+
+    /** Available source channels for the per-slot dropdowns ("Red", "Green", "Blue", "Alpha", "Luminance") */
+    TArray<TSharedPtr<FSourceChannelOption>> SourceChannelOptions;
+
     // ========== Internal State ==========
 
     /**
@@ -187,4 +398,24 @@ private:
      * When true, auto-generation of filenames is disabled to preserve user input.
      */
     bool bFileNameManuallyEdited = false;
+
+    /** The pack job currently running in the background, or null. Only one job runs at a time. */
+    TSharedPtr<FChannelPackJob> ActivePackJob;
+
+    /** Handle of the core ticker registered while ActivePackJob is running. */
+    FTSTicker::FDelegateHandle PackJobTickerHandle;
+
+    // ========== Batch Queue ==========
+
+    /** Texture sets queued for batch generation. Runs several jobs at once (see FChannelPackBatch). */
+    TSharedPtr<FChannelPackBatch> Batch;
+
+    /** List view showing the items of Batch. */
+    TSharedPtr<SListView<TSharedPtr<FChannelPackBatchItem>>> BatchListView;
+
+    /** Handle of the core ticker registered while Batch is running. */
+    FTSTicker::FDelegateHandle BatchTickerHandle;
+
+    /** Handle of the core ticker registered while the scratch arena holds blocks from finished packs. */
+    FTSTicker::FDelegateHandle ScratchArenaTrimTickerHandle;
 };
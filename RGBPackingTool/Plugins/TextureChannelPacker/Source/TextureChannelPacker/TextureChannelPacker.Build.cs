@@ -22,6 +22,7 @@ public class TextureChannelPacker : ModuleRules
             new string[]
             {
                 "Core",
+                "TextureChannelPackerCore",
                 // ... add other public dependencies that you statically link with here ...
             }
         );
@@ -38,9 +39,13 @@ public class TextureChannelPacker : ModuleRules
                 "ToolMenus",
                 "PropertyEditor",
                 "ImageCore",
+                "ImageWrapper",
+                "Json",
                 "RenderCore",
                 "AssetRegistry",
-                "ContentBrowser"
+                "ContentBrowser",
+                "DesktopPlatform",
+                "DerivedDataCache"
                 // ... add private dependencies that you statically link with here ...
             }
         );
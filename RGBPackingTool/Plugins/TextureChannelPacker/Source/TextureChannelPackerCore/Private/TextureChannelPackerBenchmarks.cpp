@@ -0,0 +1,590 @@
+#include "TextureChannelPackerBenchmarks.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "Math/Float16.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+#include "TextureChannelPackerEngine.h"
+#include "TextureChannelPackerKernels.h"
+
+// Benchmarks for the packing kernels, run from the editor console, e.g.:
+//   TextureChannelPacker.Benchmark.Interleave 8192 8192 10
+//   TextureChannelPacker.Benchmark.Scaling 8192 8192 3
+//   TextureChannelPacker.Benchmark.Suite -Sizes=1024,4096 -Output=Saved/Bench.csv -Baseline=Saved/Baseline.csv
+
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePackerBenchmark, Log, All);
+
+/** Returns the positive integer argument at Index, or Default if it is missing or invalid. */
+static int32 GetBenchmarkIntArg(const TArray<FString>& Args, int32 Index, int32 Default)
+{
+    const int32 Value = Args.IsValidIndex(Index) ? FCString::Atoi(*Args[Index]) : 0;
+    return Value > 0 ? Value : Default;
+}
+
+/** Runs Body once to warm up (page-in, caches), then Iterations times, and returns the fastest run in seconds. */
+template<typename BodyType>
+static double MeasureBestSeconds(int32 Iterations, BodyType&& Body)
+{
+    Body();
+
+    double BestSeconds = TNumericLimits<double>::Max();
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        Body();
+        BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+    }
+    return BestSeconds;
+}
+
+// ---------------------------------------------------------
+// Interleave
+// ---------------------------------------------------------
+
+/**
+ * @brief Compares the planar-to-BGRA8 interleave strategies.
+ *
+ * - Per-pixel: the original loop, one ParallelFor call per pixel writing four scattered bytes.
+ * - Banded scalar: row bands scheduled with ParallelFor, scalar loop inside each band.
+ * - Banded SIMD: row bands scheduled with ParallelFor, InterleavePlanarToBGRA8 inside each band.
+ *
+ * Throughput counts 8 bytes per pixel (4 planar bytes read, 4 interleaved bytes written).
+ */
+static void RunInterleaveBenchmark(const TArray<FString>& Args)
+{
+    const int32 Width = GetBenchmarkIntArg(Args, 0, 8192);
+    const int32 Height = GetBenchmarkIntArg(Args, 1, 8192);
+    const int32 Iterations = GetBenchmarkIntArg(Args, 2, 5);
+    const int64 NumPixels = (int64)Width * Height;
+
+    if (NumPixels > MAX_int32)
+    {
+        UE_LOG(LogTexturePackerBenchmark, Error, TEXT("Interleave benchmark: %d x %d is too large."), Width, Height);
+        return;
+    }
+
+    TArray64<uint8> Planes;
+    Planes.SetNumUninitialized(NumPixels * 4);
+    for (int64 i = 0; i < Planes.Num(); ++i)
+    {
+        Planes[i] = (uint8)(((uint64)i * 2654435761u) >> 13);
+    }
+    const uint8* PtrR = Planes.GetData();
+    const uint8* PtrG = PtrR + NumPixels;
+    const uint8* PtrB = PtrG + NumPixels;
+    const uint8* PtrA = PtrB + NumPixels;
+
+    TArray64<uint8> Output;
+    Output.SetNumUninitialized(NumPixels * 4);
+    uint8* MipData = Output.GetData();
+
+    const int32 NumBands = FMath::DivideAndRoundUp(Height, ChannelPackBandHeight);
+
+    const double PerPixelSeconds = MeasureBestSeconds(Iterations, [=]()
+    {
+        ParallelFor((int32)NumPixels, [MipData, PtrR, PtrG, PtrB, PtrA](int32 i)
+        {
+            int32 Offset = i * 4;
+            MipData[Offset + 0] = PtrB[i]; // B
+            MipData[Offset + 1] = PtrG[i]; // G
+            MipData[Offset + 2] = PtrR[i]; // R
+            MipData[Offset + 3] = PtrA[i]; // A
+        });
+    });
+
+    auto RunBanded = [=](bool bUseSimd)
+    {
+        ParallelFor(NumBands, [=](int32 BandIndex)
+        {
+            const int64 Begin = (int64)BandIndex * ChannelPackBandHeight * Width;
+            const int64 End = FMath::Min<int64>(Begin + (int64)ChannelPackBandHeight * Width, NumPixels);
+            if (bUseSimd)
+            {
+                InterleavePlanarToBGRA8(PtrR + Begin, PtrG + Begin, PtrB + Begin, PtrA + Begin, MipData + Begin * 4, End - Begin);
+            }
+            else
+            {
+                InterleavePlanarToBGRA8Scalar(PtrR + Begin, PtrG + Begin, PtrB + Begin, PtrA + Begin, MipData + Begin * 4, End - Begin);
+            }
+        });
+    };
+
+    const double BandedScalarSeconds = MeasureBestSeconds(Iterations, [&RunBanded]() { RunBanded(false); });
+    const double BandedSimdSeconds = MeasureBestSeconds(Iterations, [&RunBanded]() { RunBanded(true); });
+
+    const double GigaBytes = (double)NumPixels * 8.0 / 1.0e9;
+    UE_LOG(LogTexturePackerBenchmark, Display, TEXT("Interleave benchmark: %d x %d, best of %d, SIMD: %s"), Width, Height, Iterations, GetChannelPackerSimdName());
+    UE_LOG(LogTexturePackerBenchmark, Display, TEXT("  Per-pixel ParallelFor : %8.2f ms  %6.2f GB/s"), PerPixelSeconds * 1000.0, GigaBytes / PerPixelSeconds);
+    UE_LOG(LogTexturePackerBenchmark, Display, TEXT("  Banded scalar         : %8.2f ms  %6.2f GB/s"), BandedScalarSeconds * 1000.0, GigaBytes / BandedScalarSeconds);
+    UE_LOG(LogTexturePackerBenchmark, Display, TEXT("  Banded SIMD           : %8.2f ms  %6.2f GB/s  (%.1fx vs per-pixel)"), BandedSimdSeconds * 1000.0, GigaBytes / BandedSimdSeconds, PerPixelSeconds / BandedSimdSeconds);
+}
+
+static FAutoConsoleCommand GInterleaveBenchmarkCommand(
+    TEXT("TextureChannelPacker.Benchmark.Interleave"),
+    TEXT("Measures planar-to-BGRA8 interleave throughput. Usage: TextureChannelPacker.Benchmark.Interleave [Width=8192] [Height=8192] [Iterations=5]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&RunInterleaveBenchmark));
+
+// ---------------------------------------------------------
+// Thread Scaling
+// ---------------------------------------------------------
+
+/**
+ * @brief Measures how PackChannelsToBGRA8 scales from 1 to N threads.
+ *
+ * The pack has only two inputs, which is the case the old ParallelFor(4) over channels could not
+ * spread across cores: an R32F channel at twice the output size (downscaled with the Bilinear filter)
+ * and a G8 channel at the output size. Thread counts are powers of two up to GetChannelPackMaxThreads(),
+ * plus that maximum itself.
+ */
+static void RunScalingBenchmark(const TArray<FString>& Args)
+{
+    const int32 Width = GetBenchmarkIntArg(Args, 0, 8192);
+    const int32 Height = GetBenchmarkIntArg(Args, 1, 8192);
+    const int32 Iterations = GetBenchmarkIntArg(Args, 2, 3);
+    const int32 SrcWidth = Width * 2;
+    const int32 SrcHeight = Height * 2;
+
+    if ((int64)SrcWidth * SrcHeight > MAX_int32)
+    {
+        UE_LOG(LogTexturePackerBenchmark, Error, TEXT("Scaling benchmark: %d x %d is too large."), Width, Height);
+        return;
+    }
+
+    TArray64<float> FloatSource;
+    FloatSource.SetNumUninitialized((int64)SrcWidth * SrcHeight);
+    for (int64 i = 0; i < FloatSource.Num(); ++i)
+    {
+        FloatSource[i] = (float)((((uint64)i * 2654435761u) >> 13) & 0xFFFF) / 65535.0f;
+    }
+
+    TArray64<uint8> ByteSource;
+    ByteSource.SetNumUninitialized((int64)Width * Height);
+    for (int64 i = 0; i < ByteSource.Num(); ++i)
+    {
+        ByteSource[i] = (uint8)(((uint64)i * 2654435761u) >> 13);
+    }
+
+    FChannelPackDesc Channels[4];
+    Channels[0].Source.Data = (const uint8*)FloatSource.GetData();
+    Channels[0].Source.Width = SrcWidth;
+    Channels[0].Source.Height = SrcHeight;
+    Channels[0].Source.Format = EChannelPackSourceFormat::R32F;
+    Channels[1].Source.Data = ByteSource.GetData();
+    Channels[1].Source.Width = Width;
+    Channels[1].Source.Height = Height;
+    Channels[1].Source.Format = EChannelPackSourceFormat::G8;
+    Channels[3].DefaultValue = 255;
+
+    TArray64<uint8> Output;
+    Output.SetNumUninitialized((int64)Width * Height * 4);
+
+    const int32 MaxThreads = GetChannelPackMaxThreads();
+    TArray<int32> ThreadCounts;
+    for (int32 Threads = 1; Threads < MaxThreads; Threads *= 2)
+    {
+        ThreadCounts.Add(Threads);
+    }
+    ThreadCounts.Add(MaxThreads);
+
+    UE_LOG(LogTexturePackerBenchmark, Display, TEXT("Scaling benchmark: %d x %d output (R32F %d x %d + G8), best of %d, SIMD: %s"),
+        Width, Height, SrcWidth, SrcHeight, Iterations, GetChannelPackerSimdName());
+
+    double SingleThreadSeconds = 0.0;
+    for (const int32 Threads : ThreadCounts)
+    {
+        const double Seconds = MeasureBestSeconds(Iterations, [&Channels, &Output, Width, Height, Threads]()
+        {
+            PackChannelsToBGRA8(Channels, Width, Height, ETextureResizeFilter::Bilinear, Output.GetData(), Threads);
+        });
+
+        if (Threads == 1)
+        {
+            SingleThreadSeconds = Seconds;
+        }
+
+        const double Speedup = SingleThreadSeconds / Seconds;
+        UE_LOG(LogTexturePackerBenchmark, Display, TEXT("  %3d thread(s) : %8.2f ms  %5.2fx  %5.1f%% efficiency"),
+            Threads, Seconds * 1000.0, Speedup, Speedup / Threads * 100.0);
+    }
+}
+
+static FAutoConsoleCommand GScalingBenchmarkCommand(
+    TEXT("TextureChannelPacker.Benchmark.Scaling"),
+    TEXT("Measures packing time from 1 to N threads. Usage: TextureChannelPacker.Benchmark.Scaling [Width=8192] [Height=8192] [Iterations=3]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&RunScalingBenchmark));
+
+// ---------------------------------------------------------------------------
+// Suite
+// ---------------------------------------------------------------------------
+
+static const EChannelPackSourceFormat BenchmarkFormats[] =
+{
+    EChannelPackSourceFormat::G8,
+    EChannelPackSourceFormat::G16,
+    EChannelPackSourceFormat::BGRA8,
+    EChannelPackSourceFormat::R16F,
+    EChannelPackSourceFormat::R32F,
+    EChannelPackSourceFormat::RGBA32F,
+};
+
+enum class EBenchmarkPath : uint8
+{
+    SameSize,
+    Resize,
+    Invert,
+    Missing,
+    TwoInputs,  // Red and green from one input, blue and alpha from a second one, packed in one pass
+    Pipelined,  // The same inputs packed as a pipelined job does: one stage per input, the later one interleaving
+};
+
+static const EBenchmarkPath BenchmarkPaths[] = { EBenchmarkPath::SameSize, EBenchmarkPath::Resize, EBenchmarkPath::Invert, EBenchmarkPath::Missing, EBenchmarkPath::TwoInputs, EBenchmarkPath::Pipelined };
+
+static const TCHAR* GetBenchmarkPathName(EBenchmarkPath Path)
+{
+    switch (Path)
+    {
+    case EBenchmarkPath::SameSize: return TEXT("SameSize");
+    case EBenchmarkPath::Resize:   return TEXT("Resize");
+    case EBenchmarkPath::Invert:   return TEXT("Invert");
+    case EBenchmarkPath::Missing:  return TEXT("Missing");
+    case EBenchmarkPath::TwoInputs: return TEXT("TwoInputs");
+    case EBenchmarkPath::Pipelined: return TEXT("Pipelined");
+    default:                       return TEXT("Unknown");
+    }
+}
+
+/** Fills a source with deterministic noise over the [0, 1] range of its format. */
+static void FillBenchmarkSource(EChannelPackSourceFormat Format, TArray64<uint8>& Data)
+{
+    auto Noise = [](int64 Index) { return (uint32)(((uint64)Index * 2654435761u) >> 13); };
+
+    switch (Format)
+    {
+    case EChannelPackSourceFormat::R16F:
+    {
+        uint16* Halves = (uint16*)Data.GetData();
+        for (int64 i = 0; i < Data.Num() / 2; ++i)
+        {
+            const FFloat16 Half((float)(Noise(i) & 0xFFFF) / 65535.0f);
+            Halves[i] = Half.Encoded;
+        }
+        break;
+    }
+    case EChannelPackSourceFormat::R32F:
+    case EChannelPackSourceFormat::RGBA32F:
+    {
+        float* Floats = (float*)Data.GetData();
+        for (int64 i = 0; i < Data.Num() / 4; ++i)
+        {
+            Floats[i] = (float)(Noise(i) & 0xFFFF) / 65535.0f;
+        }
+        break;
+    }
+    default:
+        for (int64 i = 0; i < Data.Num(); ++i)
+        {
+            Data[i] = (uint8)Noise(i);
+        }
+        break;
+    }
+}
+
+/**
+ * Runs Pack once to warm up, then Iterations times, each with a fresh FChannelPackControl counting toward
+ * the case's own memory tracker, which also holds the source and output buffers. Records the time and
+ * stage cycles of the fastest run and the tracker's high-water mark in Result.
+ */
+template<typename PackType>
+static void MeasureBenchmarkCase(int32 Iterations, FChannelPackBenchmarkResult& Result, int64 SourceBytes, int64 OutputBytes, PackType&& Pack)
+{
+    FChannelPackMemoryTracker CaseMemory;
+    const FChannelPackMemoryCharge SourceCharge(SourceBytes, CaseMemory);
+    const FChannelPackMemoryCharge OutputCharge(OutputBytes, CaseMemory);
+
+    Result.Seconds = TNumericLimits<double>::Max();
+    for (int32 Iteration = 0; Iteration <= Iterations; ++Iteration)
+    {
+        FChannelPackControl Control;
+        Control.Memory = &CaseMemory;
+
+        const double StartTime = FPlatformTime::Seconds();
+        Pack(Control);
+        const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+        if (Iteration > 0 && Seconds < Result.Seconds)
+        {
+            Result.Seconds = Seconds;
+            Result.ConvertSeconds = FPlatformTime::ToSeconds64(Control.ConvertCycles.load(std::memory_order_relaxed));
+            Result.ResizeSeconds = FPlatformTime::ToSeconds64(Control.ResizeCycles.load(std::memory_order_relaxed));
+            Result.InterleaveSeconds = FPlatformTime::ToSeconds64(Control.InterleaveCycles.load(std::memory_order_relaxed));
+        }
+    }
+    Result.PeakTrackedBytes = CaseMemory.GetPeakBytes();
+}
+
+/** Reads the Case and MPixelsPerSecond columns of a results CSV written by the suite. */
+static bool LoadBenchmarkBaseline(const FString& Path, TMap<FString, double>& OutBaseline, FString& OutError)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *Path) || Lines.Num() == 0)
+    {
+        OutError = FString::Printf(TEXT("Could not read the baseline %s."), *Path);
+        return false;
+    }
+
+    TArray<FString> Header;
+    Lines[0].ParseIntoArray(Header, TEXT(","), false);
+    const int32 CaseColumn = Header.IndexOfByKey(TEXT("Case"));
+    const int32 ThroughputColumn = Header.IndexOfByKey(TEXT("MPixelsPerSecond"));
+    if (CaseColumn == INDEX_NONE || ThroughputColumn == INDEX_NONE)
+    {
+        OutError = FString::Printf(TEXT("The baseline %s is not a benchmark suite CSV (Case and MPixelsPerSecond columns)."), *Path);
+        return false;
+    }
+
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        TArray<FString> Fields;
+        Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+        if (Fields.IsValidIndex(CaseColumn) && Fields.IsValidIndex(ThroughputColumn))
+        {
+            OutBaseline.Add(Fields[CaseColumn], FCString::Atod(*Fields[ThroughputColumn]));
+        }
+    }
+    return true;
+}
+
+static FString FormatBenchmarkResultsCsv(const TArray<FChannelPackBenchmarkResult>& Results)
+{
+    FString Text = TEXT("Case,Format,Path,Width,Height,Seconds,ConvertSeconds,ResizeSeconds,InterleaveSeconds,MPixelsPerSecond,PeakTrackedMB,BaselineMPixelsPerSecond,Regressed\n");
+    for (const FChannelPackBenchmarkResult& Result : Results)
+    {
+        Text += FString::Printf(TEXT("%s,%s,%s,%d,%d,%.6f,%.6f,%.6f,%.6f,%.2f,%.2f,%.2f,%d\n"),
+            *Result.Case, GetChannelPackSourceFormatName(Result.Format), *Result.Path, Result.Width, Result.Height,
+            Result.Seconds, Result.ConvertSeconds, Result.ResizeSeconds, Result.InterleaveSeconds, Result.MegapixelsPerSecond,
+            Result.PeakTrackedBytes / (1024.0 * 1024.0), Result.BaselineMegapixelsPerSecond, Result.bRegressed ? 1 : 0);
+    }
+    return Text;
+}
+
+static FString FormatBenchmarkResultsJson(const TArray<FChannelPackBenchmarkResult>& Results)
+{
+    FString Text = FString::Printf(TEXT("{\n  \"Simd\": \"%s\",\n  \"Threads\": %d,\n  \"Results\": [\n"),
+        GetChannelPackerSimdName(), GetChannelPackMaxThreads());
+    for (int32 Index = 0; Index < Results.Num(); ++Index)
+    {
+        const FChannelPackBenchmarkResult& Result = Results[Index];
+        Text += FString::Printf(TEXT("    { \"Case\": \"%s\", \"Format\": \"%s\", \"Path\": \"%s\", \"Width\": %d, \"Height\": %d, ")
+            TEXT("\"Seconds\": %.6f, \"ConvertSeconds\": %.6f, \"ResizeSeconds\": %.6f, \"InterleaveSeconds\": %.6f, ")
+            TEXT("\"MPixelsPerSecond\": %.2f, \"PeakTrackedMB\": %.2f, \"BaselineMPixelsPerSecond\": %.2f, \"Regressed\": %s }%s\n"),
+            *Result.Case, GetChannelPackSourceFormatName(Result.Format), *Result.Path, Result.Width, Result.Height,
+            Result.Seconds, Result.ConvertSeconds, Result.ResizeSeconds, Result.InterleaveSeconds, Result.MegapixelsPerSecond,
+            Result.PeakTrackedBytes / (1024.0 * 1024.0), Result.BaselineMegapixelsPerSecond, Result.bRegressed ? TEXT("true") : TEXT("false"), Index + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+    }
+    Text += TEXT("  ]\n}\n");
+    return Text;
+}
+
+bool ParseChannelPackBenchmarkSuiteSettings(const TCHAR* Params, FChannelPackBenchmarkSuiteSettings& OutSettings, FString& OutError)
+{
+    FString SizesText;
+    if (FParse::Value(Params, TEXT("Sizes="), SizesText, false))
+    {
+        TArray<FString> Entries;
+        SizesText.ParseIntoArray(Entries, TEXT(","));
+        OutSettings.Sizes.Reset();
+        for (const FString& Entry : Entries)
+        {
+            FString WidthText = Entry;
+            FString HeightText = Entry;
+            Entry.Split(TEXT("x"), &WidthText, &HeightText, ESearchCase::IgnoreCase);
+
+            const int32 Width = FCString::Atoi(*WidthText);
+            const int32 Height = FCString::Atoi(*HeightText);
+            if (Width <= 0 || Height <= 0)
+            {
+                OutError = FString::Printf(TEXT("Invalid benchmark size '%s'."), *Entry);
+                return false;
+            }
+            OutSettings.Sizes.Add(FIntPoint(Width, Height));
+        }
+    }
+
+    int32 Iterations = 0;
+    if (FParse::Value(Params, TEXT("Iterations="), Iterations))
+    {
+        if (Iterations <= 0)
+        {
+            OutError = TEXT("-Iterations must be at least 1.");
+            return false;
+        }
+        OutSettings.Iterations = Iterations;
+    }
+
+    double Threshold = 0.0;
+    if (FParse::Value(Params, TEXT("Threshold="), Threshold))
+    {
+        if (Threshold < 0.0 || Threshold >= 100.0)
+        {
+            OutError = TEXT("-Threshold must be a percentage from 0 to 100.");
+            return false;
+        }
+        OutSettings.RegressionThresholdPercent = Threshold;
+    }
+
+    FParse::Value(Params, TEXT("Output="), OutSettings.OutputPath);
+    FParse::Value(Params, TEXT("Baseline="), OutSettings.BaselinePath);
+    return true;
+}
+
+bool RunChannelPackBenchmarkSuite(const FChannelPackBenchmarkSuiteSettings& Settings, TArray<FChannelPackBenchmarkResult>& OutResults, FString& OutError)
+{
+    OutResults.Reset();
+
+    TMap<FString, double> Baseline;
+    if (!Settings.BaselinePath.IsEmpty() && !LoadBenchmarkBaseline(Settings.BaselinePath, Baseline, OutError))
+    {
+        return false;
+    }
+
+    TArray<FIntPoint> Sizes = Settings.Sizes;
+    if (Sizes.Num() == 0)
+    {
+        Sizes = { FIntPoint(256, 256), FIntPoint(1024, 1024), FIntPoint(2048, 2048), FIntPoint(4096, 4096), FIntPoint(8192, 8192), FIntPoint(2048, 512), FIntPoint(512, 2048) };
+    }
+    const int32 Iterations = FMath::Max(1, Settings.Iterations);
+
+    UE_LOG(LogTexturePackerBenchmark, Display, TEXT("Benchmark suite: %d size(s) x %d format(s) x %d path(s), best of %d, SIMD: %s"),
+        Sizes.Num(), (int32)UE_ARRAY_COUNT(BenchmarkFormats), (int32)UE_ARRAY_COUNT(BenchmarkPaths), Iterations, GetChannelPackerSimdName());
+
+    int32 NumRegressed = 0;
+    TArray64<uint8> Source;
+    TArray64<uint8> SecondSource;
+    TArray64<uint8> Output;
+    for (const FIntPoint& Size : Sizes)
+    {
+        for (const EChannelPackSourceFormat Format : BenchmarkFormats)
+        {
+            Source.SetNumUninitialized((int64)Size.X * Size.Y * GetChannelPackSourceBytesPerPixel(Format));
+            FillBenchmarkSource(Format, Source);
+            SecondSource.Empty();
+
+            for (const EBenchmarkPath Path : BenchmarkPaths)
+            {
+                const int32 OutWidth = Path == EBenchmarkPath::Resize ? FMath::Max(1, Size.X / 2) : Size.X;
+                const int32 OutHeight = Path == EBenchmarkPath::Resize ? FMath::Max(1, Size.Y / 2) : Size.Y;
+                const bool bTwoInputs = Path == EBenchmarkPath::TwoInputs || Path == EBenchmarkPath::Pipelined;
+                if (bTwoInputs && SecondSource.Num() == 0)
+                {
+                    SecondSource = Source;
+                }
+
+                FChannelPackDesc Channels[4];
+                Channels[3].DefaultValue = 255;
+                for (int32 Slot = 0; Slot < 4; ++Slot)
+                {
+                    if (Path == EBenchmarkPath::Missing && Slot > 0)
+                    {
+                        continue;
+                    }
+                    Channels[Slot].Source.Data = bTwoInputs && Slot >= 2 ? SecondSource.GetData() : Source.GetData();
+                    Channels[Slot].Source.Width = Size.X;
+                    Channels[Slot].Source.Height = Size.Y;
+                    Channels[Slot].Source.Format = Format;
+                    Channels[Slot].SourceChannel = (ETextureSourceChannel)Slot;
+                    Channels[Slot].bInvert = Path == EBenchmarkPath::Invert;
+                }
+
+                Output.SetNumUninitialized((int64)OutWidth * OutHeight * 4);
+
+                FChannelPackBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+                Result.Case = FString::Printf(TEXT("%s_%s_%dx%d"), GetChannelPackSourceFormatName(Format), GetBenchmarkPathName(Path), Size.X, Size.Y);
+                Result.Format = Format;
+                Result.Path = GetBenchmarkPathName(Path);
+                Result.Width = Size.X;
+                Result.Height = Size.Y;
+                MeasureBenchmarkCase(Iterations, Result, Source.Num() * (bTwoInputs ? 2 : 1), Output.Num(), [&Channels, &Output, OutWidth, OutHeight, Path](FChannelPackControl& Control)
+                {
+                    if (Path != EBenchmarkPath::Pipelined)
+                    {
+                        PackChannelsToBGRA8(Channels, OutWidth, OutHeight, ETextureResizeFilter::Bilinear, Output.GetData(), 0, &Control);
+                        return;
+                    }
+
+                    // The stage of the first input (R and G), then the stage of the second one (B and A),
+                    // which interleaves every band
+                    FChannelPackStagedPack StagedPack(OutWidth, OutHeight, ETextureResizeFilter::Bilinear, Output.GetData(), 2);
+                    for (int32 Stage = 0; Stage < 2; ++Stage)
+                    {
+                        FChannelPackDesc StageChannels[4];
+                        for (int32 Slot = 0; Slot < 4; ++Slot)
+                        {
+                            StageChannels[Slot] = Slot / 2 == Stage ? Channels[Slot] : FChannelPackDesc();
+                            StageChannels[Slot].bPreserveOutput = Slot / 2 != Stage;
+                        }
+                        if (!StagedPack.PackStage(StageChannels, 0, &Control))
+                        {
+                            return;
+                        }
+                    }
+                });
+                Result.MegapixelsPerSecond = (double)Size.X * Size.Y / 1.0e6 / FMath::Max(Result.Seconds, 1.0e-9);
+
+                FString Comparison;
+                if (const double* BaselineThroughput = Baseline.Find(Result.Case))
+                {
+                    Result.BaselineMegapixelsPerSecond = *BaselineThroughput;
+                    Result.bRegressed = Result.MegapixelsPerSecond < *BaselineThroughput * (1.0 - Settings.RegressionThresholdPercent / 100.0);
+                    NumRegressed += Result.bRegressed ? 1 : 0;
+                    Comparison = FString::Printf(TEXT("  %+6.1f%% vs baseline%s"),
+                        (Result.MegapixelsPerSecond / FMath::Max(*BaselineThroughput, 1.0e-9) - 1.0) * 100.0, Result.bRegressed ? TEXT("  REGRESSED") : TEXT(""));
+                }
+
+                UE_LOG(LogTexturePackerBenchmark, Display, TEXT("  %-28s : %9.2f ms  %9.1f MP/s  convert %8.2f ms  resize %8.2f ms  interleave %8.2f ms  peak %8.1f MiB%s"),
+                    *Result.Case, Result.Seconds * 1000.0, Result.MegapixelsPerSecond, Result.ConvertSeconds * 1000.0, Result.ResizeSeconds * 1000.0,
+                    Result.InterleaveSeconds * 1000.0, Result.PeakTrackedBytes / (1024.0 * 1024.0), *Comparison);
+            }
+        }
+    }
+
+    if (!Settings.OutputPath.IsEmpty())
+    {
+        const bool bJson = FPaths::GetExtension(Settings.OutputPath).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+        const FString Text = bJson ? FormatBenchmarkResultsJson(OutResults) : FormatBenchmarkResultsCsv(OutResults);
+        if (!FFileHelper::SaveStringToFile(Text, *Settings.OutputPath))
+        {
+            OutError = FString::Printf(TEXT("Could not write the results to %s."), *Settings.OutputPath);
+            return false;
+        }
+        UE_LOG(LogTexturePackerBenchmark, Display, TEXT("Benchmark suite: results written to %s"), *Settings.OutputPath);
+    }
+
+    if (NumRegressed > 0)
+    {
+        OutError = FString::Printf(TEXT("%d of %d case(s) are more than %.1f%% slower than the baseline."),
+            NumRegressed, OutResults.Num(), Settings.RegressionThresholdPercent);
+        return false;
+    }
+    return true;
+}
+
+static void RunSuiteBenchmark(const TArray<FString>& Args)
+{
+    FChannelPackBenchmarkSuiteSettings Settings;
+    FString Error;
+    TArray<FChannelPackBenchmarkResult> Results;
+    if (!ParseChannelPackBenchmarkSuiteSettings(*FString::Join(Args, TEXT(" ")), Settings, Error)
+        || !RunChannelPackBenchmarkSuite(Settings, Results, Error))
+    {
+        UE_LOG(LogTexturePackerBenchmark, Error, TEXT("Benchmark suite failed: %s"), *Error);
+        return;
+    }
+    UE_LOG(LogTexturePackerBenchmark, Display, TEXT("Benchmark suite: %d case(s) passed."), Results.Num());
+}
+
+static FAutoConsoleCommand GSuiteBenchmarkCommand(
+    TEXT("TextureChannelPacker.Benchmark.Suite"),
+    TEXT("Packs synthetic sources of every format through the same-size, resize, invert and missing-channel paths. Usage: TextureChannelPacker.Benchmark.Suite [-Sizes=256,1024,2048x512] [-Iterations=3] [-Output=Results.csv|.json] [-Baseline=Baseline.csv] [-Threshold=10]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&RunSuiteBenchmark));
@@ -0,0 +1,987 @@
+#include "TextureChannelPackerEngine.h"
+#include "TextureChannelPackerKernels.h"
+#include "TextureChannelPackerResampler.h"
+#include "TextureChannelPackerStats.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Math/UnrealMathUtility.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pack"), STAT_ChannelPack_Pack, STATGROUP_TextureChannelPacker);
+DECLARE_CYCLE_STAT(TEXT("Uniform Scan"), STAT_ChannelPack_UniformScan, STATGROUP_TextureChannelPacker);
+DECLARE_CYCLE_STAT(TEXT("Convert"), STAT_ChannelPack_Convert, STATGROUP_TextureChannelPacker);
+DECLARE_CYCLE_STAT(TEXT("Resize"), STAT_ChannelPack_Resize, STATGROUP_TextureChannelPacker);
+DECLARE_CYCLE_STAT(TEXT("Interleave"), STAT_ChannelPack_Interleave, STATGROUP_TextureChannelPacker);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Packs"), STAT_ChannelPack_Packs, STATGROUP_TextureChannelPacker);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Source MB Read"), STAT_ChannelPack_SourceMBRead, STATGROUP_TextureChannelPacker);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Output MB Written"), STAT_ChannelPack_OutputMBWritten, STATGROUP_TextureChannelPacker);
+
+// ---------------------------------------------------------
+// Source Format Traits
+// ---------------------------------------------------------
+// Each traits struct describes one source format: its texel layout and how a whole row is converted
+// with the vectorized kernels in TextureChannelPackerKernels.cpp. Out is indexed by
+// ETextureSourceChannel and only the requested planes are non-null; single-channel formats only ever
+// write the Red plane. ToBytes() produces the 8-bit values used when no resize is needed; ToFloats()
+// produces 0-255 floats for the resampler. ChannelOffsets and ChannelSizes give the bytes of a texel
+// each source channel is computed from. Every per-format kernel of the engine is instantiated from
+// these structs (see ChannelPackFormats), so a new format needs one struct and one table entry.
+
+/** Layout shared by the single-channel formats: every source channel reads the whole texel. */
+template<int32 InBytesPerPixel>
+struct TSingleChannelFormat
+{
+    static constexpr int32 BytesPerPixel = InBytesPerPixel;
+    static constexpr bool bSingleChannel = true;
+    static constexpr int32 ChannelOffsets[ChannelPackNumSourceChannels] = { 0, 0, 0, 0, 0 };
+    static constexpr int32 ChannelSizes[ChannelPackNumSourceChannels] = { InBytesPerPixel, InBytesPerPixel, InBytesPerPixel, InBytesPerPixel, InBytesPerPixel };
+};
+
+struct FFormatG8 : TSingleChannelFormat<1>
+{
+    static constexpr EChannelPackSourceFormat Format = EChannelPackSourceFormat::G8;
+    static void ToBytes(const uint8* Row, uint8* const Out[ChannelPackNumSourceChannels], int32 Num) { FMemory::Memcpy(Out[0], Row, Num); }
+    static void ToFloats(const uint8* Row, float* const Out[ChannelPackNumSourceChannels], int32 Num) { ConvertBytesToFloats(Row, Out[0], Num); }
+};
+
+struct FFormatBGRA8
+{
+    static constexpr EChannelPackSourceFormat Format = EChannelPackSourceFormat::BGRA8;
+    static constexpr int32 BytesPerPixel = 4;
+    static constexpr bool bSingleChannel = false;
+    static constexpr int32 ChannelOffsets[ChannelPackNumSourceChannels] = { 2, 1, 0, 3, 0 };
+    static constexpr int32 ChannelSizes[ChannelPackNumSourceChannels] = { 1, 1, 1, 1, 3 };
+    static void ToBytes(const uint8* Row, uint8* const Out[ChannelPackNumSourceChannels], int32 Num) { DeinterleaveBGRA8ToBytes(Row, Out, Num); }
+    static void ToFloats(const uint8* Row, float* const Out[ChannelPackNumSourceChannels], int32 Num) { DeinterleaveBGRA8ToFloats(Row, Out, Num); }
+};
+
+struct FFormatG16 : TSingleChannelFormat<2>
+{
+    static constexpr EChannelPackSourceFormat Format = EChannelPackSourceFormat::G16;
+    static void ToBytes(const uint8* Row, uint8* const Out[ChannelPackNumSourceChannels], int32 Num) { ConvertG16ToBytes((const uint16*)Row, Out[0], Num); }
+    static void ToFloats(const uint8* Row, float* const Out[ChannelPackNumSourceChannels], int32 Num) { ConvertG16ToFloats((const uint16*)Row, Out[0], Num); }
+};
+
+struct FFormatR16F : TSingleChannelFormat<2>
+{
+    static constexpr EChannelPackSourceFormat Format = EChannelPackSourceFormat::R16F;
+    static void ToBytes(const uint8* Row, uint8* const Out[ChannelPackNumSourceChannels], int32 Num) { ConvertHalfToBytes((const uint16*)Row, Out[0], Num); }
+    static void ToFloats(const uint8* Row, float* const Out[ChannelPackNumSourceChannels], int32 Num) { ConvertHalfToFloats((const uint16*)Row, Out[0], Num); }
+};
+
+struct FFormatR32F : TSingleChannelFormat<4>
+{
+    static constexpr EChannelPackSourceFormat Format = EChannelPackSourceFormat::R32F;
+    static void ToBytes(const uint8* Row, uint8* const Out[ChannelPackNumSourceChannels], int32 Num) { ConvertFloatToBytes((const float*)Row, Out[0], Num); }
+    static void ToFloats(const uint8* Row, float* const Out[ChannelPackNumSourceChannels], int32 Num) { ConvertFloatToFloats((const float*)Row, Out[0], Num); }
+};
+
+struct FFormatRGBA32F
+{
+    static constexpr EChannelPackSourceFormat Format = EChannelPackSourceFormat::RGBA32F;
+    static constexpr int32 BytesPerPixel = 16;
+    static constexpr bool bSingleChannel = false;
+    static constexpr int32 ChannelOffsets[ChannelPackNumSourceChannels] = { 0, 4, 8, 12, 0 };
+    static constexpr int32 ChannelSizes[ChannelPackNumSourceChannels] = { 4, 4, 4, 4, 12 };
+    static void ToBytes(const uint8* Row, uint8* const Out[ChannelPackNumSourceChannels], int32 Num) { DeinterleaveRGBA32FToBytes((const float*)Row, Out, Num); }
+    static void ToFloats(const uint8* Row, float* const Out[ChannelPackNumSourceChannels], int32 Num) { DeinterleaveRGBA32FToFloats((const float*)Row, Out, Num); }
+};
+
+/** @return true if both views read the same pixels (same data pointer, size and format). */
+static bool IsSameChannelPackSource(const FChannelPackSource& A, const FChannelPackSource& B)
+{
+    return A.Data == B.Data && A.Width == B.Width && A.Height == B.Height && A.Format == B.Format;
+}
+
+class FSourceBandProducer;
+
+/** State of the band being written: where its scratch is counted and the CPU time of its stages. */
+struct FChannelPackBandContext
+{
+    /** Counts the band's scratch buffers. */
+    FChannelPackMemoryTracker* Memory = nullptr;
+
+    /** CPU time of each stage in FPlatformTime cycles, added to FChannelPackControl once the band is written. */
+    uint64 ConvertCycles = 0;
+    uint64 ResizeCycles = 0;
+    uint64 InterleaveCycles = 0;
+};
+
+/**
+ * @struct FChannelPackFormatKernels
+ * @brief The layout and kernels of one source format, instantiated from its traits struct.
+ *
+ * Looked up once per source and pack, so band workers call code compiled for a single format
+ * instead of switching on the format for every band.
+ */
+struct FChannelPackFormatKernels
+{
+    EChannelPackSourceFormat Format;
+    int32 BytesPerPixel;
+    bool bSingleChannel;
+    const int32* ChannelOffsets;
+    const int32* ChannelSizes;
+
+    /** FSourceBandProducer::ProduceBandTyped for this format. */
+    void (FSourceBandProducer::*ProduceBand)(int32 BeginY, int32 EndY, uint8* const OutPlanes[ChannelPackNumSourceChannels], FChannelPackBandContext& Band) const;
+
+    /**
+     * Converts one channel of one texel to 8 bits exactly like a band of identical texels would be (with
+     * or without resizing). Returns false if a band could round it either way (ConvertTexelTyped).
+     */
+    bool (*ConvertTexel)(const uint8* Texel, ETextureSourceChannel Channel, bool bResize, uint8& OutValue);
+};
+
+/** @return the kernels of Format, or null if the format is not supported. */
+static const FChannelPackFormatKernels* FindChannelPackFormatKernels(EChannelPackSourceFormat Format);
+
+// ---------------------------------------------------------
+// Source Band Producer
+// ---------------------------------------------------------
+
+/**
+ * @class FSourceBandProducer
+ * @brief Produces a band of output rows for every channel read from one source (convert, deinterleave and resize in one step).
+ *
+ * Each source row touched by the band is read once and split into all requested channels.
+ * Resizing is separable: every converted row is filtered horizontally once, then scattered into
+ * per-row float accumulators with its vertical weights. Scratch memory is therefore bounded by
+ * the band height, not by the resize ratio.
+ *
+ * Instances are built once per pack on the calling thread and are read-only afterwards,
+ * so a single producer can be shared by all band workers.
+ */
+class FSourceBandProducer
+{
+public:
+    void Init(const FChannelPackSource& InSource, int32 InDstWidth, int32 InDstHeight, ETextureResizeFilter Filter)
+    {
+        Source = InSource;
+        DstWidth = InDstWidth;
+        Kernels = FindChannelPackFormatKernels(Source.Format);
+        check(Kernels);
+
+        bResize = Source.Width != InDstWidth || Source.Height != InDstHeight;
+        if (bResize)
+        {
+            AxisX.Build(Source.Width, InDstWidth, Filter);
+            AxisY.Build(Source.Height, InDstHeight, Filter);
+        }
+    }
+
+    /** @return true if this producer reads exactly these pixels (same data pointer, size and format). */
+    bool Reads(const FChannelPackSource& Other) const
+    {
+        return IsSameChannelPackSource(Source, Other);
+    }
+
+    /** @return The size of the source in bytes; every band together reads all of it. */
+    int64 GetSourceBytes() const
+    {
+        return (int64)Source.Width * Source.Height * Kernels->BytesPerPixel;
+    }
+
+    /** Requests one more channel of the source. */
+    void AddChannel(ETextureSourceChannel Channel)
+    {
+        if (!bChannels[(int32)Channel])
+        {
+            bChannels[(int32)Channel] = true;
+            ++NumChannels;
+        }
+    }
+
+    /**
+     * @brief Writes rows [BeginY, EndY) of every requested channel to OutPlanes (indexed by
+     * ETextureSourceChannel, row stride = output width), before inversion. Adds the time spent to Band.
+     */
+    void ProduceBand(int32 BeginY, int32 EndY, uint8* const OutPlanes[ChannelPackNumSourceChannels], FChannelPackBandContext& Band) const
+    {
+        (this->*Kernels->ProduceBand)(BeginY, EndY, OutPlanes, Band);
+    }
+
+    /** ProduceBand for one format. Only called through the format's FChannelPackFormatKernels. */
+    template<typename FormatType>
+    void ProduceBandTyped(int32 BeginY, int32 EndY, uint8* const OutPlanes[ChannelPackNumSourceChannels], FChannelPackBandContext& Band) const
+    {
+        const int64 RowBytes = (int64)Source.Width * FormatType::BytesPerPixel;
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+
+        if (!bResize)
+        {
+            CHANNEL_PACK_STAGE_SCOPE("Convert", STAT_ChannelPack_Convert);
+            uint8* RowPlanes[ChannelPackNumSourceChannels];
+            for (int32 Y = BeginY; Y < EndY; ++Y)
+            {
+                for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+                {
+                    RowPlanes[Channel] = OutPlanes[Channel] ? OutPlanes[Channel] + (Y - BeginY) * DstWidth : nullptr;
+                }
+                FormatType::ToBytes(Source.Data + Y * RowBytes, RowPlanes, DstWidth);
+            }
+            Band.ConvertCycles += FPlatformTime::Cycles64() - StartCycles;
+            return;
+        }
+
+        CHANNEL_PACK_STAGE_SCOPE("Resize", STAT_ChannelPack_Resize);
+        uint64 ConvertCycles = 0;
+        const int32 NumRows = EndY - BeginY;
+
+        // Per channel: one converted source row, one horizontally filtered row and one accumulator row per output row
+        const int32 FloatsPerChannel = Source.Width + (NumRows + 1) * DstWidth;
+        FChannelPackTrackedBuffer Scratch;
+        Scratch.Allocate(sizeof(float) * FloatsPerChannel * NumChannels, *Band.Memory);
+
+        float* ConvertedRows[ChannelPackNumSourceChannels] = {};
+        float* FilteredRows[ChannelPackNumSourceChannels] = {};
+        float* Accumulators[ChannelPackNumSourceChannels] = {};
+        for (int32 Channel = 0, Slot = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+        {
+            if (bChannels[Channel])
+            {
+                ConvertedRows[Channel] = Scratch.GetData<float>() + (Slot++) * FloatsPerChannel;
+                FilteredRows[Channel] = ConvertedRows[Channel] + Source.Width;
+                Accumulators[Channel] = FilteredRows[Channel] + DstWidth;
+                FMemory::Memzero(Accumulators[Channel], sizeof(float) * NumRows * DstWidth);
+            }
+        }
+
+        int32 SrcBegin = 0;
+        int32 SrcEnd = 0;
+        AxisY.GetSourceRange(BeginY, EndY, SrcBegin, SrcEnd);
+
+        for (int32 SrcY = SrcBegin; SrcY < SrcEnd; ++SrcY)
+        {
+            // Gather the vertical weight of this source row for every output row of the band
+            float RowWeights[ChannelPackBandHeight];
+            bool bRowUsed = false;
+            for (int32 Y = BeginY; Y < EndY; ++Y)
+            {
+                const int32 Tap = SrcY - AxisY.First[Y];
+                const float Weight = (Tap >= 0 && Tap < AxisY.Count[Y]) ? AxisY.Weights[Y * AxisY.MaxTaps + Tap] : 0.0f;
+                RowWeights[Y - BeginY] = Weight;
+                bRowUsed |= (Weight != 0.0f);
+            }
+
+            if (!bRowUsed)
+            {
+                continue;
+            }
+
+            // Read the source row once for all channels
+            const uint64 ConvertStartCycles = FPlatformTime::Cycles64();
+            FormatType::ToFloats(Source.Data + SrcY * RowBytes, ConvertedRows, Source.Width);
+            ConvertCycles += FPlatformTime::Cycles64() - ConvertStartCycles;
+
+            for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+            {
+                if (!bChannels[Channel])
+                {
+                    continue;
+                }
+
+                const float* HorizontalRow = ConvertedRows[Channel];
+                if (!AxisX.IsIdentity())
+                {
+                    FilterRowHorizontally(ConvertedRows[Channel], FilteredRows[Channel]);
+                    HorizontalRow = FilteredRows[Channel];
+                }
+
+                // Vertical pass: scatter into the accumulators of the output rows this source row feeds
+                for (int32 Row = 0; Row < NumRows; ++Row)
+                {
+                    if (RowWeights[Row] != 0.0f)
+                    {
+                        AccumulateWeightedRow(HorizontalRow, RowWeights[Row], Accumulators[Channel] + Row * DstWidth, DstWidth);
+                    }
+                }
+            }
+        }
+
+        for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+        {
+            if (bChannels[Channel])
+            {
+                for (int32 Row = 0; Row < NumRows; ++Row)
+                {
+                    QuantizeRowToBytes(Accumulators[Channel] + Row * DstWidth, OutPlanes[Channel] + Row * DstWidth, DstWidth);
+                }
+            }
+        }
+
+        // Conversion of the source rows is reported on its own; the rest of the band is resampling
+        Band.ConvertCycles += ConvertCycles;
+        Band.ResizeCycles += FPlatformTime::Cycles64() - StartCycles - ConvertCycles;
+    }
+
+private:
+    void FilterRowHorizontally(const float* InRow, float* OutRow) const
+    {
+        const int32 MaxTapsX = AxisX.MaxTaps;
+        for (int32 X = 0; X < DstWidth; ++X)
+        {
+            const float* Texels = InRow + AxisX.First[X];
+            const float* WeightsX = AxisX.Weights.GetData() + X * MaxTapsX;
+            const int32 CountX = AxisX.Count[X];
+
+            float Sum = 0.0f;
+            for (int32 Tap = 0; Tap < CountX; ++Tap)
+            {
+                Sum += WeightsX[Tap] * Texels[Tap];
+            }
+            OutRow[X] = Sum;
+        }
+    }
+
+    FChannelPackSource Source;
+    const FChannelPackFormatKernels* Kernels = nullptr;
+    FResampleAxis AxisX;
+    FResampleAxis AxisY;
+    int32 DstWidth = 0;
+    bool bResize = false;
+    bool bChannels[ChannelPackNumSourceChannels] = {};
+    int32 NumChannels = 0;
+};
+
+// ---------------------------------------------------------
+// Format Kernel Table
+// ---------------------------------------------------------
+
+/**
+ * How close (on the 0-255 scale) a resized constant may be to a rounding edge (N + 0.5). The resampler's
+ * weights sum to 1 only up to float precision, so a uniform band lands a tiny bit above or below the
+ * value depending on the pixel, which only changes the rounded byte next to an edge. The margin is far
+ * wider than that error, even for the longest filters.
+ */
+static constexpr float ConstantRoundingEdgeMargin = 1.0f / 16.0f;
+
+template<typename FormatType>
+static bool ConvertTexelTyped(const uint8* Texel, ETextureSourceChannel Channel, bool bResize, uint8& OutValue)
+{
+    if (!bResize)
+    {
+        uint8* Planes[ChannelPackNumSourceChannels] = {};
+        Planes[(int32)Channel] = &OutValue;
+        FormatType::ToBytes(Texel, Planes, 1);
+        return true;
+    }
+
+    // The resampler's weights are normalized, so a resized constant keeps its unquantized value
+    float Converted = 0.0f;
+    float* Planes[ChannelPackNumSourceChannels] = {};
+    Planes[(int32)Channel] = &Converted;
+    FormatType::ToFloats(Texel, Planes, 1);
+    if (FMath::Abs(Converted - FMath::FloorToFloat(Converted) - 0.5f) < ConstantRoundingEdgeMargin)
+    {
+        return false;
+    }
+
+    QuantizeRowToBytes(&Converted, &OutValue, 1);
+    return true;
+}
+
+template<typename FormatType>
+static constexpr FChannelPackFormatKernels MakeChannelPackFormatKernels()
+{
+    return {
+        FormatType::Format,
+        FormatType::BytesPerPixel,
+        FormatType::bSingleChannel,
+        FormatType::ChannelOffsets,
+        FormatType::ChannelSizes,
+        &FSourceBandProducer::ProduceBandTyped<FormatType>,
+        &ConvertTexelTyped<FormatType>,
+    };
+}
+
+/** Every supported source format. */
+static constexpr FChannelPackFormatKernels ChannelPackFormats[] =
+{
+    MakeChannelPackFormatKernels<FFormatG8>(),
+    MakeChannelPackFormatKernels<FFormatBGRA8>(),
+    MakeChannelPackFormatKernels<FFormatG16>(),
+    MakeChannelPackFormatKernels<FFormatR16F>(),
+    MakeChannelPackFormatKernels<FFormatR32F>(),
+    MakeChannelPackFormatKernels<FFormatRGBA32F>(),
+};
+
+static const FChannelPackFormatKernels* FindChannelPackFormatKernels(EChannelPackSourceFormat Format)
+{
+    for (const FChannelPackFormatKernels& Kernels : ChannelPackFormats)
+    {
+        if (Kernels.Format == Format)
+        {
+            return &Kernels;
+        }
+    }
+    return nullptr;
+}
+
+bool IsChannelPackSourceFormatSupported(EChannelPackSourceFormat Format)
+{
+    return FindChannelPackFormatKernels(Format) != nullptr;
+}
+
+const TCHAR* GetChannelPackSourceFormatName(EChannelPackSourceFormat Format)
+{
+    switch (Format)
+    {
+    case EChannelPackSourceFormat::G8:      return TEXT("G8");
+    case EChannelPackSourceFormat::BGRA8:   return TEXT("BGRA8");
+    case EChannelPackSourceFormat::G16:     return TEXT("G16");
+    case EChannelPackSourceFormat::R16F:    return TEXT("R16F");
+    case EChannelPackSourceFormat::R32F:    return TEXT("R32F");
+    case EChannelPackSourceFormat::RGBA32F: return TEXT("RGBA32F");
+    default:                                return TEXT("Invalid");
+    }
+}
+
+int32 GetChannelPackSourceBytesPerPixel(EChannelPackSourceFormat Format)
+{
+    const FChannelPackFormatKernels* Kernels = FindChannelPackFormatKernels(Format);
+    return Kernels ? Kernels->BytesPerPixel : 0;
+}
+
+bool IsSingleChannelFormat(EChannelPackSourceFormat Format)
+{
+    const FChannelPackFormatKernels* Kernels = FindChannelPackFormatKernels(Format);
+    return Kernels && Kernels->bSingleChannel;
+}
+
+// ---------------------------------------------------------
+// Uniform Sources
+// ---------------------------------------------------------
+// Flat masks (a white roughness, an all-black metallic, a solid alpha) are common inputs. Their
+// channels are written as a constant, like empty slots, instead of being resized band by band.
+
+/** Number of evenly spread texels compared before a source is scanned in full. */
+static constexpr int64 UniformSourceSamples = 4096;
+
+/** @return true if every texel of Source has the same bytes for Channel. */
+static bool IsUniformSourceChannel(const FChannelPackSource& Source, ETextureSourceChannel Channel)
+{
+    CHANNEL_PACK_STAGE_SCOPE("UniformScan", STAT_ChannelPack_UniformScan);
+
+    const FChannelPackFormatKernels* Kernels = FindChannelPackFormatKernels(Source.Format);
+    const int32 BytesPerPixel = Kernels->BytesPerPixel;
+    const int32 Offset = Kernels->ChannelOffsets[(int32)Channel];
+    const int32 Count = Kernels->ChannelSizes[(int32)Channel];
+
+    const int64 NumTexels = (int64)Source.Width * Source.Height;
+    const uint8* First = Source.Data + Offset;
+    auto MatchesFirst = [First, BytesPerPixel, Count](int64 Texel)
+    {
+        const uint8* Bytes = First + Texel * BytesPerPixel;
+        for (int32 Byte = 0; Byte < Count; ++Byte)
+        {
+            if (Bytes[Byte] != First[Byte])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Most sources that are not uniform differ within a few evenly spread samples
+    const int64 SampleStep = FMath::Max<int64>(1, NumTexels / UniformSourceSamples);
+    for (int64 Texel = SampleStep; Texel < NumTexels; Texel += SampleStep)
+    {
+        if (!MatchesFirst(Texel))
+        {
+            return false;
+        }
+    }
+
+    // Whole texels repeat with a period of one texel exactly when the buffer matches itself shifted by one texel
+    if (Count == BytesPerPixel)
+    {
+        return NumTexels < 2 || FMemory::Memcmp(Source.Data, Source.Data + BytesPerPixel, (NumTexels - 1) * BytesPerPixel) == 0;
+    }
+
+    for (int64 Texel = 1; Texel < NumTexels; ++Texel)
+    {
+        if (!MatchesFirst(Texel))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------
+// Packing
+// ---------------------------------------------------------
+
+int32 GetChannelPackMaxThreads()
+{
+    // Worker threads plus the calling thread, which also executes ParallelFor tasks
+    return FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+}
+
+/**
+ * Finds the constant channels of a pack: empty slots, unsupported sources and source channels with the
+ * same value in every texel, with the value each one writes before inversion. Also resolves the source
+ * channel read from single-channel formats. Preserved and cached channels are left as they are.
+ */
+static void FindConstantChannels(const FChannelPackDesc (&Channels)[4], int32 Width, int32 Height,
+    ETextureSourceChannel (&OutSourceChannels)[4], bool (&bOutConstant)[4], uint8 (&OutConstantValues)[4])
+{
+    bool bUniformChecked[4] = {};
+    for (int32 Channel = 0; Channel < 4; ++Channel)
+    {
+        const FChannelPackSource& Source = Channels[Channel].Source;
+        OutSourceChannels[Channel] = Channels[Channel].SourceChannel;
+        bOutConstant[Channel] = false;
+        OutConstantValues[Channel] = 0;
+
+        if (Channels[Channel].bPreserveOutput || Channels[Channel].CachedPlane)
+        {
+            continue;
+        }
+
+        if (!Source.IsValid() || !IsChannelPackSourceFormatSupported(Source.Format))
+        {
+            bOutConstant[Channel] = true;
+            OutConstantValues[Channel] = Channels[Channel].DefaultValue;
+            continue;
+        }
+
+        if (IsSingleChannelFormat(Source.Format))
+        {
+            OutSourceChannels[Channel] = ETextureSourceChannel::Red;
+        }
+
+        // Scan each requested channel of each source once
+        int32 CheckedChannel = 0;
+        while (CheckedChannel < Channel
+            && !(bUniformChecked[CheckedChannel]
+                && OutSourceChannels[CheckedChannel] == OutSourceChannels[Channel]
+                && IsSameChannelPackSource(Channels[CheckedChannel].Source, Source)))
+        {
+            ++CheckedChannel;
+        }
+        if (CheckedChannel < Channel)
+        {
+            bOutConstant[Channel] = bOutConstant[CheckedChannel];
+            OutConstantValues[Channel] = OutConstantValues[CheckedChannel];
+        }
+        else if (IsUniformSourceChannel(Source, OutSourceChannels[Channel]))
+        {
+            // A value on a rounding edge is resampled like any other channel
+            bOutConstant[Channel] = FindChannelPackFormatKernels(Source.Format)->ConvertTexel(
+                Source.Data, OutSourceChannels[Channel], Source.Width != Width || Source.Height != Height, OutConstantValues[Channel]);
+        }
+        bUniformChecked[Channel] = true;
+    }
+}
+
+/**
+ * State shared by the stages of an FChannelPackStagedPack. Each stage describes its channels before it
+ * produces any band and never changes them afterwards, so the stage that completes a band last sees the
+ * channels and the rows of every stage.
+ */
+struct FChannelPackStagedPackState
+{
+    int32 Width = 0;
+    int32 Height = 0;
+    ETextureResizeFilter Filter = ETextureResizeFilter::Bilinear;
+    uint8* OutBGRA = nullptr;
+
+    /** Per channel: the full plane the interleave reads, or the value of a constant channel (after inversion). */
+    const uint8* Planes[4] = {};
+    bool bConstant[4] = {};
+    uint8 OutputConstants[4] = {};
+    bool bInvert[4] = {};
+
+    /** Planes of produced channels without a CapturePlane. */
+    FChannelPackTrackedBuffer OwnedPlanes[4];
+
+    /** Per band: the number of stages that have not produced its rows yet. */
+    TUniquePtr<std::atomic<int32>[]> PendingStages;
+
+    /** Called by a stage once it has produced the rows of a band; interleaves the band if no other stage still has to. */
+    void FinishBand(int32 BandIndex, FChannelPackBandContext& Band, FChannelPackControl* Control)
+    {
+        if (PendingStages[BandIndex].fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+
+        CHANNEL_PACK_STAGE_SCOPE("Interleave", STAT_ChannelPack_Interleave);
+        const uint64 InterleaveStartCycles = FPlatformTime::Cycles64();
+        const int32 BeginY = BandIndex * ChannelPackBandHeight;
+        const int32 BandBytes = (FMath::Min(BeginY + ChannelPackBandHeight, Height) - BeginY) * Width;
+        const uint8* BandPlanes[4] = {};
+        uint32 InvertMask = 0;
+        uint32 ConstantMask = 0;
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            BandPlanes[Channel] = Planes[Channel] ? Planes[Channel] + (int64)BeginY * Width : nullptr;
+            InvertMask |= bInvert[Channel] ? (1u << Channel) : 0;
+            ConstantMask |= bConstant[Channel] ? (1u << Channel) : 0;
+        }
+        GetInterleaveBGRA8Kernel(InvertMask, ConstantMask)(BandPlanes, OutputConstants, OutBGRA + (int64)BeginY * Width * 4, BandBytes);
+        Band.InterleaveCycles += FPlatformTime::Cycles64() - InterleaveStartCycles;
+
+        if (Control)
+        {
+            Control->OutputBytesWritten.fetch_add((uint64)BandBytes * 4, std::memory_order_relaxed);
+            Control->CompletedBands.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * Runs the bands of a pack whose constant channels are known (FindConstantChannels). With a null
+ * OutBGRA, the bands only fill the capture planes, and hand every band to Staged (if any) to interleave.
+ */
+static bool PackChannelBands(const FChannelPackDesc (&Channels)[4], int32 Width, int32 Height, ETextureResizeFilter Filter, uint8* OutBGRA, int32 MaxThreads, FChannelPackControl* Control,
+    const ETextureSourceChannel (&SourceChannels)[4], const bool (&bConstant)[4], const uint8 (&ConstantValues)[4], FChannelPackStagedPackState* Staged = nullptr)
+{
+    // Group the channels by source. Every distinct source gets one producer that reads it once per
+    // band and splits it into all the channels requested from it (e.g., R and G of one mask texture).
+    // Output channels that request the same channel of the same source share one plane and differ
+    // only in their inversion. Constant channels get no producer: they are broadcast by the interleave
+    // without a plane.
+    FSourceBandProducer Producers[4];
+    int32 NumProducers = 0;
+    int32 ProducerOfChannel[4];
+    int32 SharedPlane[4];
+    for (int32 Channel = 0; Channel < 4; ++Channel)
+    {
+        const FChannelPackSource& Source = Channels[Channel].Source;
+        ProducerOfChannel[Channel] = INDEX_NONE;
+        SharedPlane[Channel] = Channel;
+
+        if (Channels[Channel].bPreserveOutput || Channels[Channel].CachedPlane || bConstant[Channel])
+        {
+            continue;
+        }
+
+        int32 ProducerIndex = 0;
+        while (ProducerIndex < NumProducers && !Producers[ProducerIndex].Reads(Source))
+        {
+            ++ProducerIndex;
+        }
+        if (ProducerIndex == NumProducers)
+        {
+            Producers[NumProducers++].Init(Source, Width, Height, Filter);
+        }
+        ProducerOfChannel[Channel] = ProducerIndex;
+
+        for (int32 Previous = 0; Previous < Channel; ++Previous)
+        {
+            if (ProducerOfChannel[Previous] == ProducerIndex && SourceChannels[Previous] == SourceChannels[Channel])
+            {
+                SharedPlane[Channel] = Previous;
+                break;
+            }
+        }
+        if (SharedPlane[Channel] == Channel)
+        {
+            Producers[ProducerIndex].AddChannel(SourceChannels[Channel]);
+        }
+    }
+
+    // Channels written by another pass are left untouched, one byte per pixel
+    static constexpr int32 BGRA8ByteOffsets[4] = { 2, 1, 0, 3 };
+    int32 NumPreserved = 0;
+    int32 NumPlanes = 0;
+    uint32 InvertMask = 0;
+    uint32 ConstantMask = 0;
+    uint8 OutputConstants[4] = {};
+    for (int32 Channel = 0; Channel < 4; ++Channel)
+    {
+        NumPreserved += Channels[Channel].bPreserveOutput ? 1 : 0;
+
+        // Only channels produced into their own plane need band scratch; captured ones are produced in place
+        const bool bOwnPlane = !Channels[Channel].bPreserveOutput && !bConstant[Channel] && !Channels[Channel].CachedPlane && SharedPlane[Channel] == Channel;
+        NumPlanes += (bOwnPlane && !Channels[Channel].CapturePlane) ? 1 : 0;
+
+        InvertMask |= Channels[Channel].bInvert ? (1u << Channel) : 0;
+        ConstantMask |= bConstant[Channel] ? (1u << Channel) : 0;
+
+        // Inversion is folded into the constant once instead of running over every pixel
+        OutputConstants[Channel] = Channels[Channel].bInvert ? 255 - ConstantValues[Channel] : ConstantValues[Channel];
+    }
+
+    // Inversion and constants are applied while interleaving, by a kernel compiled for this combination
+    const FInterleaveBGRA8Kernel InterleaveKernel = GetInterleaveBGRA8Kernel(InvertMask, ConstantMask);
+
+    const int32 NumBands = FMath::DivideAndRoundUp(Height, ChannelPackBandHeight);
+    const int32 NumWorkers = FMath::Min(NumBands, MaxThreads > 0 ? MaxThreads : GetChannelPackMaxThreads());
+
+    // Every band reads its rows of each source and cached plane and writes its rows of the output
+    uint64 SourceBytes = 0;
+    for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+    {
+        SourceBytes += Producers[ProducerIndex].GetSourceBytes();
+    }
+    for (int32 Channel = 0; Channel < 4; ++Channel)
+    {
+        SourceBytes += (OutBGRA && !Channels[Channel].bPreserveOutput && Channels[Channel].CachedPlane) ? (uint64)Width * Height : 0;
+    }
+    const uint64 OutputBytes = OutBGRA ? (uint64)Width * Height * (4 - NumPreserved) : 0;
+
+    INC_DWORD_STAT(STAT_ChannelPack_Packs);
+    INC_FLOAT_STAT_BY(STAT_ChannelPack_SourceMBRead, (float)(SourceBytes / (1024.0 * 1024.0)));
+    INC_FLOAT_STAT_BY(STAT_ChannelPack_OutputMBWritten, (float)(OutputBytes / (1024.0 * 1024.0)));
+
+    FChannelPackMemoryTracker& Memory = (Control && Control->Memory) ? *Control->Memory : FChannelPackMemoryTracker::GetGlobal();
+
+    if (Control)
+    {
+        Control->TotalBands.store(NumBands, std::memory_order_relaxed);
+        Control->SourceBytesRead.fetch_add(SourceBytes, std::memory_order_relaxed);
+        Control->OutputBytesWritten.fetch_add(OutputBytes, std::memory_order_relaxed);
+    }
+
+    auto ProcessBand = [&](int32 BandIndex)
+    {
+        const int32 BeginY = BandIndex * ChannelPackBandHeight;
+        const int32 EndY = FMath::Min(BeginY + ChannelPackBandHeight, Height);
+        const int32 BandBytes = (EndY - BeginY) * Width;
+
+        FChannelPackBandContext Band;
+        Band.Memory = &Memory;
+
+        // Planar scratch for one band of every channel with its own plane and no capture plane. Captured
+        // channels are produced straight into their rows of the capture plane, cached planes are read in
+        // place, and channels that share a plane point at it, since inversion happens in the interleave.
+        FChannelPackTrackedBuffer BandScratch;
+        BandScratch.Allocate((int64)BandBytes * NumPlanes, Memory);
+        const uint8* Planes[4] = {};
+        uint8* ProducedPlanes[4] = {};
+        for (int32 Channel = 0, Plane = 0; Channel < 4; ++Channel)
+        {
+            if (Channels[Channel].bPreserveOutput || bConstant[Channel])
+            {
+                continue;
+            }
+
+            if (Channels[Channel].CachedPlane)
+            {
+                Planes[Channel] = Channels[Channel].CachedPlane + (int64)BeginY * Width;
+            }
+            else if (SharedPlane[Channel] != Channel)
+            {
+                Planes[Channel] = Planes[SharedPlane[Channel]];
+            }
+            else
+            {
+                ProducedPlanes[Channel] = Channels[Channel].CapturePlane
+                    ? Channels[Channel].CapturePlane + (int64)BeginY * Width
+                    : BandScratch.GetData() + (Plane++) * BandBytes;
+                Planes[Channel] = ProducedPlanes[Channel];
+            }
+        }
+
+        for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+        {
+            uint8* SourcePlanes[ChannelPackNumSourceChannels] = {};
+            for (int32 Channel = 0; Channel < 4; ++Channel)
+            {
+                if (ProducerOfChannel[Channel] == ProducerIndex && SharedPlane[Channel] == Channel)
+                {
+                    SourcePlanes[(int32)SourceChannels[Channel]] = ProducedPlanes[Channel];
+                }
+            }
+            Producers[ProducerIndex].ProduceBand(BeginY, EndY, SourcePlanes, Band);
+        }
+
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            if (Channels[Channel].bPreserveOutput || !Channels[Channel].CapturePlane)
+            {
+                continue;
+            }
+
+            // Captured planes hold the values before inversion
+            uint8* CaptureBand = Channels[Channel].CapturePlane + (int64)BeginY * Width;
+            if (bConstant[Channel])
+            {
+                FMemory::Memset(CaptureBand, ConstantValues[Channel], BandBytes);
+            }
+            else if (Planes[Channel] != CaptureBand)
+            {
+                FMemory::Memcpy(CaptureBand, Planes[Channel], BandBytes);
+            }
+        }
+
+        // Rows of a band are contiguous in the output, so the whole band is one interleave call
+        if (OutBGRA)
+        {
+            CHANNEL_PACK_STAGE_SCOPE("Interleave", STAT_ChannelPack_Interleave);
+            const uint64 InterleaveStartCycles = FPlatformTime::Cycles64();
+            uint8* OutBand = OutBGRA + (int64)BeginY * Width * 4;
+            if (NumPreserved == 0)
+            {
+                InterleaveKernel(Planes, OutputConstants, OutBand, BandBytes);
+            }
+            else
+            {
+                for (int32 Channel = 0; Channel < 4; ++Channel)
+                {
+                    if (bConstant[Channel])
+                    {
+                        FillBGRA8Channel(OutputConstants[Channel], OutBand, BGRA8ByteOffsets[Channel], BandBytes);
+                    }
+                    else if (!Channels[Channel].bPreserveOutput)
+                    {
+                        WritePlaneToBGRA8Channel(Planes[Channel], OutBand, BGRA8ByteOffsets[Channel], BandBytes, Channels[Channel].bInvert);
+                    }
+                }
+            }
+            Band.InterleaveCycles = FPlatformTime::Cycles64() - InterleaveStartCycles;
+        }
+        else if (Staged)
+        {
+            Staged->FinishBand(BandIndex, Band, Control);
+        }
+
+        if (Control)
+        {
+            Control->ConvertCycles.fetch_add(Band.ConvertCycles, std::memory_order_relaxed);
+            Control->ResizeCycles.fetch_add(Band.ResizeCycles, std::memory_order_relaxed);
+            Control->InterleaveCycles.fetch_add(Band.InterleaveCycles, std::memory_order_relaxed);
+        }
+    };
+
+    // One task per worker, each pulling the next band from a shared counter. Bands that need
+    // resizing cost more than plain copies, so pulling keeps every worker busy until the end,
+    // and the number of tasks caps how many threads the pack uses.
+    std::atomic<int32> NextBand(0);
+    // A staged band counts as completed once it has been interleaved (FinishBand)
+    FChannelPackControl* const BandCounter = Staged ? nullptr : Control;
+    ParallelFor(NumWorkers, [&NextBand, &ProcessBand, NumBands, Control, BandCounter](int32 /*WorkerIndex*/)
+    {
+        for (int32 BandIndex = NextBand++; BandIndex < NumBands; BandIndex = NextBand++)
+        {
+            if (Control && Control->IsCancelRequested())
+            {
+                return;
+            }
+
+            ProcessBand(BandIndex);
+
+            if (BandCounter)
+            {
+                BandCounter->CompletedBands.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    return !(Control && Control->IsCancelRequested());
+}
+
+bool PackChannelsToBGRA8(const FChannelPackDesc (&Channels)[4], int32 Width, int32 Height, ETextureResizeFilter Filter, uint8* OutBGRA, int32 MaxThreads, FChannelPackControl* Control)
+{
+    check(OutBGRA);
+    if (Width <= 0 || Height <= 0)
+    {
+        return true;
+    }
+
+    CHANNEL_PACK_STAGE_SCOPE("Pack", STAT_ChannelPack_Pack);
+
+    // Empty slots and uniform sources are constant channels, written by the interleave without a plane
+    ETextureSourceChannel SourceChannels[4];
+    bool bConstant[4];
+    uint8 ConstantValues[4];
+    FindConstantChannels(Channels, Width, Height, SourceChannels, bConstant, ConstantValues);
+
+    return PackChannelBands(Channels, Width, Height, Filter, OutBGRA, MaxThreads, Control, SourceChannels, bConstant, ConstantValues);
+}
+
+FChannelPackStagedPack::FChannelPackStagedPack(int32 Width, int32 Height, ETextureResizeFilter Filter, uint8* OutBGRA, int32 NumStages)
+    : State(MakeUnique<FChannelPackStagedPackState>())
+{
+    check(OutBGRA);
+    State->Width = Width;
+    State->Height = Height;
+    State->Filter = Filter;
+    State->OutBGRA = OutBGRA;
+
+    const int32 NumBands = (Width > 0 && Height > 0) ? FMath::DivideAndRoundUp(Height, ChannelPackBandHeight) : 0;
+    State->PendingStages = MakeUnique<std::atomic<int32>[]>(NumBands);
+    for (int32 BandIndex = 0; BandIndex < NumBands; ++BandIndex)
+    {
+        State->PendingStages[BandIndex].store(NumStages, std::memory_order_relaxed);
+    }
+    INC_FLOAT_STAT_BY(STAT_ChannelPack_OutputMBWritten, (float)((double)Width * FMath::Max(Height, 0) * 4 / (1024.0 * 1024.0)));
+}
+
+FChannelPackStagedPack::~FChannelPackStagedPack() = default;
+
+bool FChannelPackStagedPack::PackStage(const FChannelPackDesc (&Channels)[4], int32 MaxThreads, FChannelPackControl* Control)
+{
+    FChannelPackStagedPackState& Staged = *State;
+    if (Staged.Width <= 0 || Staged.Height <= 0)
+    {
+        return true;
+    }
+
+    CHANNEL_PACK_STAGE_SCOPE("Pack", STAT_ChannelPack_Pack);
+
+    ETextureSourceChannel SourceChannels[4];
+    bool bConstant[4];
+    uint8 ConstantValues[4];
+    FindConstantChannels(Channels, Staged.Width, Staged.Height, SourceChannels, bConstant, ConstantValues);
+
+    // Describe the stage's channels to the interleave before any band is produced. Every channel that
+    // reads its source is produced into a full plane: its capture plane, or one the staged pack allocates.
+    // A channel that reads the same channel of the same source as an earlier one (and captures nothing)
+    // is not produced: it reads the earlier channel's plane. Constant channels keep their description,
+    // so that the bands fill their capture planes.
+    FChannelPackMemoryTracker& Memory = (Control && Control->Memory) ? *Control->Memory : FChannelPackMemoryTracker::GetGlobal();
+    FChannelPackDesc BandChannels[4];
+    for (int32 Channel = 0; Channel < 4; ++Channel)
+    {
+        const FChannelPackDesc& Desc = Channels[Channel];
+        BandChannels[Channel] = Desc;
+        if (Desc.bPreserveOutput)
+        {
+            continue;
+        }
+
+        Staged.bInvert[Channel] = Desc.bInvert;
+        if (bConstant[Channel])
+        {
+            Staged.bConstant[Channel] = true;
+            Staged.OutputConstants[Channel] = Desc.bInvert ? 255 - ConstantValues[Channel] : ConstantValues[Channel];
+            continue;
+        }
+
+        if (Desc.CachedPlane)
+        {
+            Staged.Planes[Channel] = Desc.CachedPlane;
+            continue;
+        }
+
+        int32 SharedPlane = INDEX_NONE;
+        for (int32 Previous = 0; Previous < Channel && !Desc.CapturePlane; ++Previous)
+        {
+            if (!Channels[Previous].bPreserveOutput && !Channels[Previous].CachedPlane && !bConstant[Previous]
+                && SourceChannels[Previous] == SourceChannels[Channel] && IsSameChannelPackSource(Channels[Previous].Source, Desc.Source))
+            {
+                SharedPlane = Previous;
+                break;
+            }
+        }
+        if (SharedPlane != INDEX_NONE)
+        {
+            Staged.Planes[Channel] = Staged.Planes[SharedPlane];
+            BandChannels[Channel].bPreserveOutput = true;
+            continue;
+        }
+
+        if (!Desc.CapturePlane)
+        {
+            Staged.OwnedPlanes[Channel].Allocate((int64)Staged.Width * Staged.Height, Memory);
+            BandChannels[Channel].CapturePlane = Staged.OwnedPlanes[Channel].GetData();
+        }
+        Staged.Planes[Channel] = BandChannels[Channel].CapturePlane;
+    }
+
+    return PackChannelBands(BandChannels, Staged.Width, Staged.Height, Staged.Filter, nullptr, MaxThreads, Control, SourceChannels, bConstant, ConstantValues, &Staged);
+}
@@ -0,0 +1,882 @@
+#include "TextureChannelPackerKernels.h"
+#include "Math/Float16.h"
+#include "Templates/IntegerSequence.h"
+
+#if TEXTURECHANNELPACKER_WITH_AVX2 || TEXTURECHANNELPACKER_WITH_F16C
+#include <immintrin.h>
+#elif TEXTURECHANNELPACKER_WITH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if TEXTURECHANNELPACKER_WITH_NEON
+#include <arm_neon.h>
+#endif
+
+const TCHAR* GetChannelPackerSimdName()
+{
+#if TEXTURECHANNELPACKER_WITH_AVX2
+    return TEXT("AVX2");
+#elif TEXTURECHANNELPACKER_WITH_SSE2
+    return TEXT("SSE2");
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    return TEXT("NEON");
+#else
+    return TEXT("Scalar");
+#endif
+}
+
+// ---------------------------------------------------------
+// Planar to BGRA8 Interleave
+// ---------------------------------------------------------
+
+void InterleavePlanarToBGRA8Scalar(const uint8* R, const uint8* G, const uint8* B, const uint8* A, uint8* OutBGRA, int64 Num)
+{
+    for (int64 i = 0; i < Num; ++i)
+    {
+        OutBGRA[i * 4 + 0] = B[i]; // B
+        OutBGRA[i * 4 + 1] = G[i]; // G
+        OutBGRA[i * 4 + 2] = R[i]; // R
+        OutBGRA[i * 4 + 3] = A[i]; // A
+    }
+}
+
+// Every interleave kernel is generated from one template, specialized for how each of the four
+// channels is read: a plane, an inverted plane or a constant. The mode of every channel is a
+// template parameter, so inversion costs one vector XOR and constants cost no load at all, with
+// no per-pixel branches. GetInterleaveBGRA8Kernel picks the kernel once per pack.
+
+/** How an interleave kernel reads one channel. */
+enum class EInterleaveChannelMode : uint32
+{
+    Plane,
+    InvertedPlane,
+    Constant,
+};
+
+static constexpr uint32 NumInterleaveChannelModes = 3;
+
+/** One kernel per combination of the modes of R, G, B and A. */
+static constexpr uint32 NumInterleaveKernels = NumInterleaveChannelModes * NumInterleaveChannelModes * NumInterleaveChannelModes * NumInterleaveChannelModes;
+
+/** Kernel indices are base-3 numbers with one digit per channel, R being the lowest. */
+static constexpr EInterleaveChannelMode GetInterleaveChannelMode(uint32 KernelIndex, int32 Channel)
+{
+    for (int32 Digit = 0; Digit < Channel; ++Digit)
+    {
+        KernelIndex /= NumInterleaveChannelModes;
+    }
+    return (EInterleaveChannelMode)(KernelIndex % NumInterleaveChannelModes);
+}
+
+template<EInterleaveChannelMode Mode>
+static FORCEINLINE uint8 LoadInterleaveChannel(const uint8* Plane, uint8 Constant, int64 i)
+{
+    if constexpr (Mode == EInterleaveChannelMode::Constant)
+    {
+        return Constant;
+    }
+    else if constexpr (Mode == EInterleaveChannelMode::InvertedPlane)
+    {
+        return 255 - Plane[i];
+    }
+    else
+    {
+        return Plane[i];
+    }
+}
+
+#if TEXTURECHANNELPACKER_WITH_AVX2
+template<EInterleaveChannelMode Mode>
+static FORCEINLINE __m256i LoadInterleaveChannel256(const uint8* Plane, __m256i Constant, int64 i)
+{
+    if constexpr (Mode == EInterleaveChannelMode::Constant)
+    {
+        return Constant;
+    }
+    else if constexpr (Mode == EInterleaveChannelMode::InvertedPlane)
+    {
+        return _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(Plane + i)), _mm256_set1_epi8((char)0xFF));
+    }
+    else
+    {
+        return _mm256_loadu_si256((const __m256i*)(Plane + i));
+    }
+}
+#endif
+
+#if TEXTURECHANNELPACKER_WITH_SSE2
+template<EInterleaveChannelMode Mode>
+static FORCEINLINE __m128i LoadInterleaveChannel128(const uint8* Plane, __m128i Constant, int64 i)
+{
+    if constexpr (Mode == EInterleaveChannelMode::Constant)
+    {
+        return Constant;
+    }
+    else if constexpr (Mode == EInterleaveChannelMode::InvertedPlane)
+    {
+        return _mm_xor_si128(_mm_loadu_si128((const __m128i*)(Plane + i)), _mm_set1_epi8((char)0xFF));
+    }
+    else
+    {
+        return _mm_loadu_si128((const __m128i*)(Plane + i));
+    }
+}
+#endif
+
+#if TEXTURECHANNELPACKER_WITH_NEON
+template<EInterleaveChannelMode Mode>
+static FORCEINLINE uint8x16_t LoadInterleaveChannelNeon(const uint8* Plane, uint8x16_t Constant, int64 i)
+{
+    if constexpr (Mode == EInterleaveChannelMode::Constant)
+    {
+        return Constant;
+    }
+    else if constexpr (Mode == EInterleaveChannelMode::InvertedPlane)
+    {
+        return vmvnq_u8(vld1q_u8(Plane + i));
+    }
+    else
+    {
+        return vld1q_u8(Plane + i);
+    }
+}
+#endif
+
+template<uint32 KernelIndex>
+static void InterleavePlanarToBGRA8Kernel(const uint8* const Planes[4], const uint8 (&Constants)[4], uint8* OutBGRA, int64 Num)
+{
+    constexpr EInterleaveChannelMode ModeR = GetInterleaveChannelMode(KernelIndex, 0);
+    constexpr EInterleaveChannelMode ModeG = GetInterleaveChannelMode(KernelIndex, 1);
+    constexpr EInterleaveChannelMode ModeB = GetInterleaveChannelMode(KernelIndex, 2);
+    constexpr EInterleaveChannelMode ModeA = GetInterleaveChannelMode(KernelIndex, 3);
+
+    const uint8* R = Planes[0];
+    const uint8* G = Planes[1];
+    const uint8* B = Planes[2];
+    const uint8* A = Planes[3];
+
+    int64 i = 0;
+
+#if TEXTURECHANNELPACKER_WITH_AVX2
+    {
+        const __m256i ConstR = _mm256_set1_epi8((char)Constants[0]);
+        const __m256i ConstG = _mm256_set1_epi8((char)Constants[1]);
+        const __m256i ConstB = _mm256_set1_epi8((char)Constants[2]);
+        const __m256i ConstA = _mm256_set1_epi8((char)Constants[3]);
+
+        for (; i + 32 <= Num; i += 32)
+        {
+            const __m256i VecB = LoadInterleaveChannel256<ModeB>(B, ConstB, i);
+            const __m256i VecG = LoadInterleaveChannel256<ModeG>(G, ConstG, i);
+            const __m256i VecR = LoadInterleaveChannel256<ModeR>(R, ConstR, i);
+            const __m256i VecA = LoadInterleaveChannel256<ModeA>(A, ConstA, i);
+
+            // Unpacks work per 128-bit lane: lane 0 holds pixels 0-15, lane 1 holds pixels 16-31
+            const __m256i BGLo = _mm256_unpacklo_epi8(VecB, VecG);
+            const __m256i BGHi = _mm256_unpackhi_epi8(VecB, VecG);
+            const __m256i RALo = _mm256_unpacklo_epi8(VecR, VecA);
+            const __m256i RAHi = _mm256_unpackhi_epi8(VecR, VecA);
+
+            const __m256i Pixels0 = _mm256_unpacklo_epi16(BGLo, RALo); // 0-3   | 16-19
+            const __m256i Pixels1 = _mm256_unpackhi_epi16(BGLo, RALo); // 4-7   | 20-23
+            const __m256i Pixels2 = _mm256_unpacklo_epi16(BGHi, RAHi); // 8-11  | 24-27
+            const __m256i Pixels3 = _mm256_unpackhi_epi16(BGHi, RAHi); // 12-15 | 28-31
+
+            __m256i* Dst = (__m256i*)(OutBGRA + i * 4);
+            _mm256_storeu_si256(Dst + 0, _mm256_permute2x128_si256(Pixels0, Pixels1, 0x20));
+            _mm256_storeu_si256(Dst + 1, _mm256_permute2x128_si256(Pixels2, Pixels3, 0x20));
+            _mm256_storeu_si256(Dst + 2, _mm256_permute2x128_si256(Pixels0, Pixels1, 0x31));
+            _mm256_storeu_si256(Dst + 3, _mm256_permute2x128_si256(Pixels2, Pixels3, 0x31));
+        }
+    }
+#endif
+
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    {
+        const __m128i ConstR = _mm_set1_epi8((char)Constants[0]);
+        const __m128i ConstG = _mm_set1_epi8((char)Constants[1]);
+        const __m128i ConstB = _mm_set1_epi8((char)Constants[2]);
+        const __m128i ConstA = _mm_set1_epi8((char)Constants[3]);
+
+        for (; i + 16 <= Num; i += 16)
+        {
+            const __m128i VecB = LoadInterleaveChannel128<ModeB>(B, ConstB, i);
+            const __m128i VecG = LoadInterleaveChannel128<ModeG>(G, ConstG, i);
+            const __m128i VecR = LoadInterleaveChannel128<ModeR>(R, ConstR, i);
+            const __m128i VecA = LoadInterleaveChannel128<ModeA>(A, ConstA, i);
+
+            const __m128i BGLo = _mm_unpacklo_epi8(VecB, VecG);
+            const __m128i BGHi = _mm_unpackhi_epi8(VecB, VecG);
+            const __m128i RALo = _mm_unpacklo_epi8(VecR, VecA);
+            const __m128i RAHi = _mm_unpackhi_epi8(VecR, VecA);
+
+            __m128i* Dst = (__m128i*)(OutBGRA + i * 4);
+            _mm_storeu_si128(Dst + 0, _mm_unpacklo_epi16(BGLo, RALo));
+            _mm_storeu_si128(Dst + 1, _mm_unpackhi_epi16(BGLo, RALo));
+            _mm_storeu_si128(Dst + 2, _mm_unpacklo_epi16(BGHi, RAHi));
+            _mm_storeu_si128(Dst + 3, _mm_unpackhi_epi16(BGHi, RAHi));
+        }
+    }
+#endif
+
+#if TEXTURECHANNELPACKER_WITH_NEON
+    {
+        const uint8x16_t ConstR = vdupq_n_u8(Constants[0]);
+        const uint8x16_t ConstG = vdupq_n_u8(Constants[1]);
+        const uint8x16_t ConstB = vdupq_n_u8(Constants[2]);
+        const uint8x16_t ConstA = vdupq_n_u8(Constants[3]);
+
+        for (; i + 16 <= Num; i += 16)
+        {
+            uint8x16x4_t Pixels;
+            Pixels.val[0] = LoadInterleaveChannelNeon<ModeB>(B, ConstB, i);
+            Pixels.val[1] = LoadInterleaveChannelNeon<ModeG>(G, ConstG, i);
+            Pixels.val[2] = LoadInterleaveChannelNeon<ModeR>(R, ConstR, i);
+            Pixels.val[3] = LoadInterleaveChannelNeon<ModeA>(A, ConstA, i);
+            vst4q_u8(OutBGRA + i * 4, Pixels);
+        }
+    }
+#endif
+
+    for (; i < Num; ++i)
+    {
+        OutBGRA[i * 4 + 0] = LoadInterleaveChannel<ModeB>(B, Constants[2], i);
+        OutBGRA[i * 4 + 1] = LoadInterleaveChannel<ModeG>(G, Constants[1], i);
+        OutBGRA[i * 4 + 2] = LoadInterleaveChannel<ModeR>(R, Constants[0], i);
+        OutBGRA[i * 4 + 3] = LoadInterleaveChannel<ModeA>(A, Constants[3], i);
+    }
+}
+
+template<typename KernelIndexSequence>
+struct TInterleaveKernelTable;
+
+template<uint32... KernelIndices>
+struct TInterleaveKernelTable<TIntegerSequence<uint32, KernelIndices...>>
+{
+    static constexpr FInterleaveBGRA8Kernel Kernels[] = { &InterleavePlanarToBGRA8Kernel<KernelIndices>... };
+};
+
+FInterleaveBGRA8Kernel GetInterleaveBGRA8Kernel(uint32 InvertMask, uint32 ConstantMask)
+{
+    uint32 KernelIndex = 0;
+    for (int32 Channel = 3; Channel >= 0; --Channel)
+    {
+        // A constant is written as given, so inversion must already be applied to it
+        const EInterleaveChannelMode Mode = (ConstantMask & (1u << Channel)) ? EInterleaveChannelMode::Constant
+            : (InvertMask & (1u << Channel)) ? EInterleaveChannelMode::InvertedPlane
+            : EInterleaveChannelMode::Plane;
+        KernelIndex = KernelIndex * NumInterleaveChannelModes + (uint32)Mode;
+    }
+    return TInterleaveKernelTable<TMakeIntegerSequence<uint32, NumInterleaveKernels>>::Kernels[KernelIndex];
+}
+
+void InterleavePlanarToBGRA8(const uint8* R, const uint8* G, const uint8* B, const uint8* A, uint8* OutBGRA, int64 Num)
+{
+    const uint8* const Planes[4] = { R, G, B, A };
+    static constexpr uint8 NoConstants[4] = {};
+    InterleavePlanarToBGRA8Kernel<0>(Planes, NoConstants, OutBGRA, Num);
+}
+
+void FillBGRA8Channel(uint8 Value, uint8* OutBGRA, int32 ByteOffset, int64 Num)
+{
+    check(ByteOffset >= 0 && ByteOffset < 4);
+    uint8* Dst = OutBGRA + ByteOffset;
+    for (int64 i = 0; i < Num; ++i)
+    {
+        Dst[i * 4] = Value;
+    }
+}
+
+template<EInterleaveChannelMode Mode>
+static void WritePlaneToBGRA8ChannelKernel(const uint8* Plane, uint8* Dst, int64 Num)
+{
+    for (int64 i = 0; i < Num; ++i)
+    {
+        Dst[i * 4] = LoadInterleaveChannel<Mode>(Plane, 0, i);
+    }
+}
+
+void WritePlaneToBGRA8Channel(const uint8* Plane, uint8* OutBGRA, int32 ByteOffset, int64 Num, bool bInvert)
+{
+    check(ByteOffset >= 0 && ByteOffset < 4);
+    if (bInvert)
+    {
+        WritePlaneToBGRA8ChannelKernel<EInterleaveChannelMode::InvertedPlane>(Plane, OutBGRA + ByteOffset, Num);
+    }
+    else
+    {
+        WritePlaneToBGRA8ChannelKernel<EInterleaveChannelMode::Plane>(Plane, OutBGRA + ByteOffset, Num);
+    }
+}
+
+// ---------------------------------------------------------
+// Conversion Helpers
+// ---------------------------------------------------------
+
+/** Scales a normalized value to 0-255 and clamps it. FMath::Max picks 0 for NaN. */
+static FORCEINLINE float ScaleClampTo255(float Value)
+{
+    return FMath::Min(FMath::Max(Value * 255.0f, 0.0f), 255.0f);
+}
+
+static FORCEINLINE float LoadHalf(const uint16* Src)
+{
+    return ((const FFloat16*)Src)->GetFloat();
+}
+
+// Rec. 709 luminance weights in 1/256 steps, applied to the stored values. The float path uses the same
+// weights, so the float luminance of 8-bit components is exactly the integer sum / 256 and rounds to the
+// byte LuminanceOfBytes returns: a resized BGRA8 luminance agrees with a same-size one at a scale of 1.
+static constexpr int16 LuminanceWeightR8 = 54;
+static constexpr int16 LuminanceWeightG8 = 183;
+static constexpr int16 LuminanceWeightB8 = 19;
+static_assert(LuminanceWeightR8 + LuminanceWeightG8 + LuminanceWeightB8 == 256, "Luminance weights must sum to 1");
+static constexpr float LuminanceWeightR = LuminanceWeightR8 / 256.0f;
+static constexpr float LuminanceWeightG = LuminanceWeightG8 / 256.0f;
+static constexpr float LuminanceWeightB = LuminanceWeightB8 / 256.0f;
+
+static FORCEINLINE float LuminanceOf(float R, float G, float B)
+{
+    return R * LuminanceWeightR + G * LuminanceWeightG + B * LuminanceWeightB;
+}
+
+/** Rounded integer luminance of 8-bit components. */
+static FORCEINLINE uint8 LuminanceOfBytes(uint32 R, uint32 G, uint32 B)
+{
+    return (uint8)((R * LuminanceWeightR8 + G * LuminanceWeightG8 + B * LuminanceWeightB8 + 128) >> 8);
+}
+
+#if TEXTURECHANNELPACKER_WITH_SSE2
+/** Vector version of ScaleClampTo255. _mm_max_ps returns its second operand (0) for NaN. */
+static FORCEINLINE __m128 ScaleClampTo255(__m128 Value)
+{
+    return _mm_min_ps(_mm_max_ps(_mm_mul_ps(Value, _mm_set1_ps(255.0f)), _mm_setzero_ps()), _mm_set1_ps(255.0f));
+}
+
+/** Truncates 16 floats already in [0, 255] and packs them into 16 bytes. */
+static FORCEINLINE __m128i TruncateToBytes(__m128 V0, __m128 V1, __m128 V2, __m128 V3)
+{
+    const __m128i Lo = _mm_packs_epi32(_mm_cvttps_epi32(V0), _mm_cvttps_epi32(V1));
+    const __m128i Hi = _mm_packs_epi32(_mm_cvttps_epi32(V2), _mm_cvttps_epi32(V3));
+    return _mm_packus_epi16(Lo, Hi);
+}
+
+/** Widens 4 half-floats to floats. */
+static FORCEINLINE __m128 LoadHalf4(const uint16* Src)
+{
+    const __m128i Halves = _mm_loadl_epi64((const __m128i*)Src);
+#if TEXTURECHANNELPACKER_WITH_F16C
+    return _mm_cvtph_ps(Halves);
+#else
+    // Exponent rebias by multiplication (handles denormals), then patch Inf/NaN and the sign back in
+    const __m128i Bits = _mm_unpacklo_epi16(Halves, _mm_setzero_si128());
+    const __m128i ExpMantissa = _mm_and_si128(Bits, _mm_set1_epi32(0x7fff));
+    const __m128i Sign = _mm_slli_epi32(_mm_xor_si128(Bits, ExpMantissa), 16);
+    const __m128 Scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(ExpMantissa, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    const __m128i WasInfNan = _mm_cmpgt_epi32(ExpMantissa, _mm_set1_epi32(0x7bff));
+    const __m128 InfNanExponent = _mm_and_ps(_mm_castsi128_ps(WasInfNan), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+    return _mm_or_ps(Scaled, _mm_or_ps(_mm_castsi128_ps(Sign), InfNanExponent));
+#endif
+}
+
+/** Loads 4 consecutive FLinearColor texels and transposes them into R, G, B and A vectors. */
+static FORCEINLINE void LoadRGBA4(const float* Src, __m128& R, __m128& G, __m128& B, __m128& A)
+{
+    R = _mm_loadu_ps(Src + 0);
+    G = _mm_loadu_ps(Src + 4);
+    B = _mm_loadu_ps(Src + 8);
+    A = _mm_loadu_ps(Src + 12);
+    _MM_TRANSPOSE4_PS(R, G, B, A);
+}
+
+/** Extracts one byte component (Shift: 0 = B, 8 = G, 16 = R, 24 = A) of 4 BGRA8 texels as 32-bit integers. */
+static FORCEINLINE __m128i LoadBGRA8Component4(const uint8* Src, int32 Shift)
+{
+    return _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i*)Src), _mm_cvtsi32_si128(Shift)), _mm_set1_epi32(0xff));
+}
+
+/** Extracts one byte component of 8 BGRA8 texels as 16-bit integers. */
+static FORCEINLINE __m128i LoadBGRA8Component8(const uint8* Src, int32 Shift)
+{
+    return _mm_packs_epi32(LoadBGRA8Component4(Src, Shift), LoadBGRA8Component4(Src + 16, Shift));
+}
+
+/** Integer luminance of 8 BGRA8 texels as 16-bit integers (see LuminanceOfBytes). */
+static FORCEINLINE __m128i LoadBGRA8Luminance8(const uint8* Src)
+{
+    const __m128i R = _mm_mullo_epi16(LoadBGRA8Component8(Src, 16), _mm_set1_epi16(LuminanceWeightR8));
+    const __m128i G = _mm_mullo_epi16(LoadBGRA8Component8(Src, 8), _mm_set1_epi16(LuminanceWeightG8));
+    const __m128i B = _mm_mullo_epi16(LoadBGRA8Component8(Src, 0), _mm_set1_epi16(LuminanceWeightB8));
+    // The weighted sum is at most 255 * 256, so it fits in an unsigned 16-bit lane
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(R, G), _mm_add_epi16(B, _mm_set1_epi16(128))), 8);
+}
+
+/** Float luminance of R, G and B vectors. */
+static FORCEINLINE __m128 LuminanceOf(__m128 R, __m128 G, __m128 B)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(R, _mm_set1_ps(LuminanceWeightR)), _mm_mul_ps(G, _mm_set1_ps(LuminanceWeightG))), _mm_mul_ps(B, _mm_set1_ps(LuminanceWeightB)));
+}
+#endif
+
+#if TEXTURECHANNELPACKER_WITH_NEON
+/** Vector version of ScaleClampTo255. vmaxnmq_f32 returns the number (0) for NaN. */
+static FORCEINLINE float32x4_t ScaleClampTo255(float32x4_t Value)
+{
+    return vminq_f32(vmaxnmq_f32(vmulq_n_f32(Value, 255.0f), vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f));
+}
+
+/** Truncates 16 floats already in [0, 255] and packs them into 16 bytes. */
+static FORCEINLINE uint8x16_t TruncateToBytes(float32x4_t V0, float32x4_t V1, float32x4_t V2, float32x4_t V3)
+{
+    const uint16x8_t Lo = vcombine_u16(vmovn_u32(vcvtq_u32_f32(V0)), vmovn_u32(vcvtq_u32_f32(V1)));
+    const uint16x8_t Hi = vcombine_u16(vmovn_u32(vcvtq_u32_f32(V2)), vmovn_u32(vcvtq_u32_f32(V3)));
+    return vcombine_u8(vmovn_u16(Lo), vmovn_u16(Hi));
+}
+
+static FORCEINLINE float32x4_t LoadHalf4(const uint16* Src)
+{
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(Src)));
+}
+
+/** Widens 16 bytes to 16 floats, 4 per vector in order. */
+static FORCEINLINE void WidenBytesToFloats(uint8x16_t Bytes, float32x4_t (&Out)[4])
+{
+    const uint16x8_t Lo = vmovl_u8(vget_low_u8(Bytes));
+    const uint16x8_t Hi = vmovl_u8(vget_high_u8(Bytes));
+    Out[0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(Lo)));
+    Out[1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(Lo)));
+    Out[2] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(Hi)));
+    Out[3] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(Hi)));
+}
+
+static FORCEINLINE float32x4_t LuminanceOf(float32x4_t R, float32x4_t G, float32x4_t B)
+{
+    return vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(R, LuminanceWeightR), G, LuminanceWeightG), B, LuminanceWeightB);
+}
+
+/** Integer luminance of 8 texels (see LuminanceOfBytes). */
+static FORCEINLINE uint8x8_t LuminanceOfBytes(uint8x8_t R, uint8x8_t G, uint8x8_t B)
+{
+    uint16x8_t Sum = vmull_u8(R, vdup_n_u8(LuminanceWeightR8));
+    Sum = vmlal_u8(Sum, G, vdup_n_u8(LuminanceWeightG8));
+    Sum = vmlal_u8(Sum, B, vdup_n_u8(LuminanceWeightB8));
+    return vrshrn_n_u16(Sum, 8);
+}
+#endif
+
+// ---------------------------------------------------------
+// Source Row Converters (Bytes)
+// ---------------------------------------------------------
+
+void ConvertG16ToBytes(const uint16* Src, uint8* Dst, int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 16 <= Num; i += 16)
+    {
+        const __m128i Lo = _mm_srli_epi16(_mm_loadu_si128((const __m128i*)(Src + i)), 8);
+        const __m128i Hi = _mm_srli_epi16(_mm_loadu_si128((const __m128i*)(Src + i + 8)), 8);
+        _mm_storeu_si128((__m128i*)(Dst + i), _mm_packus_epi16(Lo, Hi));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 16 <= Num; i += 16)
+    {
+        vst1q_u8(Dst + i, vcombine_u8(vshrn_n_u16(vld1q_u16(Src + i), 8), vshrn_n_u16(vld1q_u16(Src + i + 8), 8)));
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        Dst[i] = (uint8)(Src[i] >> 8);
+    }
+}
+
+void ConvertHalfToBytes(const uint16* Src, uint8* Dst, int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 16 <= Num; i += 16)
+    {
+        _mm_storeu_si128((__m128i*)(Dst + i), TruncateToBytes(
+            ScaleClampTo255(LoadHalf4(Src + i + 0)),
+            ScaleClampTo255(LoadHalf4(Src + i + 4)),
+            ScaleClampTo255(LoadHalf4(Src + i + 8)),
+            ScaleClampTo255(LoadHalf4(Src + i + 12))));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 16 <= Num; i += 16)
+    {
+        vst1q_u8(Dst + i, TruncateToBytes(
+            ScaleClampTo255(LoadHalf4(Src + i + 0)),
+            ScaleClampTo255(LoadHalf4(Src + i + 4)),
+            ScaleClampTo255(LoadHalf4(Src + i + 8)),
+            ScaleClampTo255(LoadHalf4(Src + i + 12))));
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        Dst[i] = (uint8)ScaleClampTo255(LoadHalf(Src + i));
+    }
+}
+
+void ConvertFloatToBytes(const float* Src, uint8* Dst, int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 16 <= Num; i += 16)
+    {
+        _mm_storeu_si128((__m128i*)(Dst + i), TruncateToBytes(
+            ScaleClampTo255(_mm_loadu_ps(Src + i + 0)),
+            ScaleClampTo255(_mm_loadu_ps(Src + i + 4)),
+            ScaleClampTo255(_mm_loadu_ps(Src + i + 8)),
+            ScaleClampTo255(_mm_loadu_ps(Src + i + 12))));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 16 <= Num; i += 16)
+    {
+        vst1q_u8(Dst + i, TruncateToBytes(
+            ScaleClampTo255(vld1q_f32(Src + i + 0)),
+            ScaleClampTo255(vld1q_f32(Src + i + 4)),
+            ScaleClampTo255(vld1q_f32(Src + i + 8)),
+            ScaleClampTo255(vld1q_f32(Src + i + 12))));
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        Dst[i] = (uint8)ScaleClampTo255(Src[i]);
+    }
+}
+
+// ---------------------------------------------------------
+// Source Row Converters (Floats)
+// ---------------------------------------------------------
+
+void ConvertBytesToFloats(const uint8* Src, float* Dst, int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 16 <= Num; i += 16)
+    {
+        const __m128i Bytes = _mm_loadu_si128((const __m128i*)(Src + i));
+        const __m128i Lo = _mm_unpacklo_epi8(Bytes, _mm_setzero_si128());
+        const __m128i Hi = _mm_unpackhi_epi8(Bytes, _mm_setzero_si128());
+        _mm_storeu_ps(Dst + i + 0, _mm_cvtepi32_ps(_mm_unpacklo_epi16(Lo, _mm_setzero_si128())));
+        _mm_storeu_ps(Dst + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(Lo, _mm_setzero_si128())));
+        _mm_storeu_ps(Dst + i + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(Hi, _mm_setzero_si128())));
+        _mm_storeu_ps(Dst + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(Hi, _mm_setzero_si128())));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 16 <= Num; i += 16)
+    {
+        float32x4_t Floats[4];
+        WidenBytesToFloats(vld1q_u8(Src + i), Floats);
+        for (int32 Group = 0; Group < 4; ++Group)
+        {
+            vst1q_f32(Dst + i + Group * 4, Floats[Group]);
+        }
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        Dst[i] = (float)Src[i];
+    }
+}
+
+void ConvertG16ToFloats(const uint16* Src, float* Dst, int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    const __m128 Scale = _mm_set1_ps(1.0f / 256.0f);
+    for (; i + 8 <= Num; i += 8)
+    {
+        const __m128i Words = _mm_loadu_si128((const __m128i*)(Src + i));
+        _mm_storeu_ps(Dst + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Words, _mm_setzero_si128())), Scale));
+        _mm_storeu_ps(Dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Words, _mm_setzero_si128())), Scale));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 8 <= Num; i += 8)
+    {
+        const uint16x8_t Words = vld1q_u16(Src + i);
+        vst1q_f32(Dst + i + 0, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(Words))), 1.0f / 256.0f));
+        vst1q_f32(Dst + i + 4, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(Words))), 1.0f / 256.0f));
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        Dst[i] = (float)Src[i] * (1.0f / 256.0f);
+    }
+}
+
+void ConvertHalfToFloats(const uint16* Src, float* Dst, int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 4 <= Num; i += 4)
+    {
+        _mm_storeu_ps(Dst + i, ScaleClampTo255(LoadHalf4(Src + i)));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 4 <= Num; i += 4)
+    {
+        vst1q_f32(Dst + i, ScaleClampTo255(LoadHalf4(Src + i)));
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        Dst[i] = ScaleClampTo255(LoadHalf(Src + i));
+    }
+}
+
+void ConvertFloatToFloats(const float* Src, float* Dst, int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 4 <= Num; i += 4)
+    {
+        _mm_storeu_ps(Dst + i, ScaleClampTo255(_mm_loadu_ps(Src + i)));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 4 <= Num; i += 4)
+    {
+        vst1q_f32(Dst + i, ScaleClampTo255(vld1q_f32(Src + i)));
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        Dst[i] = ScaleClampTo255(Src[i]);
+    }
+}
+
+// ---------------------------------------------------------
+// Multi-Channel Deinterleave
+// ---------------------------------------------------------
+// Each texel is read once and split into every requested plane, so several slots reading
+// different channels of one source cost a single pass over its memory.
+
+void DeinterleaveBGRA8ToBytes(const uint8* Src, uint8* const Dst[ChannelPackNumSourceChannels], int64 Num)
+{
+    // Bit offset of R, G, B and A inside a little-endian BGRA8 texel
+    static constexpr int32 Shifts[4] = { 16, 8, 0, 24 };
+
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 16 <= Num; i += 16)
+    {
+        const uint8* Texels = Src + i * 4;
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            if (Dst[Channel])
+            {
+                _mm_storeu_si128((__m128i*)(Dst[Channel] + i), _mm_packus_epi16(
+                    LoadBGRA8Component8(Texels, Shifts[Channel]),
+                    LoadBGRA8Component8(Texels + 32, Shifts[Channel])));
+            }
+        }
+        if (Dst[4])
+        {
+            _mm_storeu_si128((__m128i*)(Dst[4] + i), _mm_packus_epi16(LoadBGRA8Luminance8(Texels), LoadBGRA8Luminance8(Texels + 32)));
+        }
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 16 <= Num; i += 16)
+    {
+        // val[0..3] = B, G, R, A
+        const uint8x16x4_t Texels = vld4q_u8(Src + i * 4);
+        const uint8x16_t Planes[4] = { Texels.val[2], Texels.val[1], Texels.val[0], Texels.val[3] };
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            if (Dst[Channel])
+            {
+                vst1q_u8(Dst[Channel] + i, Planes[Channel]);
+            }
+        }
+        if (Dst[4])
+        {
+            vst1q_u8(Dst[4] + i, vcombine_u8(
+                LuminanceOfBytes(vget_low_u8(Planes[0]), vget_low_u8(Planes[1]), vget_low_u8(Planes[2])),
+                LuminanceOfBytes(vget_high_u8(Planes[0]), vget_high_u8(Planes[1]), vget_high_u8(Planes[2]))));
+        }
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        const uint8* Texel = Src + i * 4;
+        if (Dst[0]) Dst[0][i] = Texel[2];
+        if (Dst[1]) Dst[1][i] = Texel[1];
+        if (Dst[2]) Dst[2][i] = Texel[0];
+        if (Dst[3]) Dst[3][i] = Texel[3];
+        if (Dst[4]) Dst[4][i] = LuminanceOfBytes(Texel[2], Texel[1], Texel[0]);
+    }
+}
+
+void DeinterleaveBGRA8ToFloats(const uint8* Src, float* const Dst[ChannelPackNumSourceChannels], int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 4 <= Num; i += 4)
+    {
+        const uint8* Texels = Src + i * 4;
+        const __m128 R = _mm_cvtepi32_ps(LoadBGRA8Component4(Texels, 16));
+        const __m128 G = _mm_cvtepi32_ps(LoadBGRA8Component4(Texels, 8));
+        const __m128 B = _mm_cvtepi32_ps(LoadBGRA8Component4(Texels, 0));
+        if (Dst[0]) _mm_storeu_ps(Dst[0] + i, R);
+        if (Dst[1]) _mm_storeu_ps(Dst[1] + i, G);
+        if (Dst[2]) _mm_storeu_ps(Dst[2] + i, B);
+        if (Dst[3]) _mm_storeu_ps(Dst[3] + i, _mm_cvtepi32_ps(LoadBGRA8Component4(Texels, 24)));
+        if (Dst[4]) _mm_storeu_ps(Dst[4] + i, LuminanceOf(R, G, B));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 16 <= Num; i += 16)
+    {
+        // val[0..3] = B, G, R, A; Planes[Channel][Group] holds 4 values of one channel
+        const uint8x16x4_t Texels = vld4q_u8(Src + i * 4);
+        const uint8x16_t Components[4] = { Texels.val[2], Texels.val[1], Texels.val[0], Texels.val[3] };
+        float32x4_t Planes[4][4];
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            if (Dst[Channel] || (Dst[4] && Channel < 3))
+            {
+                WidenBytesToFloats(Components[Channel], Planes[Channel]);
+            }
+        }
+        for (int32 Group = 0; Group < 4; ++Group)
+        {
+            for (int32 Channel = 0; Channel < 4; ++Channel)
+            {
+                if (Dst[Channel])
+                {
+                    vst1q_f32(Dst[Channel] + i + Group * 4, Planes[Channel][Group]);
+                }
+            }
+            if (Dst[4])
+            {
+                vst1q_f32(Dst[4] + i + Group * 4, LuminanceOf(Planes[0][Group], Planes[1][Group], Planes[2][Group]));
+            }
+        }
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        const uint8* Texel = Src + i * 4;
+        if (Dst[0]) Dst[0][i] = (float)Texel[2];
+        if (Dst[1]) Dst[1][i] = (float)Texel[1];
+        if (Dst[2]) Dst[2][i] = (float)Texel[0];
+        if (Dst[3]) Dst[3][i] = (float)Texel[3];
+        if (Dst[4]) Dst[4][i] = LuminanceOf((float)Texel[2], (float)Texel[1], (float)Texel[0]);
+    }
+}
+
+void DeinterleaveRGBA32FToBytes(const float* Src, uint8* const Dst[ChannelPackNumSourceChannels], int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 16 <= Num; i += 16)
+    {
+        // Planes[Channel][Group] holds 4 values of one channel, unscaled
+        __m128 Planes[ChannelPackNumSourceChannels][4];
+        for (int32 Group = 0; Group < 4; ++Group)
+        {
+            LoadRGBA4(Src + (i + Group * 4) * 4, Planes[0][Group], Planes[1][Group], Planes[2][Group], Planes[3][Group]);
+            Planes[4][Group] = LuminanceOf(Planes[0][Group], Planes[1][Group], Planes[2][Group]);
+        }
+        for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+        {
+            if (Dst[Channel])
+            {
+                _mm_storeu_si128((__m128i*)(Dst[Channel] + i), TruncateToBytes(
+                    ScaleClampTo255(Planes[Channel][0]),
+                    ScaleClampTo255(Planes[Channel][1]),
+                    ScaleClampTo255(Planes[Channel][2]),
+                    ScaleClampTo255(Planes[Channel][3])));
+            }
+        }
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 16 <= Num; i += 16)
+    {
+        float32x4_t Planes[ChannelPackNumSourceChannels][4];
+        for (int32 Group = 0; Group < 4; ++Group)
+        {
+            const float32x4x4_t Texels = vld4q_f32(Src + (i + Group * 4) * 4);
+            for (int32 Channel = 0; Channel < 4; ++Channel)
+            {
+                Planes[Channel][Group] = Texels.val[Channel];
+            }
+            Planes[4][Group] = LuminanceOf(Texels.val[0], Texels.val[1], Texels.val[2]);
+        }
+        for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+        {
+            if (Dst[Channel])
+            {
+                vst1q_u8(Dst[Channel] + i, TruncateToBytes(
+                    ScaleClampTo255(Planes[Channel][0]),
+                    ScaleClampTo255(Planes[Channel][1]),
+                    ScaleClampTo255(Planes[Channel][2]),
+                    ScaleClampTo255(Planes[Channel][3])));
+            }
+        }
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        const float* Texel = Src + i * 4;
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            if (Dst[Channel])
+            {
+                Dst[Channel][i] = (uint8)ScaleClampTo255(Texel[Channel]);
+            }
+        }
+        if (Dst[4])
+        {
+            Dst[4][i] = (uint8)ScaleClampTo255(LuminanceOf(Texel[0], Texel[1], Texel[2]));
+        }
+    }
+}
+
+void DeinterleaveRGBA32FToFloats(const float* Src, float* const Dst[ChannelPackNumSourceChannels], int64 Num)
+{
+    int64 i = 0;
+#if TEXTURECHANNELPACKER_WITH_SSE2
+    for (; i + 4 <= Num; i += 4)
+    {
+        __m128 R, G, B, A;
+        LoadRGBA4(Src + i * 4, R, G, B, A);
+        if (Dst[0]) _mm_storeu_ps(Dst[0] + i, ScaleClampTo255(R));
+        if (Dst[1]) _mm_storeu_ps(Dst[1] + i, ScaleClampTo255(G));
+        if (Dst[2]) _mm_storeu_ps(Dst[2] + i, ScaleClampTo255(B));
+        if (Dst[3]) _mm_storeu_ps(Dst[3] + i, ScaleClampTo255(A));
+        if (Dst[4]) _mm_storeu_ps(Dst[4] + i, ScaleClampTo255(LuminanceOf(R, G, B)));
+    }
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    for (; i + 4 <= Num; i += 4)
+    {
+        const float32x4x4_t Texels = vld4q_f32(Src + i * 4);
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            if (Dst[Channel])
+            {
+                vst1q_f32(Dst[Channel] + i, ScaleClampTo255(Texels.val[Channel]));
+            }
+        }
+        if (Dst[4])
+        {
+            vst1q_f32(Dst[4] + i, ScaleClampTo255(LuminanceOf(Texels.val[0], Texels.val[1], Texels.val[2])));
+        }
+    }
+#endif
+    for (; i < Num; ++i)
+    {
+        const float* Texel = Src + i * 4;
+        for (int32 Channel = 0; Channel < 4; ++Channel)
+        {
+            if (Dst[Channel])
+            {
+                Dst[Channel][i] = ScaleClampTo255(Texel[Channel]);
+            }
+        }
+        if (Dst[4])
+        {
+            Dst[4][i] = ScaleClampTo255(LuminanceOf(Texel[0], Texel[1], Texel[2]));
+        }
+    }
+}
@@ -0,0 +1,343 @@
+#include "TextureChannelPackerMemory.h"
+#include "TextureChannelPackerStats.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePackerMemory, Log, All);
+
+DECLARE_MEMORY_STAT(TEXT("Tracked Memory"), STAT_ChannelPack_TrackedMemory, STATGROUP_TextureChannelPacker);
+DECLARE_MEMORY_STAT(TEXT("Scratch Arena Cached"), STAT_ChannelPack_ScratchCached, STATGROUP_TextureChannelPacker);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scratch Allocations"), STAT_ChannelPack_ScratchAcquired, STATGROUP_TextureChannelPacker);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scratch Reuses"), STAT_ChannelPack_ScratchReused, STATGROUP_TextureChannelPacker);
+
+static TAutoConsoleVariable<int32> CVarChannelPackScratchArenaMB(
+    TEXT("TextureChannelPacker.ScratchArenaMB"),
+    256,
+    TEXT("Most memory in MB the scratch arena keeps in released blocks for reuse by later bands and packs. 0 frees every block when it is released."));
+
+static TAutoConsoleVariable<float> CVarChannelPackScratchArenaIdleSeconds(
+    TEXT("TextureChannelPacker.ScratchArenaIdleSeconds"),
+    10.0f,
+    TEXT("Seconds a released scratch block may stay unused before the scratch arena frees it."));
+
+// ---------------------------------------------------------
+// FChannelPackMemoryTracker
+// ---------------------------------------------------------
+
+FChannelPackMemoryTracker::FChannelPackMemoryTracker()
+    : Parent(&GetGlobal())
+{
+}
+
+FChannelPackMemoryTracker::FChannelPackMemoryTracker(FChannelPackMemoryTracker* InParent)
+    : Parent(InParent)
+{
+}
+
+FChannelPackMemoryTracker::~FChannelPackMemoryTracker()
+{
+    const int64 Leaked = GetCurrentBytes();
+    ensureMsgf(Leaked == 0, TEXT("A channel pack memory tracker is destroyed while still counting %lld bytes"), Leaked);
+    if (Parent && Leaked != 0)
+    {
+        Parent->Remove(Leaked);
+    }
+}
+
+void FChannelPackMemoryTracker::SetParent(FChannelPackMemoryTracker* InParent)
+{
+    check(GetCurrentBytes() == 0);
+    Parent = InParent;
+}
+
+void FChannelPackMemoryTracker::Add(int64 Bytes)
+{
+    const int64 NewBytes = CurrentBytes.fetch_add(Bytes, std::memory_order_relaxed) + Bytes;
+
+    int64 Peak = PeakBytes.load(std::memory_order_relaxed);
+    while (NewBytes > Peak && !PeakBytes.compare_exchange_weak(Peak, NewBytes, std::memory_order_relaxed))
+    {
+    }
+
+    if (Parent)
+    {
+        Parent->Add(Bytes);
+    }
+    else
+    {
+        INC_MEMORY_STAT_BY(STAT_ChannelPack_TrackedMemory, Bytes);
+    }
+}
+
+void FChannelPackMemoryTracker::Remove(int64 Bytes)
+{
+    CurrentBytes.fetch_sub(Bytes, std::memory_order_relaxed);
+    if (Parent)
+    {
+        Parent->Remove(Bytes);
+    }
+    else
+    {
+        DEC_MEMORY_STAT_BY(STAT_ChannelPack_TrackedMemory, Bytes);
+    }
+}
+
+void FChannelPackMemoryTracker::CountAllocation(bool bReused)
+{
+    NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    NumReusedAllocations.fetch_add(bReused ? 1 : 0, std::memory_order_relaxed);
+    if (Parent)
+    {
+        Parent->CountAllocation(bReused);
+    }
+}
+
+FChannelPackMemoryTracker& FChannelPackMemoryTracker::GetGlobal()
+{
+    static FChannelPackMemoryTracker Global(nullptr);
+    return Global;
+}
+
+// ---------------------------------------------------------
+// FChannelPackMemoryCharge
+// ---------------------------------------------------------
+
+FChannelPackMemoryCharge::FChannelPackMemoryCharge(int64 InBytes, FChannelPackMemoryTracker& InTracker)
+    : Bytes(InBytes)
+    , Tracker(&InTracker)
+{
+    Tracker->Add(Bytes);
+}
+
+FChannelPackMemoryCharge::FChannelPackMemoryCharge(FChannelPackMemoryCharge&& Other)
+    : Bytes(Other.Bytes)
+    , Tracker(Other.Tracker)
+{
+    Other.Bytes = 0;
+    Other.Tracker = nullptr;
+}
+
+FChannelPackMemoryCharge& FChannelPackMemoryCharge::operator=(FChannelPackMemoryCharge&& Other)
+{
+    if (this != &Other)
+    {
+        Reset();
+        Bytes = Other.Bytes;
+        Tracker = Other.Tracker;
+        Other.Bytes = 0;
+        Other.Tracker = nullptr;
+    }
+    return *this;
+}
+
+void FChannelPackMemoryCharge::Reset()
+{
+    if (Tracker)
+    {
+        Tracker->Remove(Bytes);
+    }
+    Bytes = 0;
+    Tracker = nullptr;
+}
+
+// ---------------------------------------------------------
+// FChannelPackScratchArena
+// ---------------------------------------------------------
+
+FChannelPackScratchArena& FChannelPackScratchArena::Get()
+{
+    // The arena charges its cached blocks to the global tracker, which must therefore outlive it
+    FChannelPackMemoryTracker::GetGlobal();
+    static FChannelPackScratchArena Arena;
+    return Arena;
+}
+
+int64 FChannelPackScratchArena::GetSizeClass(int64 NumBytes)
+{
+    if (NumBytes <= MinSizeClass)
+    {
+        return MinSizeClass;
+    }
+
+    // Four classes per power of two: (4, 8] KB is served by 5, 6, 7 and 8 KB blocks, (8, 16] KB by 10, 12, 14 and 16 KB, ...
+    const int64 Step = (int64)1 << (FMath::FloorLog2_64((uint64)NumBytes - 1) - 2);
+    return Align(NumBytes, Step);
+}
+
+FChannelPackScratchArena::~FChannelPackScratchArena()
+{
+    Trim(0.0);
+}
+
+uint8* FChannelPackScratchArena::Acquire(int64 SizeClass, bool& bOutReused)
+{
+    check(SizeClass == GetSizeClass(SizeClass));
+    INC_DWORD_STAT(STAT_ChannelPack_ScratchAcquired);
+    {
+        FScopeLock ScopeLock(&Lock);
+        ++Stats.NumAcquired;
+
+        TArray<FFreeBlock>* Blocks = FreeBlocks.Find(SizeClass);
+        if (Blocks && Blocks->Num() > 0)
+        {
+            uint8* Data = Blocks->Pop(EAllowShrinking::No).Data;
+            ++Stats.NumReused;
+            Stats.CachedBytes -= SizeClass;
+            FChannelPackMemoryTracker::GetGlobal().Remove(SizeClass);
+            DEC_MEMORY_STAT_BY(STAT_ChannelPack_ScratchCached, SizeClass);
+            INC_DWORD_STAT(STAT_ChannelPack_ScratchReused);
+            bOutReused = true;
+            return Data;
+        }
+    }
+
+    bOutReused = false;
+    return (uint8*)FMemory::Malloc(SizeClass, Alignment);
+}
+
+void FChannelPackScratchArena::Release(uint8* Data, int64 SizeClass)
+{
+    const int64 MaxCachedBytes = (int64)FMath::Max(0, CVarChannelPackScratchArenaMB.GetValueOnAnyThread()) * 1024 * 1024;
+    const double IdleSeconds = CVarChannelPackScratchArenaIdleSeconds.GetValueOnAnyThread();
+    const double Now = FPlatformTime::Seconds();
+    {
+        FScopeLock ScopeLock(&Lock);
+
+        // Blocks of sizes the current packs no longer use are trimmed as the packs go
+        if (Now - LastTrimTime >= IdleSeconds)
+        {
+            TrimLocked(Now - IdleSeconds);
+        }
+
+        if (Stats.CachedBytes + SizeClass <= MaxCachedBytes)
+        {
+            FreeBlocks.FindOrAdd(SizeClass).Add({ Data, Now });
+            Stats.CachedBytes += SizeClass;
+            FChannelPackMemoryTracker::GetGlobal().Add(SizeClass);
+            Stats.PeakCachedBytes = FMath::Max(Stats.PeakCachedBytes, Stats.CachedBytes);
+            INC_MEMORY_STAT_BY(STAT_ChannelPack_ScratchCached, SizeClass);
+            return;
+        }
+        ++Stats.NumFreed;
+    }
+
+    FMemory::Free(Data);
+}
+
+void FChannelPackScratchArena::Trim(double MaxIdleSeconds)
+{
+    FScopeLock ScopeLock(&Lock);
+    TrimLocked(MaxIdleSeconds > 0.0 ? FPlatformTime::Seconds() - MaxIdleSeconds : DBL_MAX);
+}
+
+void FChannelPackScratchArena::TrimIdle()
+{
+    Trim(FMath::Max(0.001, (double)CVarChannelPackScratchArenaIdleSeconds.GetValueOnAnyThread()));
+}
+
+void FChannelPackScratchArena::TrimLocked(double OlderThan)
+{
+    LastTrimTime = FPlatformTime::Seconds();
+    for (auto It = FreeBlocks.CreateIterator(); It; ++It)
+    {
+        // Every free list is ordered by release time, oldest first
+        TArray<FFreeBlock>& Blocks = It.Value();
+        int32 NumIdle = 0;
+        while (NumIdle < Blocks.Num() && Blocks[NumIdle].ReleaseTime < OlderThan)
+        {
+            FMemory::Free(Blocks[NumIdle].Data);
+            ++NumIdle;
+        }
+
+        if (NumIdle > 0)
+        {
+            Blocks.RemoveAt(0, NumIdle);
+            Stats.NumFreed += NumIdle;
+            Stats.CachedBytes -= It.Key() * NumIdle;
+            FChannelPackMemoryTracker::GetGlobal().Remove(It.Key() * NumIdle);
+            DEC_MEMORY_STAT_BY(STAT_ChannelPack_ScratchCached, It.Key() * NumIdle);
+        }
+        if (Blocks.Num() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+FChannelPackScratchArenaStats FChannelPackScratchArena::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Stats;
+}
+
+static void RunScratchArenaCommand(const TArray<FString>& Args)
+{
+    FChannelPackScratchArena& Arena = FChannelPackScratchArena::Get();
+    if (Args.Num() > 0 && Args[0].Equals(TEXT("Trim"), ESearchCase::IgnoreCase))
+    {
+        Arena.Trim(0.0);
+    }
+
+    const FChannelPackScratchArenaStats Stats = Arena.GetStats();
+    UE_LOG(LogTexturePackerMemory, Display, TEXT("Scratch arena: %lld allocations, %.1f%% reused, %lld blocks freed, %.1f MB cached (peak %.1f MB)"),
+        Stats.NumAcquired, Stats.GetReuseRate() * 100.0, Stats.NumFreed,
+        Stats.CachedBytes / (1024.0 * 1024.0), Stats.PeakCachedBytes / (1024.0 * 1024.0));
+}
+
+static FAutoConsoleCommand GScratchArenaCommand(
+    TEXT("TextureChannelPacker.ScratchArena"),
+    TEXT("Logs the allocation count, reuse rate and cached memory of the scratch arena. Usage: TextureChannelPacker.ScratchArena [Trim]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&RunScratchArenaCommand));
+
+// ---------------------------------------------------------
+// FChannelPackTrackedBuffer
+// ---------------------------------------------------------
+
+FChannelPackTrackedBuffer::FChannelPackTrackedBuffer(FChannelPackTrackedBuffer&& Other)
+    : Data(Other.Data)
+    , NumBytes(Other.NumBytes)
+    , Charge(MoveTemp(Other.Charge))
+{
+    Other.Data = nullptr;
+    Other.NumBytes = 0;
+}
+
+FChannelPackTrackedBuffer& FChannelPackTrackedBuffer::operator=(FChannelPackTrackedBuffer&& Other)
+{
+    if (this != &Other)
+    {
+        Reset();
+        Data = Other.Data;
+        NumBytes = Other.NumBytes;
+        Charge = MoveTemp(Other.Charge);
+        Other.Data = nullptr;
+        Other.NumBytes = 0;
+    }
+    return *this;
+}
+
+void FChannelPackTrackedBuffer::Allocate(int64 InNumBytes, FChannelPackMemoryTracker& Tracker)
+{
+    Reset();
+    if (InNumBytes > 0)
+    {
+        const int64 SizeClass = FChannelPackScratchArena::GetSizeClass(InNumBytes);
+        bool bReused = false;
+        Data = FChannelPackScratchArena::Get().Acquire(SizeClass, bReused);
+        NumBytes = InNumBytes;
+        Charge = FChannelPackMemoryCharge(SizeClass, Tracker);
+        Tracker.CountAllocation(bReused);
+    }
+}
+
+void FChannelPackTrackedBuffer::Reset()
+{
+    if (Data)
+    {
+        FChannelPackScratchArena::Get().Release(Data, Charge.GetBytes());
+        Data = nullptr;
+    }
+    NumBytes = 0;
+    Charge.Reset();
+}
@@ -0,0 +1,195 @@
+#include "TextureChannelPackerResampler.h"
+#include "Math/UnrealMathUtility.h"
+
+// ---------------------------------------------------------
+// Filter Kernels
+// ---------------------------------------------------------
+
+/** Half-width of each filter's kernel, in source samples at a scale of 1. */
+static double GetFilterRadius(ETextureResizeFilter Filter)
+{
+    switch (Filter)
+    {
+    case ETextureResizeFilter::Box:        return 0.5;
+    case ETextureResizeFilter::Bilinear:   return 1.0;
+    case ETextureResizeFilter::Mitchell:   return 2.0;
+    case ETextureResizeFilter::CatmullRom: return 2.0;
+    case ETextureResizeFilter::Lanczos3:   return 3.0;
+    default:                               return 1.0;
+    }
+}
+
+/** Mitchell-Netravali family of cubic filters, parameterized by B and C. */
+static double EvaluateCubic(double X, double B, double C)
+{
+    X = FMath::Abs(X);
+    if (X < 1.0)
+    {
+        return ((12.0 - 9.0 * B - 6.0 * C) * X * X * X + (-18.0 + 12.0 * B + 6.0 * C) * X * X + (6.0 - 2.0 * B)) / 6.0;
+    }
+    if (X < 2.0)
+    {
+        return ((-B - 6.0 * C) * X * X * X + (6.0 * B + 30.0 * C) * X * X + (-12.0 * B - 48.0 * C) * X + (8.0 * B + 24.0 * C)) / 6.0;
+    }
+    return 0.0;
+}
+
+static double EvaluateSinc(double X)
+{
+    if (FMath::Abs(X) < 1e-8)
+    {
+        return 1.0;
+    }
+    const double PiX = UE_DOUBLE_PI * X;
+    return FMath::Sin(PiX) / PiX;
+}
+
+/** Evaluates the filter kernel at distance X (in source samples at a scale of 1). */
+static double EvaluateFilter(ETextureResizeFilter Filter, double X)
+{
+    switch (Filter)
+    {
+    case ETextureResizeFilter::Box:
+        // Half-open interval so a sample exactly on a footprint edge is only counted once
+        return (X >= -0.5 && X < 0.5) ? 1.0 : 0.0;
+    case ETextureResizeFilter::Bilinear:
+        return FMath::Max(0.0, 1.0 - FMath::Abs(X));
+    case ETextureResizeFilter::Mitchell:
+        return EvaluateCubic(X, 1.0 / 3.0, 1.0 / 3.0);
+    case ETextureResizeFilter::CatmullRom:
+        return EvaluateCubic(X, 0.0, 0.5);
+    case ETextureResizeFilter::Lanczos3:
+        return FMath::Abs(X) < 3.0 ? EvaluateSinc(X) * EvaluateSinc(X / 3.0) : 0.0;
+    default:
+        return 0.0;
+    }
+}
+
+// ---------------------------------------------------------
+// FResampleAxis
+// ---------------------------------------------------------
+
+void FResampleAxis::Build(int32 SrcSize, int32 DstSize, ETextureResizeFilter Filter)
+{
+    check(SrcSize > 0 && DstSize > 0);
+
+    if (SrcSize == DstSize)
+    {
+        bIdentity = true;
+        MaxTaps = 1;
+        First.SetNumUninitialized(DstSize);
+        Count.SetNumUninitialized(DstSize);
+        Weights.SetNumUninitialized(DstSize);
+        for (int32 D = 0; D < DstSize; ++D)
+        {
+            First[D] = D;
+            Count[D] = 1;
+            Weights[D] = 1.0f;
+        }
+        return;
+    }
+
+    bIdentity = false;
+
+    // Widen the kernel when downscaling so that it covers the whole destination footprint
+    const double Scale = (double)SrcSize / (double)DstSize;
+    const double FilterScale = FMath::Max(Scale, 1.0);
+    const double InvFilterScale = 1.0 / FilterScale;
+    const double Support = GetFilterRadius(Filter) * FilterScale;
+
+    MaxTaps = FMath::CeilToInt(Support) * 2 + 1;
+    First.SetNumUninitialized(DstSize);
+    Count.SetNumUninitialized(DstSize);
+    Weights.SetNumZeroed(DstSize * MaxTaps);
+
+    for (int32 D = 0; D < DstSize; ++D)
+    {
+        const double Center = (D + 0.5) * Scale;
+        // Start at the first sample whose center reaches Center - Support, since the half-open Box
+        // footprint counts a sample exactly on its lower edge
+        const int32 Begin = FMath::Max(FMath::CeilToInt(Center - Support - 0.5), 0);
+        const int32 End = FMath::Min(FMath::FloorToInt(Center + Support + 0.5), SrcSize);
+        const int32 NumTaps = FMath::Clamp(End - Begin, 1, MaxTaps);
+
+        float* SampleWeights = Weights.GetData() + D * MaxTaps;
+        double WeightSum = 0.0;
+        for (int32 T = 0; T < NumTaps; ++T)
+        {
+            const double Weight = EvaluateFilter(Filter, (Begin + T - Center + 0.5) * InvFilterScale);
+            SampleWeights[T] = (float)Weight;
+            WeightSum += Weight;
+        }
+
+        if (FMath::Abs(WeightSum) > 1e-8)
+        {
+            for (int32 T = 0; T < NumTaps; ++T)
+            {
+                SampleWeights[T] = (float)(SampleWeights[T] / WeightSum);
+            }
+        }
+        else
+        {
+            // Degenerate footprint (can only happen at the very edge): fall back to the nearest sample
+            FMemory::Memzero(SampleWeights, sizeof(float) * MaxTaps);
+            SampleWeights[FMath::Clamp(FMath::FloorToInt(Center) - Begin, 0, NumTaps - 1)] = 1.0f;
+        }
+
+        First[D] = FMath::Min(Begin, SrcSize - 1);
+        Count[D] = FMath::Min(NumTaps, SrcSize - First[D]);
+    }
+}
+
+void FResampleAxis::GetSourceRange(int32 DstBegin, int32 DstEnd, int32& OutSrcBegin, int32& OutSrcEnd) const
+{
+    check(DstBegin < DstEnd);
+
+    OutSrcBegin = First[DstBegin];
+    OutSrcEnd = First[DstBegin] + Count[DstBegin];
+    for (int32 D = DstBegin + 1; D < DstEnd; ++D)
+    {
+        OutSrcBegin = FMath::Min(OutSrcBegin, First[D]);
+        OutSrcEnd = FMath::Max(OutSrcEnd, First[D] + Count[D]);
+    }
+}
+
+// ---------------------------------------------------------
+// Row Kernels
+// ---------------------------------------------------------
+
+void AccumulateWeightedRow(const float* Row, float Weight, float* Accumulator, int32 Num)
+{
+    for (int32 X = 0; X < Num; ++X)
+    {
+        Accumulator[X] += Weight * Row[X];
+    }
+}
+
+void QuantizeRowToBytes(const float* Row, uint8* OutRow, int32 Num)
+{
+    for (int32 X = 0; X < Num; ++X)
+    {
+        OutRow[X] = (uint8)FMath::Clamp<int32>((int32)(Row[X] + 0.5f), 0, 255);
+    }
+}
+
+// ---------------------------------------------------------
+// Source Mips
+// ---------------------------------------------------------
+
+int32 FindChannelPackSourceMipOfSize(int32 Mip0Width, int32 Mip0Height, int32 NumMips, int32 Width, int32 Height)
+{
+    for (int32 Mip = 1; Mip < NumMips; ++Mip)
+    {
+        const int32 MipWidth = FMath::Max(1, Mip0Width >> Mip);
+        const int32 MipHeight = FMath::Max(1, Mip0Height >> Mip);
+        if (MipWidth == Width && MipHeight == Height)
+        {
+            return Mip;
+        }
+        if (MipWidth < Width || MipHeight < Height)
+        {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TextureChannelPackerEngine.h"
+
+/**
+ * @struct FChannelPackBenchmarkSuiteSettings
+ * @brief What RunChannelPackBenchmarkSuite measures and where it writes the results.
+ */
+struct FChannelPackBenchmarkSuiteSettings
+{
+    /** Source sizes to measure. Empty measures 256, 1024, 2048, 4096 and 8192 squares plus 2048 x 512 and 512 x 2048. */
+    TArray<FIntPoint> Sizes;
+
+    /** Timed runs per case after one warm-up run. The fastest run is reported. */
+    int32 Iterations = 3;
+
+    /** Results file, written as JSON if the extension is .json and as CSV otherwise. Empty writes no file. */
+    FString OutputPath;
+
+    /** CSV results of an earlier run to compare against. Empty skips the comparison. */
+    FString BaselinePath;
+
+    /** A case regresses when its throughput is more than this many percent below the baseline's. */
+    double RegressionThresholdPercent = 10.0;
+};
+
+/**
+ * @struct FChannelPackBenchmarkResult
+ * @brief The measurement of one case (source format, path and size) of the suite.
+ */
+struct FChannelPackBenchmarkResult
+{
+    /** Unique key of the case, e.g. "BGRA8_Resize_4096x4096". Used to match baseline rows. */
+    FString Case;
+
+    EChannelPackSourceFormat Format = EChannelPackSourceFormat::Invalid;
+
+    /** SameSize, Resize, Invert, Missing, TwoInputs or Pipelined (see RunChannelPackBenchmarkSuite). */
+    FString Path;
+
+    /** Source size. */
+    int32 Width = 0;
+    int32 Height = 0;
+
+    /** Fastest PackChannelsToBGRA8 call. */
+    double Seconds = 0.0;
+
+    /**
+     * CPU seconds of the convert, resize and interleave stages of the fastest call, summed over the
+     * worker threads (FChannelPackControl), so they can exceed Seconds.
+     */
+    double ConvertSeconds = 0.0;
+    double ResizeSeconds = 0.0;
+    double InterleaveSeconds = 0.0;
+
+    /** Source megapixels packed per second. */
+    double MegapixelsPerSecond = 0.0;
+
+    /** High-water mark of the case's memory tracker: source, output and the engine's scratch buffers. */
+    int64 PeakTrackedBytes = 0;
+
+    /** Throughput of the same case in the baseline, or 0 if it has none. */
+    double BaselineMegapixelsPerSecond = 0.0;
+
+    /** The case is slower than the baseline by more than the regression threshold. */
+    bool bRegressed = false;
+};
+
+/**
+ * @brief Packs synthetic sources of every supported format and size through every engine path and times them.
+ *
+ * Each source is filled with deterministic noise (so no channel is detected as uniform) and packed
+ * through six paths: SameSize (every slot reads the source, no resize), Resize (the same, downscaled
+ * to half size with the Bilinear filter), Invert (SameSize with every slot inverted), Missing (only R
+ * has a source), TwoInputs (R and G read the source, B and A a copy of it) and Pipelined (the same
+ * inputs packed in the stages of a pipelined job, one FChannelPackStagedPack stage per input).
+ * Results are logged, optionally written to Settings.OutputPath and compared with Settings.BaselinePath.
+ *
+ * @param OutResults One entry per case, in the order measured.
+ * @param OutError Why the suite failed: a file could not be read or written, or cases regressed.
+ * @return false if a case regressed against the baseline or a file could not be read or written.
+ */
+TEXTURECHANNELPACKERCORE_API bool RunChannelPackBenchmarkSuite(const FChannelPackBenchmarkSuiteSettings& Settings, TArray<FChannelPackBenchmarkResult>& OutResults, FString& OutError);
+
+/**
+ * @brief Reads suite settings from command-line style parameters.
+ *
+ * -Sizes=256,1024,2048x512 (a single number is a square), -Iterations=N, -Output=<Results.csv|.json>,
+ * -Baseline=<Results.csv>, -Threshold=<Percent>. Missing parameters keep their defaults.
+ *
+ * @return false with OutError set if a value is invalid.
+ */
+TEXTURECHANNELPACKERCORE_API bool ParseChannelPackBenchmarkSuiteSettings(const TCHAR* Params, FChannelPackBenchmarkSuiteSettings& OutSettings, FString& OutError);
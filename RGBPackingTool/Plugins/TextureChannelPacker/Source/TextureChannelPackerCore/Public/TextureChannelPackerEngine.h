@@ -0,0 +1,252 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TextureChannelPackerTypes.h"
+#include "TextureChannelPackerMemory.h"
+#include <atomic>
+
+/** Number of output rows processed by one packing work item. Small enough to keep the per-band scratch in cache. */
+static constexpr int32 ChannelPackBandHeight = 16;
+
+/**
+ * @enum EChannelPackSourceFormat
+ * @brief The source pixel layouts the engine can read.
+ *
+ * Mirrors the supported subset of ETextureSourceFormat, which belongs to the Engine module; the
+ * editor module converts with GetChannelPackSourceFormat.
+ */
+enum class EChannelPackSourceFormat : uint8
+{
+    /** No source, or a format the engine cannot read. */
+    Invalid,
+
+    /** 8-bit grayscale (TSF_G8). */
+    G8,
+
+    /** 8-bit BGRA (TSF_BGRA8). */
+    BGRA8,
+
+    /** 16-bit unsigned grayscale (TSF_G16). */
+    G16,
+
+    /** 16-bit float, one channel (TSF_R16F). */
+    R16F,
+
+    /** 32-bit float, one channel (TSF_R32F). */
+    R32F,
+
+    /** 32-bit float RGBA (TSF_RGBA32F). */
+    RGBA32F,
+};
+
+/**
+ * @struct FChannelPackSource
+ * @brief A read-only view of one source texture's pixel data.
+ *
+ * The view does not own the pixels; the caller must keep the backing memory alive
+ * until packing has finished. A null Data pointer means "no source" for the channel.
+ */
+struct FChannelPackSource
+{
+    /** Pointer to the first byte of the top-left pixel. Rows are tightly packed. */
+    const uint8* Data = nullptr;
+
+    /** Source width in pixels. */
+    int32 Width = 0;
+
+    /** Source height in pixels. */
+    int32 Height = 0;
+
+    /** The pixel layout of Data. */
+    EChannelPackSourceFormat Format = EChannelPackSourceFormat::Invalid;
+
+    /** @return true if the view points at pixel data that can be packed. */
+    bool IsValid() const { return Data != nullptr && Width > 0 && Height > 0; }
+};
+
+/**
+ * @struct FChannelPackDesc
+ * @brief Describes how a single output channel (R, G, B or A) is produced.
+ */
+struct FChannelPackDesc
+{
+    /** The source pixels for this channel. If invalid, DefaultValue is written instead. */
+    FChannelPackSource Source;
+
+    /** Which channel of Source is read. Ignored for single-channel formats (G8, G16, R16F, R32F). */
+    ETextureSourceChannel SourceChannel = ETextureSourceChannel::Red;
+
+    /** Value written when the channel has no source (0 for RGB, 255 for Alpha). */
+    uint8 DefaultValue = 0;
+
+    /** If true, the channel is written as (255 - Value). Also applies to DefaultValue. */
+    bool bInvert = false;
+
+    /**
+     * Optional: the channel already converted and resized to the output size (Width * Height bytes,
+     * before inversion), e.g. fetched from the plane cache. When set, Source is not read.
+     */
+    const uint8* CachedPlane = nullptr;
+
+    /**
+     * Optional: receives the converted and resized channel (Width * Height bytes, before inversion),
+     * e.g. to store it in the plane cache. Each band writes its own rows.
+     */
+    uint8* CapturePlane = nullptr;
+
+    /**
+     * If true, this channel of the output is left as it is and nothing else in the description is
+     * used. Lets a pack write the output in several passes, e.g. one source texture at a time.
+     */
+    bool bPreserveOutput = false;
+};
+
+/**
+ * @struct FChannelPackControl
+ * @brief Cancellation and progress state shared between a running pack and the thread that started it.
+ *
+ * The pack checks for cancellation before every band and counts completed bands, so any thread can
+ * cancel it or poll its progress while it runs. An instance must outlive the pack it is passed to.
+ */
+struct FChannelPackControl
+{
+    /** Asks the running pack to stop. Bands already in flight finish; no new band is started. */
+    void Cancel() { bCancelRequested.store(true, std::memory_order_relaxed); }
+
+    /** @return true once Cancel() has been called. */
+    bool IsCancelRequested() const { return bCancelRequested.load(std::memory_order_relaxed); }
+
+    /** @return The fraction of bands written so far, from 0 to 1. */
+    float GetProgress() const
+    {
+        const int32 Total = TotalBands.load(std::memory_order_relaxed);
+        return Total > 0 ? (float)CompletedBands.load(std::memory_order_relaxed) / (float)Total : 0.0f;
+    }
+
+    /** Number of bands in the pack. Set by the pack when it starts. */
+    std::atomic<int32> TotalBands{0};
+
+    /** Number of bands written so far. */
+    std::atomic<int32> CompletedBands{0};
+
+    /**
+     * CPU time of each stage in FPlatformTime cycles, summed over all threads and over every pack
+     * given this control. Convert reads source rows into 8-bit or float values, Resize filters them
+     * and Interleave writes the output (including inversion and constant channels).
+     */
+    std::atomic<uint64> ConvertCycles{0};
+    std::atomic<uint64> ResizeCycles{0};
+    std::atomic<uint64> InterleaveCycles{0};
+
+    /** Source bytes read (cached planes included) and output bytes written, summed over every pack given this control. */
+    std::atomic<uint64> SourceBytesRead{0};
+    std::atomic<uint64> OutputBytesWritten{0};
+
+    /** Counts the scratch buffers of the pack, e.g. the tracker of the job. Null counts them in the global tracker only. */
+    FChannelPackMemoryTracker* Memory = nullptr;
+
+private:
+    std::atomic<bool> bCancelRequested{false};
+};
+
+/**
+ * @brief Returns whether the packing engine can read the given source format.
+ *
+ * @param Format The source format to test.
+ * @return true for every format but EChannelPackSourceFormat::Invalid.
+ */
+TEXTURECHANNELPACKERCORE_API bool IsChannelPackSourceFormatSupported(EChannelPackSourceFormat Format);
+
+/**
+ * @brief Returns the name of a format as used in logs and reports, e.g. TEXT("BGRA8").
+ */
+TEXTURECHANNELPACKERCORE_API const TCHAR* GetChannelPackSourceFormatName(EChannelPackSourceFormat Format);
+
+/**
+ * @brief Returns the size of one texel of a supported format, or 0 for EChannelPackSourceFormat::Invalid.
+ */
+TEXTURECHANNELPACKERCORE_API int32 GetChannelPackSourceBytesPerPixel(EChannelPackSourceFormat Format);
+
+/**
+ * @brief Returns whether a supported format stores a single value per texel (any channel selection reads that value).
+ */
+TEXTURECHANNELPACKERCORE_API bool IsSingleChannelFormat(EChannelPackSourceFormat Format);
+
+/**
+ * @brief Returns the number of threads a pack uses by default (task graph workers plus the calling thread).
+ */
+TEXTURECHANNELPACKERCORE_API int32 GetChannelPackMaxThreads();
+
+/**
+ * @brief Packs four channel descriptions into an interleaved BGRA8 image in a single pass.
+ *
+ * The output is processed in horizontal bands that worker threads pull from a shared queue, so even
+ * a single input channel is spread over every core. For every band, each channel is
+ * converted and resized with the separable Filter (if its source size differs from the target) into a
+ * small per-band buffer, then inverted while being interleaved straight into OutBGRA. No full-resolution
+ * intermediate planes are allocated, so peak memory stays close to the size of the sources plus the output.
+ *
+ * Channels with a CachedPlane read it instead of their source; channels with a CapturePlane
+ * also write their resized rows there. Channels with bPreserveOutput are not written at all.
+ *
+ * Channels whose sources are the same pixels (same Data pointer, size and format) are read in a single
+ * pass per band that splits out every requested source channel. Channels that request the same source
+ * channel share the decoded and resampled plane; inversion is applied per channel while interleaving.
+ *
+ * Missing channels and source channels with the same value in every texel are constant: they are
+ * not resized and have no band plane, and the interleave writes their (inverted) value directly.
+ *
+ * @param Channels The R, G, B and A channel descriptions, in that order.
+ * @param Width The output width in pixels.
+ * @param Height The output height in pixels.
+ * @param Filter The reconstruction filter used for channels that need resizing.
+ * @param OutBGRA Destination buffer of at least Width * Height * 4 bytes (e.g., a locked Source mip).
+ * @param MaxThreads Maximum number of threads working on the pack at once. 0 uses GetChannelPackMaxThreads().
+ * @param Control Optional cancellation and progress state, checked and updated once per band.
+ * @return false if the pack was cancelled through Control, in which case OutBGRA is only partially written.
+ */
+TEXTURECHANNELPACKERCORE_API bool PackChannelsToBGRA8(const FChannelPackDesc (&Channels)[4], int32 Width, int32 Height, ETextureResizeFilter Filter, uint8* OutBGRA, int32 MaxThreads = 0, FChannelPackControl* Control = nullptr);
+
+struct FChannelPackStagedPackState;
+
+/**
+ * @class FChannelPackStagedPack
+ * @brief A pack written by several stages that run at the same time, e.g. one per source texture as soon as it is extracted.
+ *
+ * Every output channel is written by exactly one stage (PackStage). A stage converts and resizes its
+ * channels band by band into full planes: their CapturePlane, or a plane the staged pack allocates.
+ * Constant, cached and missing channels need no plane, and a channel that reads the same source
+ * channel as an earlier channel of its stage reads that channel's plane. Each band of the output is
+ * interleaved, all four channels at once with the vector kernel, by the stage that produces its rows
+ * last, so the output is written while the other stages are still running. The result is the same as
+ * PackChannelsToBGRA8 with all four channels.
+ */
+class TEXTURECHANNELPACKERCORE_API FChannelPackStagedPack
+{
+public:
+    /**
+     * @param Width The output width in pixels.
+     * @param Height The output height in pixels.
+     * @param Filter The reconstruction filter used for channels that need resizing.
+     * @param OutBGRA Destination buffer of at least Width * Height * 4 bytes. Must outlive every stage.
+     * @param NumStages Number of PackStage calls that write the output.
+     */
+    FChannelPackStagedPack(int32 Width, int32 Height, ETextureResizeFilter Filter, uint8* OutBGRA, int32 NumStages);
+    ~FChannelPackStagedPack();
+
+    /**
+     * @brief Runs one stage: produces the channels that are not bPreserveOutput and interleaves the bands it completes last.
+     *
+     * Stages may run on several threads at once; each calls PackStage once. Its channel descriptions
+     * and their sources are read until it returns, and its planes until every stage has returned.
+     *
+     * @param Channels The R, G, B and A channel descriptions; the channels of other stages have bPreserveOutput set.
+     * @param MaxThreads Maximum number of threads working on the stage at once. 0 uses GetChannelPackMaxThreads().
+     * @param Control Optional cancellation and progress state. Its CompletedBands counts interleaved bands.
+     * @return false if the stage was cancelled through Control, in which case the bands it did not produce are never interleaved.
+     */
+    bool PackStage(const FChannelPackDesc (&Channels)[4], int32 MaxThreads = 0, FChannelPackControl* Control = nullptr);
+
+private:
+    TUniquePtr<FChannelPackStagedPackState> State;
+};
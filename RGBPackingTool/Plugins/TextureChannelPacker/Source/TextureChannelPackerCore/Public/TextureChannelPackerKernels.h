@@ -0,0 +1,145 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TextureChannelPackerTypes.h"
+
+// ---------------------------------------------------------
+// SIMD Instruction Set Selection
+// ---------------------------------------------------------
+// SSE2 is part of the x64 baseline. AVX2 is only used when the target is compiled with it as the
+// minimum instruction set (PLATFORM_ALWAYS_HAS_AVX_2), so no runtime CPU dispatch is needed.
+// NEON is part of the arm64 baseline. Every kernel also has a scalar fallback.
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+    #define TEXTURECHANNELPACKER_WITH_SSE2 1
+    #define TEXTURECHANNELPACKER_WITH_AVX2 PLATFORM_ALWAYS_HAS_AVX_2
+#else
+    #define TEXTURECHANNELPACKER_WITH_SSE2 0
+    #define TEXTURECHANNELPACKER_WITH_AVX2 0
+#endif
+
+// F16C (hardware half-to-float) ships with every AVX2 CPU, but compilers only accept the intrinsics
+// when the target enables it. Without it, halves are widened with an SSE2 bit-manipulation sequence.
+#if TEXTURECHANNELPACKER_WITH_SSE2 && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+    #define TEXTURECHANNELPACKER_WITH_F16C 1
+#else
+    #define TEXTURECHANNELPACKER_WITH_F16C 0
+#endif
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_CPU_ARM_FAMILY
+    #define TEXTURECHANNELPACKER_WITH_NEON 1
+#else
+    #define TEXTURECHANNELPACKER_WITH_NEON 0
+#endif
+
+/**
+ * @brief Interleaves four planar 8-bit channels into BGRA8 pixels.
+ *
+ * Uses AVX2, SSE2 or NEON when available (32/16 pixels per iteration) and a scalar loop for the tail.
+ * The planes and the output may have any alignment.
+ *
+ * @param R Red plane, Num bytes.
+ * @param G Green plane, Num bytes.
+ * @param B Blue plane, Num bytes.
+ * @param A Alpha plane, Num bytes.
+ * @param OutBGRA Destination, Num * 4 bytes.
+ * @param Num Number of pixels.
+ */
+TEXTURECHANNELPACKERCORE_API void InterleavePlanarToBGRA8(const uint8* R, const uint8* G, const uint8* B, const uint8* A, uint8* OutBGRA, int64 Num);
+
+/**
+ * @brief Writes one planar 8-bit channel into BGRA8 pixels, leaving the other three bytes of every pixel untouched.
+ *
+ * Used by packs that write the output in several passes, and by the stages of a pipelined pass, which
+ * write different channels of the same pixels at the same time. It must therefore store single bytes
+ * only and never read-modify-write the other bytes of a pixel.
+ *
+ * @param Plane Source plane, Num bytes.
+ * @param OutBGRA Destination, Num * 4 bytes.
+ * @param ByteOffset Byte of the pixel to write: 0 for B, 1 for G, 2 for R, 3 for A.
+ * @param Num Number of pixels.
+ * @param bInvert Writes 255 - Plane instead of the plane.
+ */
+TEXTURECHANNELPACKERCORE_API void WritePlaneToBGRA8Channel(const uint8* Plane, uint8* OutBGRA, int32 ByteOffset, int64 Num, bool bInvert = false);
+
+/** Signature of the interleave kernels returned by GetInterleaveBGRA8Kernel. */
+using FInterleaveBGRA8Kernel = void (*)(const uint8* const Planes[4], const uint8 (&Constants)[4], uint8* OutBGRA, int64 Num);
+
+/**
+ * @brief Returns the interleave kernel compiled for one combination of inverted and constant channels.
+ *
+ * Every combination has its own instantiation of the InterleavePlanarToBGRA8 loops, so the per-pixel
+ * loop has no branches: inverted channels cost one vector XOR and constant channels load nothing.
+ * Meant to be called once per pack. The kernel reads Planes[Channel] (Num bytes) for every channel
+ * that is not constant, and Constants[Channel], written as given, for every channel that is.
+ *
+ * @param InvertMask Bit N set: channel N (0 = R, 1 = G, 2 = B, 3 = A) is written as 255 - Plane.
+ * @param ConstantMask Bit N set: channel N is written as Constants[N]. Takes precedence over InvertMask.
+ */
+TEXTURECHANNELPACKERCORE_API FInterleaveBGRA8Kernel GetInterleaveBGRA8Kernel(uint32 InvertMask, uint32 ConstantMask);
+
+/**
+ * @brief Writes the same value into one byte of every BGRA8 pixel, leaving the other three bytes untouched.
+ *
+ * The constant counterpart of WritePlaneToBGRA8Channel, with the same single-byte store guarantee.
+ */
+TEXTURECHANNELPACKERCORE_API void FillBGRA8Channel(uint8 Value, uint8* OutBGRA, int32 ByteOffset, int64 Num);
+
+/**
+ * @brief Scalar reference implementation of InterleavePlanarToBGRA8 (used as a fallback and for benchmarks).
+ */
+TEXTURECHANNELPACKERCORE_API void InterleavePlanarToBGRA8Scalar(const uint8* R, const uint8* G, const uint8* B, const uint8* A, uint8* OutBGRA, int64 Num);
+
+/**
+ * @brief Returns the name of the instruction set used by the vectorized kernels (e.g., "AVX2", "SSE2", "NEON", "Scalar").
+ */
+TEXTURECHANNELPACKERCORE_API const TCHAR* GetChannelPackerSimdName();
+
+// ---------------------------------------------------------
+// Source Row Converters
+// ---------------------------------------------------------
+// Each converter turns Num source texels into one channel. The "Bytes" variants produce the 8-bit
+// value used when no resize is needed; float sources are scaled by 255, clamped and truncated, and
+// 16-bit sources keep their high byte, exactly as the scalar conversion always did. The "Floats"
+// variants produce values on the 0-255 scale for the resampler, without quantizing. NaN becomes 0.
+
+/** 16-bit unsigned grayscale (TSF_G16) to 8-bit (high byte). */
+TEXTURECHANNELPACKERCORE_API void ConvertG16ToBytes(const uint16* Src, uint8* Dst, int64 Num);
+
+/** Half-float (TSF_R16F, raw FFloat16 bits) to 8-bit. */
+TEXTURECHANNELPACKERCORE_API void ConvertHalfToBytes(const uint16* Src, uint8* Dst, int64 Num);
+
+/** 32-bit float (TSF_R32F) to 8-bit. */
+TEXTURECHANNELPACKERCORE_API void ConvertFloatToBytes(const float* Src, uint8* Dst, int64 Num);
+
+/** 8-bit grayscale (TSF_G8) to 0-255 floats. */
+TEXTURECHANNELPACKERCORE_API void ConvertBytesToFloats(const uint8* Src, float* Dst, int64 Num);
+
+/** 16-bit unsigned grayscale (TSF_G16) to 0-255 floats (Value / 256). */
+TEXTURECHANNELPACKERCORE_API void ConvertG16ToFloats(const uint16* Src, float* Dst, int64 Num);
+
+/** Half-float (TSF_R16F) to 0-255 floats (Value * 255, clamped). */
+TEXTURECHANNELPACKERCORE_API void ConvertHalfToFloats(const uint16* Src, float* Dst, int64 Num);
+
+/** 32-bit float (TSF_R32F) to 0-255 floats (Value * 255, clamped). */
+TEXTURECHANNELPACKERCORE_API void ConvertFloatToFloats(const float* Src, float* Dst, int64 Num);
+
+// ---------------------------------------------------------
+// Multi-Channel Deinterleave
+// ---------------------------------------------------------
+// Split 4-channel sources into up to ChannelPackNumSourceChannels planes in a single pass. Dst is
+// indexed by ETextureSourceChannel (R, G, B, A, Luminance); null entries are skipped. Values follow
+// the same rules as the single-channel converters above. Luminance uses Rec. 709 weights rounded to
+// 1/256 steps on the stored values, in every variant.
+
+/** BGRA8 (TSF_BGRA8) to 8-bit planes. */
+TEXTURECHANNELPACKERCORE_API void DeinterleaveBGRA8ToBytes(const uint8* Src, uint8* const Dst[ChannelPackNumSourceChannels], int64 Num);
+
+/** BGRA8 (TSF_BGRA8) to 0-255 float planes. */
+TEXTURECHANNELPACKERCORE_API void DeinterleaveBGRA8ToFloats(const uint8* Src, float* const Dst[ChannelPackNumSourceChannels], int64 Num);
+
+/** 32-bit float RGBA (TSF_RGBA32F, 4 floats per texel) to 8-bit planes. */
+TEXTURECHANNELPACKERCORE_API void DeinterleaveRGBA32FToBytes(const float* Src, uint8* const Dst[ChannelPackNumSourceChannels], int64 Num);
+
+/** 32-bit float RGBA (TSF_RGBA32F) to 0-255 float planes. */
+TEXTURECHANNELPACKERCORE_API void DeinterleaveRGBA32FToFloats(const float* Src, float* const Dst[ChannelPackNumSourceChannels], int64 Num);
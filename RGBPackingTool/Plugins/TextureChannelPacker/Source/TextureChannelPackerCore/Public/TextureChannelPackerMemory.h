@@ -0,0 +1,200 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * @class FChannelPackMemoryTracker
+ * @brief Counts the bytes held by the buffers of a pack: the current total and its peak.
+ *
+ * Trackers form a tree: every byte counted by a tracker is also counted by its parent, up to the
+ * global tracker (GetGlobal), which therefore holds the total of every job in the process.
+ * Thread-safe; buffers are allocated and freed on the band workers as well as on the Game Thread.
+ */
+class TEXTURECHANNELPACKERCORE_API FChannelPackMemoryTracker
+{
+public:
+    /** Creates a tracker counted by the global tracker. */
+    FChannelPackMemoryTracker();
+
+    /** Creates a tracker counted by Parent (null for none). */
+    explicit FChannelPackMemoryTracker(FChannelPackMemoryTracker* InParent);
+
+    /** Returns the bytes still counted (which indicates a leak) to the parent. */
+    ~FChannelPackMemoryTracker();
+
+    FChannelPackMemoryTracker(const FChannelPackMemoryTracker&) = delete;
+    FChannelPackMemoryTracker& operator=(const FChannelPackMemoryTracker&) = delete;
+
+    /** Makes the bytes counted from now on count toward another parent. Only valid while nothing is counted. */
+    void SetParent(FChannelPackMemoryTracker* InParent);
+
+    /** Counts Bytes more, here and in every parent. */
+    void Add(int64 Bytes);
+
+    /** Counts Bytes less, here and in every parent. */
+    void Remove(int64 Bytes);
+
+    /** Counts one buffer handed out by the scratch arena, here and in every parent. */
+    void CountAllocation(bool bReused);
+
+    int64 GetCurrentBytes() const { return CurrentBytes.load(std::memory_order_relaxed); }
+    int64 GetPeakBytes() const { return PeakBytes.load(std::memory_order_relaxed); }
+
+    /** Buffers allocated through FChannelPackTrackedBuffer, and how many of them the scratch arena recycled. */
+    int64 GetNumAllocations() const { return NumAllocations.load(std::memory_order_relaxed); }
+    int64 GetNumReusedAllocations() const { return NumReusedAllocations.load(std::memory_order_relaxed); }
+
+    /** @return The tracker of the whole process, parent of every job's tracker. */
+    static FChannelPackMemoryTracker& GetGlobal();
+
+private:
+    FChannelPackMemoryTracker* Parent = nullptr;
+    std::atomic<int64> CurrentBytes{0};
+    std::atomic<int64> PeakBytes{0};
+    std::atomic<int64> NumAllocations{0};
+    std::atomic<int64> NumReusedAllocations{0};
+};
+
+/**
+ * @class FChannelPackMemoryCharge
+ * @brief Counts memory owned elsewhere (a texture mip, a shared source buffer) against a tracker while it is alive.
+ *
+ * Move-only. Releasing or destroying the charge removes its bytes from the tracker.
+ */
+class TEXTURECHANNELPACKERCORE_API FChannelPackMemoryCharge
+{
+public:
+    FChannelPackMemoryCharge() = default;
+    FChannelPackMemoryCharge(int64 InBytes, FChannelPackMemoryTracker& InTracker);
+    ~FChannelPackMemoryCharge() { Reset(); }
+
+    FChannelPackMemoryCharge(FChannelPackMemoryCharge&& Other);
+    FChannelPackMemoryCharge& operator=(FChannelPackMemoryCharge&& Other);
+
+    /** Removes the bytes from the tracker. */
+    void Reset();
+
+    int64 GetBytes() const { return Bytes; }
+
+private:
+    int64 Bytes = 0;
+    FChannelPackMemoryTracker* Tracker = nullptr;
+};
+
+/** Counters of FChannelPackScratchArena since startup. */
+struct FChannelPackScratchArenaStats
+{
+    /** Blocks handed out, and how many of them were recycled instead of taken from the general allocator. */
+    int64 NumAcquired = 0;
+    int64 NumReused = 0;
+
+    /** Blocks given back to the general allocator: over the cache limit when released, or idle when trimmed. */
+    int64 NumFreed = 0;
+
+    /** Bytes of released blocks kept for reuse, now and at most. */
+    int64 CachedBytes = 0;
+    int64 PeakCachedBytes = 0;
+
+    double GetReuseRate() const { return NumAcquired > 0 ? (double)NumReused / NumAcquired : 0.0; }
+};
+
+/**
+ * @class FChannelPackScratchArena
+ * @brief Recycles the packer's scratch blocks across bands, channels and jobs.
+ *
+ * Blocks are 64-byte aligned and rounded up to a size class (4 KB, then four classes per power of two,
+ * so at most 25% slack). A released block is kept in the free list of its class, up to
+ * TextureChannelPacker.ScratchArenaMB of cached blocks, and handed out again by the next request of
+ * that class; the most recently released block comes first, as it is the most likely to be in cache.
+ * Cached blocks are charged to the global tracker, so memory budgets see them like the buffers in use.
+ * Blocks that stay unused for TextureChannelPacker.ScratchArenaIdleSeconds are returned to the
+ * general allocator by TrimIdle. Thread-safe.
+ */
+class TEXTURECHANNELPACKERCORE_API FChannelPackScratchArena
+{
+public:
+    static constexpr int64 Alignment = 64;
+    static constexpr int64 MinSizeClass = 4096;
+
+    /** @return The arena shared by every pack in the process. */
+    static FChannelPackScratchArena& Get();
+
+    /** @return The size of the blocks that serve a request of NumBytes. */
+    static int64 GetSizeClass(int64 NumBytes);
+
+    FChannelPackScratchArena() = default;
+    ~FChannelPackScratchArena();
+
+    FChannelPackScratchArena(const FChannelPackScratchArena&) = delete;
+    FChannelPackScratchArena& operator=(const FChannelPackScratchArena&) = delete;
+
+    /**
+     * Returns an uninitialized block of SizeClass bytes (a value of GetSizeClass), recycled if one is free.
+     * @param bOutReused Set to whether the block was recycled.
+     */
+    uint8* Acquire(int64 SizeClass, bool& bOutReused);
+
+    /** Returns a block from Acquire for reuse, or frees it if the cache is full. */
+    void Release(uint8* Data, int64 SizeClass);
+
+    /** Frees the cached blocks that have not been used for MaxIdleSeconds (0 frees all of them). */
+    void Trim(double MaxIdleSeconds);
+
+    /** Trim with TextureChannelPacker.ScratchArenaIdleSeconds. */
+    void TrimIdle();
+
+    FChannelPackScratchArenaStats GetStats() const;
+
+private:
+    struct FFreeBlock
+    {
+        uint8* Data = nullptr;
+        double ReleaseTime = 0.0;
+    };
+
+    /** Frees the blocks released before OlderThan. Called with Lock held. */
+    void TrimLocked(double OlderThan);
+
+    mutable FCriticalSection Lock;
+    TMap<int64, TArray<FFreeBlock>> FreeBlocks;
+    FChannelPackScratchArenaStats Stats;
+    double LastTrimTime = 0.0;
+};
+
+/**
+ * @class FChannelPackTrackedBuffer
+ * @brief An uninitialized scratch buffer from FChannelPackScratchArena, counted by a tracker while it is allocated.
+ *
+ * Used for every buffer the packing allocates (band planes, resampling rows, captured planes), so
+ * a job's current and peak memory can be read from its tracker. The tracker is charged with the
+ * size class of the block, which is what the buffer holds. Move-only.
+ */
+class TEXTURECHANNELPACKERCORE_API FChannelPackTrackedBuffer
+{
+public:
+    FChannelPackTrackedBuffer() = default;
+    ~FChannelPackTrackedBuffer() { Reset(); }
+
+    FChannelPackTrackedBuffer(FChannelPackTrackedBuffer&& Other);
+    FChannelPackTrackedBuffer& operator=(FChannelPackTrackedBuffer&& Other);
+
+    /** Releases the current allocation and allocates InNumBytes counted by Tracker. The contents are undefined. */
+    void Allocate(int64 InNumBytes, FChannelPackMemoryTracker& Tracker);
+
+    /** Returns the block to the scratch arena. */
+    void Reset();
+
+    uint8* GetData() const { return Data; }
+
+    template<typename ElementType>
+    ElementType* GetData() const { return reinterpret_cast<ElementType*>(Data); }
+
+    int64 Num() const { return NumBytes; }
+
+private:
+    uint8* Data = nullptr;
+    int64 NumBytes = 0;
+    FChannelPackMemoryCharge Charge;
+};
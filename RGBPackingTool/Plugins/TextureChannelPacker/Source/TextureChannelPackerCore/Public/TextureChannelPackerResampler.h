@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TextureChannelPackerTypes.h"
+
+/**
+ * @struct FResampleAxis
+ * @brief Precomputed filter taps for resampling along one axis.
+ *
+ * For every destination sample D, the contributing source samples are the contiguous range
+ * [First[D], First[D] + Count[D]) and their normalized weights are stored at
+ * Weights[D * MaxTaps + T]. The range is always clamped to the source, so kernels never need
+ * to bounds-check. When source and destination sizes match, the axis is an exact identity
+ * (one tap of weight 1), regardless of the filter.
+ */
+struct TEXTURECHANNELPACKERCORE_API FResampleAxis
+{
+    /** First contributing source index for each destination sample. */
+    TArray<int32> First;
+
+    /** Number of contributing source samples for each destination sample. */
+    TArray<int32> Count;
+
+    /** MaxTaps weights per destination sample. Entries past Count are zero. */
+    TArray<float> Weights;
+
+    /** The largest Count over all destination samples (stride of Weights). */
+    int32 MaxTaps = 0;
+
+    /**
+     * @brief Builds the tap table.
+     *
+     * @param SrcSize Number of source samples along this axis.
+     * @param DstSize Number of destination samples along this axis.
+     * @param Filter The reconstruction filter to use.
+     */
+    void Build(int32 SrcSize, int32 DstSize, ETextureResizeFilter Filter);
+
+    /** @return true if this axis maps every source sample to itself. */
+    bool IsIdentity() const { return bIdentity; }
+
+    /**
+     * @brief Returns the range of source samples needed for a range of destination samples.
+     *
+     * @param DstBegin First destination sample (inclusive).
+     * @param DstEnd Last destination sample (exclusive).
+     * @param OutSrcBegin First source sample needed (inclusive).
+     * @param OutSrcEnd Last source sample needed (exclusive).
+     */
+    void GetSourceRange(int32 DstBegin, int32 DstEnd, int32& OutSrcBegin, int32& OutSrcEnd) const;
+
+private:
+    bool bIdentity = false;
+};
+
+/**
+ * @brief Adds Weight * Row into Accumulator for Num elements (the vertical pass of the resampler).
+ */
+TEXTURECHANNELPACKERCORE_API void AccumulateWeightedRow(const float* Row, float Weight, float* Accumulator, int32 Num);
+
+/**
+ * @brief Rounds filtered 0-255 values to bytes, clamping the under/overshoot of negative-lobe filters.
+ */
+TEXTURECHANNELPACKERCORE_API void QuantizeRowToBytes(const float* Row, uint8* OutRow, int32 Num);
+
+/**
+ * @brief Returns the mip of a source mip chain that a pack of Width x Height reads: the mip of exactly that size, or 0.
+ *
+ * A mip of the output size is packed texel for texel, without resampling, so the output holds exactly the
+ * source's own mip. At any other size the pack resizes mip 0: resizing a smaller mip instead would add the
+ * filter that made the chain to the result.
+ *
+ * @param Mip0Width Width of mip 0 of the source.
+ * @param Mip0Height Height of mip 0 of the source.
+ * @param NumMips Number of mips in the source's chain.
+ * @param Width Output width.
+ * @param Height Output height.
+ */
+TEXTURECHANNELPACKERCORE_API int32 FindChannelPackSourceMipOfSize(int32 Mip0Width, int32 Mip0Height, int32 NumMips, int32 Width, int32 Height);
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/** `stat TextureChannelPacker` shows the time of every packing stage and the bytes read and written. */
+DECLARE_STATS_GROUP(TEXT("TextureChannelPacker"), STATGROUP_TextureChannelPacker, STATCAT_Advanced);
+
+/**
+ * Times the enclosing scope as packing stage Name: as a "TextureChannelPacker.<Name>" CPU event in
+ * Unreal Insights and in the cycle counter Stat of STATGROUP_TextureChannelPacker.
+ *
+ * @code
+ * DECLARE_CYCLE_STAT(TEXT("Resize"), STAT_ChannelPack_Resize, STATGROUP_TextureChannelPacker);
+ * CHANNEL_PACK_STAGE_SCOPE("Resize", STAT_ChannelPack_Resize);
+ * @endcode
+ */
+#define CHANNEL_PACK_STAGE_SCOPE(Name, Stat) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_STR("TextureChannelPacker." Name); \
+    SCOPE_CYCLE_COUNTER(Stat)
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @enum ETextureResizeFilter
+ * @brief The reconstruction filter used when an input has to be resized to the output resolution.
+ *
+ * All filters are applied separably (horizontal pass, then vertical pass) and are widened by the
+ * scale factor when downscaling so that every covered source texel contributes.
+ */
+enum class ETextureResizeFilter : uint8
+{
+    /** Box filter. Averages the footprint when downscaling, nearest neighbor when upscaling. Radius 0.5. */
+    Box,
+
+    /** Triangle (tent) filter. Bilinear interpolation when upscaling. Radius 1. */
+    Bilinear,
+
+    /** Mitchell-Netravali cubic (B = 1/3, C = 1/3). Balanced sharpness with little ringing. Radius 2. */
+    Mitchell,
+
+    /** Catmull-Rom cubic (B = 0, C = 1/2). Sharper than Mitchell, slight ringing. Radius 2. */
+    CatmullRom,
+
+    /** Lanczos windowed sinc with 3 lobes. Sharpest, may ring on hard edges. Radius 3. */
+    Lanczos3,
+};
+
+/**
+ * @enum ETextureSourceChannel
+ * @brief Which channel of an input texture feeds an output slot.
+ *
+ * Only 4-channel sources (BGRA8, RGBA32F) have separate channels. Single-channel sources
+ * (G8, G16, R16F, R32F) always provide their one value, whatever is selected.
+ */
+enum class ETextureSourceChannel : uint8
+{
+    /** The red channel (default). */
+    Red,
+
+    /** The green channel. */
+    Green,
+
+    /** The blue channel. */
+    Blue,
+
+    /** The alpha channel. */
+    Alpha,
+
+    /** Rec. 709 luminance of red, green and blue, with weights in 1/256 steps ((54 R + 183 G + 19 B) / 256). */
+    Luminance,
+};
+
+/** Number of ETextureSourceChannel values. */
+static constexpr int32 ChannelPackNumSourceChannels = 5;
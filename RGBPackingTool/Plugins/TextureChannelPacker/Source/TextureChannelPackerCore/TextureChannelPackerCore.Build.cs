@@ -0,0 +1,18 @@
+using UnrealBuildTool;
+
+public class TextureChannelPackerCore : ModuleRules
+{
+    public TextureChannelPackerCore(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        // The pixel engine (conversion, resize, interleave) works on plain buffers and must only
+        // depend on Core, so that it can be linked into programs and tests without the editor.
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+            }
+        );
+    }
+}
@@ -0,0 +1,440 @@
+#include "TextureChannelPackerTests.h"
+#include "TextureChannelPackerEngine.h"
+#include "TextureChannelPackerKernels.h"
+#include "Async/ParallelFor.h"
+#include "Math/Float16.h"
+
+static const EChannelPackSourceFormat SourceFormats[] =
+{
+    EChannelPackSourceFormat::G8,
+    EChannelPackSourceFormat::BGRA8,
+    EChannelPackSourceFormat::G16,
+    EChannelPackSourceFormat::R16F,
+    EChannelPackSourceFormat::R32F,
+    EChannelPackSourceFormat::RGBA32F,
+};
+
+static bool IsFourChannelFormat(EChannelPackSourceFormat Format)
+{
+    return Format == EChannelPackSourceFormat::BGRA8 || Format == EChannelPackSourceFormat::RGBA32F;
+}
+
+/** Converts one texel with the scalar loop of the format's converter (a single element never reaches a vector loop). */
+static uint8 ConvertTexelScalar(EChannelPackSourceFormat Format, const uint8* Texel, ETextureSourceChannel Channel)
+{
+    uint8 Value = 0;
+    uint8* Planes[ChannelPackNumSourceChannels] = {};
+    Planes[(int32)Channel] = &Value;
+    switch (Format)
+    {
+    case EChannelPackSourceFormat::G8:      Value = *Texel; break;
+    case EChannelPackSourceFormat::BGRA8:   DeinterleaveBGRA8ToBytes(Texel, Planes, 1); break;
+    case EChannelPackSourceFormat::G16:     ConvertG16ToBytes((const uint16*)Texel, &Value, 1); break;
+    case EChannelPackSourceFormat::R16F:    ConvertHalfToBytes((const uint16*)Texel, &Value, 1); break;
+    case EChannelPackSourceFormat::R32F:    ConvertFloatToBytes((const float*)Texel, &Value, 1); break;
+    case EChannelPackSourceFormat::RGBA32F: DeinterleaveRGBA32FToBytes((const float*)Texel, Planes, 1); break;
+    default: break;
+    }
+    return Value;
+}
+
+/** Fills a source with noise: any bits for integer formats, values around [0, 1] for float formats. */
+static void FillTestSource(EChannelPackSourceFormat Format, TArray<uint8>& Data, int32 Seed)
+{
+    FillChannelPackTestNoise(Data.GetData(), Data.Num(), Seed);
+    FRandomStream Random(Seed);
+    if (Format == EChannelPackSourceFormat::R16F)
+    {
+        for (int32 i = 0; i < Data.Num() / 2; ++i)
+        {
+            ((FFloat16*)Data.GetData())[i] = FFloat16(Random.FRand() * 1.2f - 0.1f);
+        }
+    }
+    else if (Format == EChannelPackSourceFormat::R32F || Format == EChannelPackSourceFormat::RGBA32F)
+    {
+        for (int32 i = 0; i < Data.Num() / 4; ++i)
+        {
+            ((float*)Data.GetData())[i] = Random.FRand() * 1.2f - 0.1f;
+        }
+    }
+}
+
+// ---------------------------------------------------------
+// Pack Against the Scalar Kernels
+// ---------------------------------------------------------
+
+void TestPackAgainstScalarKernels(FChannelPackTestContext& Test)
+{
+    // Same-size packs take the specialized byte path; every output byte must match the scalar conversion
+    enum class EChannelMode : uint8 { Source, Empty, Cached, Preserved };
+    static const int32 Widths[] = { 1, 3, 15, 16, 17, 31, 33, 65, 67 };
+    static constexpr int32 Height = 5;
+
+    for (const EChannelPackSourceFormat Format : SourceFormats)
+    {
+        for (const int32 Width : Widths)
+        {
+            TArray<uint8> Source;
+            Source.SetNumUninitialized(Width * Height * GetChannelPackSourceBytesPerPixel(Format));
+            FillTestSource(Format, Source, Width);
+            TArray<uint8> CachedPlane;
+            CachedPlane.SetNumUninitialized(Width * Height);
+            FillChannelPackTestNoise(CachedPlane.GetData(), CachedPlane.Num(), Width + 1);
+            TArray<uint8> Initial;
+            Initial.SetNumUninitialized(Width * Height * 4);
+            FillChannelPackTestNoise(Initial.GetData(), Initial.Num(), Width + 2);
+
+            // Every slot goes through every mode, in both invert states
+            for (int32 Rotation = 0; Rotation < 4; ++Rotation)
+            {
+                for (uint32 InvertMask = 0; InvertMask < 16; ++InvertMask)
+                {
+                    FChannelPackDesc Channels[4];
+                    EChannelMode Modes[4];
+                    for (int32 Slot = 0; Slot < 4; ++Slot)
+                    {
+                        Modes[Slot] = (EChannelMode)((Slot + Rotation) % 4);
+                        FChannelPackDesc& Channel = Channels[Slot];
+                        Channel.bInvert = (InvertMask & (1u << Slot)) != 0;
+                        Channel.DefaultValue = (uint8)(Slot * 60 + Rotation);
+                        if (Modes[Slot] == EChannelMode::Source)
+                        {
+                            Channel.Source.Data = Source.GetData();
+                            Channel.Source.Width = Width;
+                            Channel.Source.Height = Height;
+                            Channel.Source.Format = Format;
+                            Channel.SourceChannel = (ETextureSourceChannel)((Slot + Rotation + InvertMask) % ChannelPackNumSourceChannels);
+                        }
+                        else if (Modes[Slot] == EChannelMode::Cached)
+                        {
+                            Channel.CachedPlane = CachedPlane.GetData();
+                        }
+                        else if (Modes[Slot] == EChannelMode::Preserved)
+                        {
+                            Channel.bPreserveOutput = true;
+                        }
+                    }
+
+                    TArray<uint8> Expected = Initial;
+                    for (int32 Pixel = 0; Pixel < Width * Height; ++Pixel)
+                    {
+                        static constexpr int32 ByteOffsets[4] = { 2, 1, 0, 3 };
+                        for (int32 Slot = 0; Slot < 4; ++Slot)
+                        {
+                            const FChannelPackDesc& Channel = Channels[Slot];
+                            uint8 Value = 0;
+                            switch (Modes[Slot])
+                            {
+                            case EChannelMode::Source:
+                                Value = ConvertTexelScalar(Format, Source.GetData() + Pixel * GetChannelPackSourceBytesPerPixel(Format),
+                                    IsFourChannelFormat(Format) ? Channel.SourceChannel : ETextureSourceChannel::Red);
+                                break;
+                            case EChannelMode::Empty:     Value = Channel.DefaultValue; break;
+                            case EChannelMode::Cached:    Value = CachedPlane[Pixel]; break;
+                            case EChannelMode::Preserved: continue;
+                            }
+                            Expected[Pixel * 4 + ByteOffsets[Slot]] = Channel.bInvert ? (uint8)(255 - Value) : Value;
+                        }
+                    }
+
+                    TArray<uint8> Output = Initial;
+                    PackChannelsToBGRA8(Channels, Width, Height, ETextureResizeFilter::Bilinear, Output.GetData());
+                    Test.ExpectBytes(Expected.GetData(), Output.GetData(), Expected.Num(), FString::Printf(TEXT("%s, %dx%d, modes rotated by %d, invert mask %u"),
+                        GetChannelPackSourceFormatName(Format), Width, Height, Rotation, InvertMask));
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------
+// Constant Channels
+// ---------------------------------------------------------
+
+void TestConstantChannels(FChannelPackTestContext& Test)
+{
+    // A uniform source channel is written as a constant without running its producer. Its value must be
+    // what the producer writes: the same source with one corner texel changed is produced normally, and
+    // every output pixel out of that texel's reach must match.
+    static constexpr int32 SrcWidth = 48;
+    static constexpr int32 SrcHeight = 40;
+    static constexpr int32 Margin = 8;
+    static const FIntPoint OutputSizes[] = { FIntPoint(SrcWidth, SrcHeight), FIntPoint(24, 20), FIntPoint(61, 53) };
+
+    // Texel values per format, including the rounding edges where truncation and rounding differ
+    TArray<TArray<uint8>> Texels[UE_ARRAY_COUNT(SourceFormats)];
+    const auto AddTexel = [&Texels](int32 FormatIndex, const void* Data, int32 NumBytes)
+    {
+        Texels[FormatIndex].Add(TArray<uint8>((const uint8*)Data, NumBytes));
+    };
+    for (const uint8 Value : { 0, 1, 127, 128, 254, 255 })
+    {
+        AddTexel(0, &Value, 1);
+    }
+    for (const FColor& Value : { FColor(0, 0, 0, 0), FColor(255, 255, 255, 255), FColor(12, 200, 77, 128), FColor(1, 2, 3, 254) })
+    {
+        AddTexel(1, &Value, 4);
+    }
+    for (const uint16 Value : { 0x0000, 0x00ff, 0x7f7f, 0x7f80, 0x8000, 0xffff })
+    {
+        AddTexel(2, &Value, 2);
+    }
+    // 0, -0, smallest denormal, 0.5 (127.5 on the 0-255 scale), just under 1, 1, 2, -1, +Inf, NaN
+    for (const uint16 Value : { 0x0000, 0x8000, 0x0001, 0x3800, 0x3bff, 0x3c00, 0x4000, 0xbc00, 0x7c00, 0x7e00 })
+    {
+        AddTexel(3, &Value, 2);
+    }
+    for (const float Value : { 0.0f, -0.0f, 0.5f, 127.5f / 255.0f, 0.5f / 255.0f, 1.0f, -0.25f, 1.5f, 1.0e-40f,
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN() })
+    {
+        AddTexel(4, &Value, 4);
+    }
+    for (const FLinearColor& Value : { FLinearColor(0.5f, 0.25f, 1.0f, 0.0f), FLinearColor(std::numeric_limits<float>::quiet_NaN(), -1.0f, 2.0f, 0.5f),
+        FLinearColor(127.5f / 255.0f, 0.5f / 255.0f, 1.0e-40f, 1.0f) })
+    {
+        AddTexel(5, &Value, 16);
+    }
+
+    for (int32 FormatIndex = 0; FormatIndex < UE_ARRAY_COUNT(SourceFormats); ++FormatIndex)
+    {
+        const EChannelPackSourceFormat Format = SourceFormats[FormatIndex];
+        const int32 BytesPerPixel = GetChannelPackSourceBytesPerPixel(Format);
+        const int32 NumSourceChannels = IsFourChannelFormat(Format) ? ChannelPackNumSourceChannels : 1;
+        for (const TArray<uint8>& Texel : Texels[FormatIndex])
+        {
+            TArray<uint8> Uniform;
+            Uniform.SetNumUninitialized(SrcWidth * SrcHeight * BytesPerPixel);
+            for (int32 i = 0; i < SrcWidth * SrcHeight; ++i)
+            {
+                FMemory::Memcpy(Uniform.GetData() + i * BytesPerPixel, Texel.GetData(), BytesPerPixel);
+            }
+
+            // A corner texel that differs in every channel: 0.3 or 0.6 for floats, the complement otherwise
+            TArray<uint8> Perturbed = Uniform;
+            if (Format == EChannelPackSourceFormat::R16F)
+            {
+                *(uint16*)Perturbed.GetData() = *(const uint16*)Texel.GetData() == 0x34cd ? 0x38cd : 0x34cd;
+            }
+            else if (Format == EChannelPackSourceFormat::R32F || Format == EChannelPackSourceFormat::RGBA32F)
+            {
+                for (int32 Component = 0; Component < BytesPerPixel / 4; ++Component)
+                {
+                    float& Value = ((float*)Perturbed.GetData())[Component];
+                    Value = Value == 0.3f ? 0.6f : 0.3f;
+                }
+            }
+            else
+            {
+                for (int32 Byte = 0; Byte < BytesPerPixel; ++Byte)
+                {
+                    Perturbed[Byte] = (uint8)~Perturbed[Byte];
+                }
+            }
+
+            for (int32 SourceChannel = 0; SourceChannel < NumSourceChannels; ++SourceChannel)
+            {
+                for (int32 bInvert = 0; bInvert < 2; ++bInvert)
+                {
+                    for (const FIntPoint& OutputSize : OutputSizes)
+                    {
+                        FChannelPackDesc Channels[4];
+                        Channels[0].Source.Data = Uniform.GetData();
+                        Channels[0].Source.Width = SrcWidth;
+                        Channels[0].Source.Height = SrcHeight;
+                        Channels[0].Source.Format = Format;
+                        Channels[0].SourceChannel = (ETextureSourceChannel)SourceChannel;
+                        Channels[0].bInvert = bInvert != 0;
+
+                        TArray<uint8> Constant;
+                        TArray<uint8> Produced;
+                        Constant.SetNumUninitialized(OutputSize.X * OutputSize.Y * 4);
+                        Produced.SetNumUninitialized(OutputSize.X * OutputSize.Y * 4);
+                        PackChannelsToBGRA8(Channels, OutputSize.X, OutputSize.Y, ETextureResizeFilter::Lanczos3, Constant.GetData());
+                        Channels[0].Source.Data = Perturbed.GetData();
+                        PackChannelsToBGRA8(Channels, OutputSize.X, OutputSize.Y, ETextureResizeFilter::Lanczos3, Produced.GetData());
+
+                        const bool bResize = OutputSize.X != SrcWidth || OutputSize.Y != SrcHeight;
+                        int32 NumMismatches = 0;
+                        int32 FirstMismatch = INDEX_NONE;
+                        for (int32 Y = bResize ? Margin : 0; Y < OutputSize.Y; ++Y)
+                        {
+                            for (int32 X = bResize ? Margin : 0; X < OutputSize.X; ++X)
+                            {
+                                const int32 Pixel = Y * OutputSize.X + X;
+                                if (Pixel > 0 && Constant[Pixel * 4 + 2] != Produced[Pixel * 4 + 2])
+                                {
+                                    FirstMismatch = FirstMismatch == INDEX_NONE ? Pixel : FirstMismatch;
+                                    ++NumMismatches;
+                                }
+                            }
+                        }
+
+                        FString TexelBytes;
+                        for (const uint8 Byte : Texel)
+                        {
+                            TexelBytes += FString::Printf(TEXT("%02x"), Byte);
+                        }
+                        Test.Expect(NumMismatches == 0, FString::Printf(TEXT("%s texel %s, channel %d%s, %dx%d: %d pixels differ, first %d (constant %d, produced %d)"),
+                            GetChannelPackSourceFormatName(Format), *TexelBytes, SourceChannel, bInvert ? TEXT(" inverted") : TEXT(""), OutputSize.X, OutputSize.Y,
+                            NumMismatches, FirstMismatch, FirstMismatch != INDEX_NONE ? Constant[FirstMismatch * 4 + 2] : 0, FirstMismatch != INDEX_NONE ? Produced[FirstMismatch * 4 + 2] : 0));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------
+// Resized Luminance
+// ---------------------------------------------------------
+
+void TestResizedLuminance(FChannelPackTestContext& Test)
+{
+    // A Box upscale to twice the height keeps the width at a scale of 1 and copies every source row
+    // into two output rows with a weight of 1, so the resampler must write what the same-size byte
+    // path writes, luminance included
+    static constexpr int32 Width = 67;
+    static constexpr int32 Height = 9;
+    TArray<uint8> Source;
+    Source.SetNumUninitialized(Width * Height * 4);
+    FillTestSource(EChannelPackSourceFormat::BGRA8, Source, 500);
+
+    FChannelPackDesc Channels[4];
+    static const ETextureSourceChannel SourceChannels[4] = { ETextureSourceChannel::Luminance, ETextureSourceChannel::Red, ETextureSourceChannel::Blue, ETextureSourceChannel::Luminance };
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        Channels[Slot].Source.Data = Source.GetData();
+        Channels[Slot].Source.Width = Width;
+        Channels[Slot].Source.Height = Height;
+        Channels[Slot].Source.Format = EChannelPackSourceFormat::BGRA8;
+        Channels[Slot].SourceChannel = SourceChannels[Slot];
+        Channels[Slot].bInvert = Slot == 3;
+    }
+
+    TArray<uint8> SameSize;
+    TArray<uint8> Resized;
+    SameSize.SetNumUninitialized(Width * Height * 4);
+    Resized.SetNumUninitialized(Width * Height * 2 * 4);
+    PackChannelsToBGRA8(Channels, Width, Height, ETextureResizeFilter::Box, SameSize.GetData());
+    PackChannelsToBGRA8(Channels, Width, Height * 2, ETextureResizeFilter::Box, Resized.GetData());
+    for (int32 Y = 0; Y < Height * 2; ++Y)
+    {
+        Test.ExpectBytes(SameSize.GetData() + (Y / 2) * Width * 4, Resized.GetData() + Y * Width * 4, Width * 4,
+            FString::Printf(TEXT("Box upscale to %dx%d, row %d against source row %d"), Width, Height * 2, Y, Y / 2));
+    }
+}
+
+// ---------------------------------------------------------
+// Staged Pack
+// ---------------------------------------------------------
+
+void TestStagedPack(FChannelPackTestContext& Test)
+{
+    // The stages of a pipelined job (one per input, plus one for the remaining slots) must write what a
+    // single fused pack writes, including the capture planes, whatever order the stages run in
+    static constexpr int32 SrcWidth = 37;
+    static constexpr int32 SrcHeight = 53;
+    TArray<uint8> Color;
+    TArray<uint8> Gray16;
+    TArray<uint8> Flat;
+    Color.SetNumUninitialized(SrcWidth * SrcHeight * 4);
+    Gray16.SetNumUninitialized(SrcWidth * SrcHeight * 2);
+    Flat.Init(77, SrcWidth * SrcHeight);
+    FillChannelPackTestNoise(Color.GetData(), Color.Num(), 500);
+    FillChannelPackTestNoise(Gray16.GetData(), Gray16.Num(), 501);
+
+    // Stage orders: in order, reversed, and every stage at once
+    static constexpr int32 NumStages = 4;
+    static const int32 StageOrders[2][NumStages] = { { 0, 1, 2, 3 }, { 3, 2, 1, 0 } };
+    static const TCHAR* OrderNames[] = { TEXT("in order"), TEXT("reversed"), TEXT("concurrent") };
+
+    static const FIntPoint OutputSizes[] = { FIntPoint(SrcWidth, SrcHeight), FIntPoint(64, 40), FIntPoint(19, 9) };
+    for (const FIntPoint& Size : OutputSizes)
+    {
+        FChannelPackDesc Channels[4];
+        Channels[0].Source = { Color.GetData(), SrcWidth, SrcHeight, EChannelPackSourceFormat::BGRA8 };
+        Channels[0].SourceChannel = ETextureSourceChannel::Green;
+        Channels[1].Source = { Gray16.GetData(), SrcWidth, SrcHeight, EChannelPackSourceFormat::G16 };
+        Channels[1].bInvert = true;
+        Channels[2].Source = { Flat.GetData(), SrcWidth, SrcHeight, EChannelPackSourceFormat::G8 };
+        Channels[2].bInvert = true;
+        Channels[3].Source = { Color.GetData(), SrcWidth, SrcHeight, EChannelPackSourceFormat::BGRA8 };
+        Channels[3].SourceChannel = ETextureSourceChannel::Luminance;
+
+        const int32 NumPixels = Size.X * Size.Y;
+        TArray<uint8> FusedCaptures[2];
+        for (int32 i = 0; i < 2; ++i)
+        {
+            FusedCaptures[i].SetNumZeroed(NumPixels);
+        }
+
+        FChannelPackDesc Fused[4] = { Channels[0], Channels[1], Channels[2], Channels[3] };
+        Fused[0].CapturePlane = FusedCaptures[0].GetData();
+        Fused[2].CapturePlane = FusedCaptures[1].GetData();
+        TArray<uint8> Expected;
+        Expected.SetNumUninitialized(NumPixels * 4);
+        PackChannelsToBGRA8(Fused, Size.X, Size.Y, ETextureResizeFilter::Lanczos3, Expected.GetData());
+
+        for (int32 Order = 0; Order < UE_ARRAY_COUNT(OrderNames); ++Order)
+        {
+            TArray<uint8> StagedCaptures[2];
+            for (int32 i = 0; i < 2; ++i)
+            {
+                StagedCaptures[i].SetNumZeroed(NumPixels);
+            }
+
+            // The color input (R and A), the 16-bit input (G), the uniform input (B), and a stage for no slot
+            FChannelPackDesc Stages[NumStages][4];
+            for (int32 Stage = 0; Stage < NumStages; ++Stage)
+            {
+                for (int32 Slot = 0; Slot < 4; ++Slot)
+                {
+                    Stages[Stage][Slot].bPreserveOutput = true;
+                }
+            }
+            Stages[0][0] = Fused[0];
+            Stages[0][0].CapturePlane = StagedCaptures[0].GetData();
+            Stages[0][3] = Fused[3];
+            Stages[1][1] = Fused[1];
+            Stages[2][2] = Fused[2];
+            Stages[2][2].CapturePlane = StagedCaptures[1].GetData();
+
+            TArray<uint8> Actual;
+            Actual.Init(0x5a, NumPixels * 4);
+            FChannelPackStagedPack StagedPack(Size.X, Size.Y, ETextureResizeFilter::Lanczos3, Actual.GetData(), NumStages);
+            std::atomic<int32> NumSucceeded(0);
+            const auto RunStage = [&StagedPack, &Stages, &NumSucceeded](int32 Stage)
+            {
+                NumSucceeded += StagedPack.PackStage(Stages[Stage]) ? 1 : 0;
+            };
+            if (Order < UE_ARRAY_COUNT(StageOrders))
+            {
+                for (const int32 Stage : StageOrders[Order])
+                {
+                    RunStage(Stage);
+                }
+            }
+            else
+            {
+                ParallelFor(NumStages, RunStage);
+            }
+
+            const FString What = FString::Printf(TEXT("%dx%d, stages %s"), Size.X, Size.Y, OrderNames[Order]);
+            Test.Expect(NumSucceeded == NumStages, What + TEXT(": every stage completed"));
+            Test.ExpectBytes(Expected.GetData(), Actual.GetData(), Expected.Num(), What + TEXT(": staged output"));
+            Test.ExpectBytes(FusedCaptures[0].GetData(), StagedCaptures[0].GetData(), NumPixels, What + TEXT(": produced capture plane"));
+            Test.ExpectBytes(FusedCaptures[1].GetData(), StagedCaptures[1].GetData(), NumPixels, What + TEXT(": constant capture plane"));
+        }
+
+        // Slots reading the same channel of one source share the plane of the first one
+        FChannelPackDesc Shared[4] = { Channels[0], Channels[0], Channels[3], Channels[0] };
+        Shared[1].bInvert = true;
+        PackChannelsToBGRA8(Shared, Size.X, Size.Y, ETextureResizeFilter::Lanczos3, Expected.GetData());
+
+        TArray<uint8> Actual;
+        Actual.Init(0x5a, NumPixels * 4);
+        FChannelPackStagedPack SharedPack(Size.X, Size.Y, ETextureResizeFilter::Lanczos3, Actual.GetData(), 1);
+        Test.Expect(SharedPack.PackStage(Shared), TEXT("Shared stage completed"));
+        Test.ExpectBytes(Expected.GetData(), Actual.GetData(), Expected.Num(), FString::Printf(TEXT("%dx%d: shared staged output"), Size.X, Size.Y));
+    }
+}
@@ -0,0 +1,369 @@
+#include "TextureChannelPackerTests.h"
+#include "TextureChannelPackerKernels.h"
+#include "TextureChannelPackerResampler.h"
+#include "Math/Float16.h"
+
+// Every vectorized kernel finishes the last (Num % width) elements with its scalar loop, so calling
+// it one element at a time runs the scalar fallback only. Each test below runs a kernel over a whole
+// span and element by element, over every length in ChannelPackTestLengths and at an odd offset, and
+// expects the same bytes. Outputs are surrounded by a fill pattern that must survive.
+
+static constexpr uint8 GuardByte = 0xcd;
+static constexpr int32 NumGuardBytes = 64;
+
+/** Floats the converters must handle: range edges, rounding edges on the 0-255 scale, overflow, NaN and denormals. */
+static const float SpecialFloats[] =
+{
+    0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 1.0f / 255.0f, 0.5f / 255.0f, 127.5f / 255.0f, 254.5f / 255.0f, 0.99999994f, 1.0000001f,
+    2.0f, 1.0e30f, -1.0e30f, TNumericLimits<float>::Max(), -TNumericLimits<float>::Max(), 1.0e-40f, -1.0e-40f,
+    std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(),
+};
+
+/** Fills Data with special floats and noise in [-0.25, 1.25). */
+static void FillTestFloats(float* Data, int64 Num, int32 Seed)
+{
+    FRandomStream Random(Seed);
+    for (int64 i = 0; i < Num; ++i)
+    {
+        Data[i] = Random.RandRange(0, 3) == 0
+            ? SpecialFloats[Random.RandRange(0, (int32)UE_ARRAY_COUNT(SpecialFloats) - 1)]
+            : Random.FRand() * 1.5f - 0.25f;
+    }
+}
+
+/**
+ * Runs Convert(Src, Dst, Num) once over the whole span and once per element, at offsets 0 and 1 of
+ * both buffers, and expects the same output and untouched guard bytes.
+ */
+template<typename SrcType, typename DstType, typename ConvertType>
+static void CheckConverter(FChannelPackTestContext& Test, const TCHAR* Name, const SrcType* Source, ConvertType&& Convert)
+{
+    for (const int32 Num : ChannelPackTestLengths)
+    {
+        for (int32 Offset = 0; Offset < 2; ++Offset)
+        {
+            const int64 NumBytes = (Offset + Num) * sizeof(DstType) + NumGuardBytes;
+            TArray<uint8> Vector;
+            TArray<uint8> Scalar;
+            Vector.Init(GuardByte, NumBytes);
+            Scalar.Init(GuardByte, NumBytes);
+            DstType* VectorOut = (DstType*)Vector.GetData() + Offset;
+            DstType* ScalarOut = (DstType*)Scalar.GetData() + Offset;
+
+            Convert(Source + Offset, VectorOut, (int64)Num);
+            for (int32 i = 0; i < Num; ++i)
+            {
+                Convert(Source + Offset + i, ScalarOut + i, (int64)1);
+            }
+
+            const FString What = FString::Printf(TEXT("%s, %d elements at offset %d"), Name, Num, Offset);
+            if constexpr (std::is_same_v<DstType, float>)
+            {
+                Test.ExpectFloats(ScalarOut, VectorOut, Num, What);
+            }
+            else
+            {
+                Test.ExpectBytes((const uint8*)ScalarOut, (const uint8*)VectorOut, Num * sizeof(DstType), What);
+            }
+            Test.ExpectBytes(Scalar.GetData(), Vector.GetData(), NumBytes, What + TEXT(" (guard bytes)"));
+        }
+    }
+}
+
+/**
+ * Runs Deinterleave(FirstTexel, Dst, Num) for every subset of the R, G, B, A and Luminance planes, once
+ * over the whole span and once per texel, starting at texels 0 and 1, and expects the same planes.
+ */
+template<typename DstType, typename DeinterleaveType>
+static void CheckDeinterleave(FChannelPackTestContext& Test, const TCHAR* Name, DeinterleaveType&& Deinterleave)
+{
+    for (uint32 PlaneMask = 1; PlaneMask < (1u << ChannelPackNumSourceChannels); ++PlaneMask)
+    {
+        for (const int32 Num : ChannelPackTestLengths)
+        {
+            for (int32 Offset = 0; Offset < 2; ++Offset)
+            {
+                TArray<DstType> VectorPlanes[ChannelPackNumSourceChannels];
+                TArray<DstType> ScalarPlanes[ChannelPackNumSourceChannels];
+                DstType* VectorDst[ChannelPackNumSourceChannels] = {};
+                for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+                {
+                    VectorPlanes[Channel].SetNumZeroed(Num + NumGuardBytes);
+                    ScalarPlanes[Channel].SetNumZeroed(Num + NumGuardBytes);
+                    if (PlaneMask & (1u << Channel))
+                    {
+                        VectorDst[Channel] = VectorPlanes[Channel].GetData();
+                    }
+                }
+
+                Deinterleave(Offset, VectorDst, Num);
+                for (int32 i = 0; i < Num; ++i)
+                {
+                    DstType* ScalarDst[ChannelPackNumSourceChannels] = {};
+                    for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+                    {
+                        if (PlaneMask & (1u << Channel))
+                        {
+                            ScalarDst[Channel] = ScalarPlanes[Channel].GetData() + i;
+                        }
+                    }
+                    Deinterleave(Offset + i, ScalarDst, 1);
+                }
+
+                for (int32 Channel = 0; Channel < ChannelPackNumSourceChannels; ++Channel)
+                {
+                    const FString What = FString::Printf(TEXT("%s, plane %d of mask 0x%x, %d texels from texel %d"), Name, Channel, PlaneMask, Num, Offset);
+                    if constexpr (std::is_same_v<DstType, float>)
+                    {
+                        Test.ExpectFloats(ScalarPlanes[Channel].GetData(), VectorPlanes[Channel].GetData(), ScalarPlanes[Channel].Num(), What);
+                    }
+                    else
+                    {
+                        Test.ExpectBytes(ScalarPlanes[Channel].GetData(), VectorPlanes[Channel].GetData(), ScalarPlanes[Channel].Num(), What);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------
+// Interleave
+// ---------------------------------------------------------
+
+void TestInterleaveKernels(FChannelPackTestContext& Test)
+{
+    const int32 MaxNum = ChannelPackTestLengths[UE_ARRAY_COUNT(ChannelPackTestLengths) - 1] + 1;
+    TArray<uint8> Planes[4];
+    for (int32 Channel = 0; Channel < 4; ++Channel)
+    {
+        Planes[Channel].SetNumUninitialized(MaxNum);
+        FillChannelPackTestNoise(Planes[Channel].GetData(), MaxNum, 100 + Channel);
+    }
+
+    // Every invert and constant mask maps to one of the 3^4 kernels (plane, inverted plane or constant per channel)
+    TArray<FInterleaveBGRA8Kernel> Kernels;
+    for (uint32 ConstantMask = 0; ConstantMask < 16; ++ConstantMask)
+    {
+        for (uint32 InvertMask = 0; InvertMask < 16; ++InvertMask)
+        {
+            const FInterleaveBGRA8Kernel Kernel = GetInterleaveBGRA8Kernel(InvertMask, ConstantMask);
+            if (!Test.Expect(Kernel != nullptr, FString::Printf(TEXT("Kernel for invert mask %u, constant mask %u"), InvertMask, ConstantMask)))
+            {
+                continue;
+            }
+            Kernels.AddUnique(Kernel);
+
+            const uint8 Constants[4] = { (uint8)(17 * ConstantMask), (uint8)(255 - InvertMask), 0, 255 };
+            for (const int32 Num : ChannelPackTestLengths)
+            {
+                for (int32 Offset = 0; Offset < 2; ++Offset)
+                {
+                    const uint8* const Inputs[4] = { Planes[0].GetData() + Offset, Planes[1].GetData() + Offset, Planes[2].GetData() + Offset, Planes[3].GetData() + Offset };
+                    const int64 NumBytes = Offset + Num * 4 + NumGuardBytes;
+
+                    // What the kernel must write, from the definition of the masks
+                    TArray<uint8> Expected;
+                    Expected.Init(GuardByte, NumBytes);
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        static constexpr int32 ByteOffsets[4] = { 2, 1, 0, 3 };
+                        for (int32 Channel = 0; Channel < 4; ++Channel)
+                        {
+                            const uint8 Value = (ConstantMask & (1u << Channel)) ? Constants[Channel]
+                                : (InvertMask & (1u << Channel)) ? (uint8)(255 - Inputs[Channel][i]) : Inputs[Channel][i];
+                            Expected[Offset + i * 4 + ByteOffsets[Channel]] = Value;
+                        }
+                    }
+
+                    TArray<uint8> Vector;
+                    TArray<uint8> Scalar;
+                    Vector.Init(GuardByte, NumBytes);
+                    Scalar.Init(GuardByte, NumBytes);
+                    Kernel(Inputs, Constants, Vector.GetData() + Offset, Num);
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        const uint8* const PixelInputs[4] = { Inputs[0] + i, Inputs[1] + i, Inputs[2] + i, Inputs[3] + i };
+                        Kernel(PixelInputs, Constants, Scalar.GetData() + Offset + i * 4, 1);
+                    }
+
+                    const FString What = FString::Printf(TEXT("Interleave kernel (invert %u, constant %u), %d pixels at offset %d"), InvertMask, ConstantMask, Num, Offset);
+                    Test.ExpectBytes(Expected.GetData(), Scalar.GetData(), NumBytes, What + TEXT(", scalar"));
+                    Test.ExpectBytes(Expected.GetData(), Vector.GetData(), NumBytes, What + TEXT(", ") + GetChannelPackerSimdName());
+                }
+            }
+        }
+    }
+    Test.Expect(Kernels.Num() == 81, FString::Printf(TEXT("%d distinct interleave kernels, expected 81"), Kernels.Num()));
+
+    // The plain entry point against the scalar reference used as its fallback
+    for (const int32 Num : ChannelPackTestLengths)
+    {
+        TArray<uint8> Vector;
+        TArray<uint8> Scalar;
+        Vector.Init(GuardByte, Num * 4 + NumGuardBytes);
+        Scalar.Init(GuardByte, Num * 4 + NumGuardBytes);
+        InterleavePlanarToBGRA8(Planes[0].GetData(), Planes[1].GetData(), Planes[2].GetData(), Planes[3].GetData(), Vector.GetData(), Num);
+        InterleavePlanarToBGRA8Scalar(Planes[0].GetData(), Planes[1].GetData(), Planes[2].GetData(), Planes[3].GetData(), Scalar.GetData(), Num);
+        Test.ExpectBytes(Scalar.GetData(), Vector.GetData(), Scalar.Num(), FString::Printf(TEXT("InterleavePlanarToBGRA8, %d pixels"), Num));
+    }
+}
+
+void TestChannelWriters(FChannelPackTestContext& Test)
+{
+    const int32 MaxNum = ChannelPackTestLengths[UE_ARRAY_COUNT(ChannelPackTestLengths) - 1] + 1;
+    TArray<uint8> Plane;
+    TArray<uint8> Pixels;
+    Plane.SetNumUninitialized(MaxNum);
+    Pixels.SetNumUninitialized(MaxNum * 4 + 1 + NumGuardBytes);
+    FillChannelPackTestNoise(Plane.GetData(), Plane.Num(), 200);
+    FillChannelPackTestNoise(Pixels.GetData(), Pixels.Num(), 201);
+
+    for (int32 ByteOffset = 0; ByteOffset < 4; ++ByteOffset)
+    {
+        for (const int32 Num : ChannelPackTestLengths)
+        {
+            for (int32 Offset = 0; Offset < 2; ++Offset)
+            {
+                // The other three bytes of every pixel keep the noise they were filled with
+                for (int32 Mode = 0; Mode < 3; ++Mode)
+                {
+                    TArray<uint8> Expected = Pixels;
+                    TArray<uint8> Vector = Pixels;
+                    TArray<uint8> Scalar = Pixels;
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        Expected[Offset + i * 4 + ByteOffset] = Mode == 0 ? Plane[Offset + i] : Mode == 1 ? (uint8)(255 - Plane[Offset + i]) : (uint8)0x5a;
+                    }
+
+                    if (Mode < 2)
+                    {
+                        WritePlaneToBGRA8Channel(Plane.GetData() + Offset, Vector.GetData() + Offset, ByteOffset, Num, Mode == 1);
+                        for (int32 i = 0; i < Num; ++i)
+                        {
+                            WritePlaneToBGRA8Channel(Plane.GetData() + Offset + i, Scalar.GetData() + Offset + i * 4, ByteOffset, 1, Mode == 1);
+                        }
+                    }
+                    else
+                    {
+                        FillBGRA8Channel(0x5a, Vector.GetData() + Offset, ByteOffset, Num);
+                        for (int32 i = 0; i < Num; ++i)
+                        {
+                            FillBGRA8Channel(0x5a, Scalar.GetData() + Offset + i * 4, ByteOffset, 1);
+                        }
+                    }
+
+                    static const TCHAR* ModeNames[3] = { TEXT("WritePlaneToBGRA8Channel"), TEXT("WritePlaneToBGRA8Channel (inverted)"), TEXT("FillBGRA8Channel") };
+                    const FString What = FString::Printf(TEXT("%s, byte %d, %d pixels at offset %d"), ModeNames[Mode], ByteOffset, Num, Offset);
+                    Test.ExpectBytes(Expected.GetData(), Scalar.GetData(), Expected.Num(), What + TEXT(", scalar"));
+                    Test.ExpectBytes(Expected.GetData(), Vector.GetData(), Expected.Num(), What + TEXT(", vector"));
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------
+// Converters
+// ---------------------------------------------------------
+
+void TestRowConverters(FChannelPackTestContext& Test)
+{
+    const int32 MaxNum = ChannelPackTestLengths[UE_ARRAY_COUNT(ChannelPackTestLengths) - 1] + 1;
+    TArray<uint8> Bytes;
+    TArray<uint16> Words;
+    TArray<float> Floats;
+    Bytes.SetNumUninitialized(MaxNum);
+    Words.SetNumUninitialized(MaxNum);
+    Floats.SetNumUninitialized(MaxNum);
+    FillChannelPackTestNoise(Bytes.GetData(), Bytes.Num(), 300);
+    FillChannelPackTestNoise((uint8*)Words.GetData(), Words.Num() * sizeof(uint16), 301);
+    FillTestFloats(Floats.GetData(), Floats.Num(), 302);
+
+    CheckConverter<uint16, uint8>(Test, TEXT("ConvertG16ToBytes"), Words.GetData(), [](const uint16* Src, uint8* Dst, int64 Num) { ConvertG16ToBytes(Src, Dst, Num); });
+    CheckConverter<uint16, uint8>(Test, TEXT("ConvertHalfToBytes"), Words.GetData(), [](const uint16* Src, uint8* Dst, int64 Num) { ConvertHalfToBytes(Src, Dst, Num); });
+    CheckConverter<float, uint8>(Test, TEXT("ConvertFloatToBytes"), Floats.GetData(), [](const float* Src, uint8* Dst, int64 Num) { ConvertFloatToBytes(Src, Dst, Num); });
+    CheckConverter<uint8, float>(Test, TEXT("ConvertBytesToFloats"), Bytes.GetData(), [](const uint8* Src, float* Dst, int64 Num) { ConvertBytesToFloats(Src, Dst, Num); });
+    CheckConverter<uint16, float>(Test, TEXT("ConvertG16ToFloats"), Words.GetData(), [](const uint16* Src, float* Dst, int64 Num) { ConvertG16ToFloats(Src, Dst, Num); });
+    CheckConverter<uint16, float>(Test, TEXT("ConvertHalfToFloats"), Words.GetData(), [](const uint16* Src, float* Dst, int64 Num) { ConvertHalfToFloats(Src, Dst, Num); });
+    CheckConverter<float, float>(Test, TEXT("ConvertFloatToFloats"), Floats.GetData(), [](const float* Src, float* Dst, int64 Num) { ConvertFloatToFloats(Src, Dst, Num); });
+}
+
+void TestHalfConversion(FChannelPackTestContext& Test)
+{
+    // Every half: F16C, the SSE2 bit trick or NEON, depending on the build, against FFloat16
+    TArray<uint16> Halves;
+    Halves.SetNumUninitialized(65536);
+    for (int32 i = 0; i < 65536; ++i)
+    {
+        Halves[i] = (uint16)i;
+    }
+
+    TArray<float> Expected;
+    TArray<uint8> ExpectedBytes;
+    Expected.SetNumUninitialized(65536);
+    ExpectedBytes.SetNumUninitialized(65536);
+    for (int32 i = 0; i < 65536; ++i)
+    {
+        FFloat16 Half;
+        Half.Encoded = Halves[i];
+        // NaN fails the comparison and becomes 0, as in the kernels
+        const float Scaled = Half.GetFloat() * 255.0f;
+        Expected[i] = Scaled > 0.0f ? FMath::Min(Scaled, 255.0f) : 0.0f;
+        ExpectedBytes[i] = (uint8)Expected[i];
+    }
+
+    TArray<float> Floats;
+    TArray<uint8> Bytes;
+    Floats.SetNumUninitialized(65536);
+    Bytes.SetNumUninitialized(65536);
+    ConvertHalfToFloats(Halves.GetData(), Floats.GetData(), Halves.Num());
+    ConvertHalfToBytes(Halves.GetData(), Bytes.GetData(), Halves.Num());
+    Test.ExpectFloats(Expected.GetData(), Floats.GetData(), Expected.Num(), TEXT("ConvertHalfToFloats, every half"));
+    Test.ExpectBytes(ExpectedBytes.GetData(), Bytes.GetData(), ExpectedBytes.Num(), TEXT("ConvertHalfToBytes, every half"));
+}
+
+void TestDeinterleaveKernels(FChannelPackTestContext& Test)
+{
+    const int32 MaxNum = ChannelPackTestLengths[UE_ARRAY_COUNT(ChannelPackTestLengths) - 1] + 1;
+    TArray<uint8> Texels;
+    TArray<float> LinearTexels;
+    Texels.SetNumUninitialized(MaxNum * 4);
+    LinearTexels.SetNumUninitialized(MaxNum * 4);
+    FillChannelPackTestNoise(Texels.GetData(), Texels.Num(), 400);
+    FillTestFloats(LinearTexels.GetData(), LinearTexels.Num(), 401);
+
+    const uint8* BGRA8 = Texels.GetData();
+    const float* RGBA32F = LinearTexels.GetData();
+    CheckDeinterleave<uint8>(Test, TEXT("DeinterleaveBGRA8ToBytes"), [BGRA8](int64 FirstTexel, uint8* const* Dst, int64 Num) { DeinterleaveBGRA8ToBytes(BGRA8 + FirstTexel * 4, Dst, Num); });
+    CheckDeinterleave<float>(Test, TEXT("DeinterleaveBGRA8ToFloats"), [BGRA8](int64 FirstTexel, float* const* Dst, int64 Num) { DeinterleaveBGRA8ToFloats(BGRA8 + FirstTexel * 4, Dst, Num); });
+    CheckDeinterleave<uint8>(Test, TEXT("DeinterleaveRGBA32FToBytes"), [RGBA32F](int64 FirstTexel, uint8* const* Dst, int64 Num) { DeinterleaveRGBA32FToBytes(RGBA32F + FirstTexel * 4, Dst, Num); });
+    CheckDeinterleave<float>(Test, TEXT("DeinterleaveRGBA32FToFloats"), [RGBA32F](int64 FirstTexel, float* const* Dst, int64 Num) { DeinterleaveRGBA32FToFloats(RGBA32F + FirstTexel * 4, Dst, Num); });
+
+    // The BGRA8 luminance of the byte path and the rounded one of the float path (what the resampler
+    // writes at a scale of 1) agree for every color, one red value per row of 256 x 256 texels
+    TArray<uint8> Colors;
+    TArray<uint8> ByteLuminance;
+    TArray<float> FloatLuminance;
+    TArray<uint8> RoundedLuminance;
+    Colors.SetNumUninitialized(256 * 256 * 4);
+    ByteLuminance.SetNumUninitialized(256 * 256);
+    FloatLuminance.SetNumUninitialized(256 * 256);
+    RoundedLuminance.SetNumUninitialized(256 * 256);
+    for (int32 Red = 0; Red < 256; ++Red)
+    {
+        for (int32 i = 0; i < 256 * 256; ++i)
+        {
+            const FColor Color((uint8)Red, (uint8)(i >> 8), (uint8)i, 255);
+            FMemory::Memcpy(Colors.GetData() + i * 4, &Color, 4);
+        }
+        uint8* ByteDst[ChannelPackNumSourceChannels] = {};
+        float* FloatDst[ChannelPackNumSourceChannels] = {};
+        ByteDst[(int32)ETextureSourceChannel::Luminance] = ByteLuminance.GetData();
+        FloatDst[(int32)ETextureSourceChannel::Luminance] = FloatLuminance.GetData();
+        DeinterleaveBGRA8ToBytes(Colors.GetData(), ByteDst, 256 * 256);
+        DeinterleaveBGRA8ToFloats(Colors.GetData(), FloatDst, 256 * 256);
+        QuantizeRowToBytes(FloatLuminance.GetData(), RoundedLuminance.GetData(), 256 * 256);
+        Test.ExpectBytes(ByteLuminance.GetData(), RoundedLuminance.GetData(), ByteLuminance.Num(), FString::Printf(TEXT("BGRA8 luminance of bytes and of floats, red %d"), Red));
+    }
+}
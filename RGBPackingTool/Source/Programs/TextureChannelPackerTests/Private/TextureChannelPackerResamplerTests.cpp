@@ -0,0 +1,273 @@
+#include "TextureChannelPackerTests.h"
+#include "TextureChannelPackerEngine.h"
+#include "TextureChannelPackerResampler.h"
+
+// The resampler is checked against a direct evaluation of each filter's definition in double
+// precision: every source sample weighted by the filter, widened by the scale when downscaling, and
+// renormalized over the samples inside the image. The engine evaluates the same weights in float
+// over a clamped tap range, so a result may differ from the reference by one step after rounding.
+// Sample positions are computed with the same expressions as FResampleAxis::Build, so that a sample
+// exactly on the edge of the half-open Box footprint falls on the same side.
+
+static const ETextureResizeFilter ResizeFilters[] =
+{
+    ETextureResizeFilter::Box,
+    ETextureResizeFilter::Bilinear,
+    ETextureResizeFilter::Mitchell,
+    ETextureResizeFilter::CatmullRom,
+    ETextureResizeFilter::Lanczos3,
+};
+
+static const TCHAR* GetResizeFilterName(ETextureResizeFilter Filter)
+{
+    switch (Filter)
+    {
+    case ETextureResizeFilter::Box:        return TEXT("Box");
+    case ETextureResizeFilter::Bilinear:   return TEXT("Bilinear");
+    case ETextureResizeFilter::Mitchell:   return TEXT("Mitchell");
+    case ETextureResizeFilter::CatmullRom: return TEXT("CatmullRom");
+    case ETextureResizeFilter::Lanczos3:   return TEXT("Lanczos3");
+    default:                               return TEXT("Unknown");
+    }
+}
+
+/** Mitchell-Netravali cubic with parameters B and C (Mitchell and Netravali, 1988). */
+static double ReferenceCubic(double X, double B, double C)
+{
+    X = FMath::Abs(X);
+    if (X < 1.0)
+    {
+        return ((12.0 - 9.0 * B - 6.0 * C) * X * X * X + (-18.0 + 12.0 * B + 6.0 * C) * X * X + (6.0 - 2.0 * B)) / 6.0;
+    }
+    if (X < 2.0)
+    {
+        return ((-B - 6.0 * C) * X * X * X + (6.0 * B + 30.0 * C) * X * X + (-12.0 * B - 48.0 * C) * X + (8.0 * B + 24.0 * C)) / 6.0;
+    }
+    return 0.0;
+}
+
+static double ReferenceSinc(double X)
+{
+    return X == 0.0 ? 1.0 : FMath::Sin(UE_DOUBLE_PI * X) / (UE_DOUBLE_PI * X);
+}
+
+/** The filter at distance X, in source samples at a scale of 1, as documented on ETextureResizeFilter. */
+static double ReferenceFilter(ETextureResizeFilter Filter, double X)
+{
+    switch (Filter)
+    {
+    case ETextureResizeFilter::Box:        return (X >= -0.5 && X < 0.5) ? 1.0 : 0.0;
+    case ETextureResizeFilter::Bilinear:   return FMath::Max(0.0, 1.0 - FMath::Abs(X));
+    case ETextureResizeFilter::Mitchell:   return ReferenceCubic(X, 1.0 / 3.0, 1.0 / 3.0);
+    case ETextureResizeFilter::CatmullRom: return ReferenceCubic(X, 0.0, 0.5);
+    case ETextureResizeFilter::Lanczos3:   return FMath::Abs(X) < 3.0 ? ReferenceSinc(X) * ReferenceSinc(X / 3.0) : 0.0;
+    default:                               return 0.0;
+    }
+}
+
+/** Weights[D * SrcSize + S]: the weight of source sample S in destination sample D. */
+static TArray<double> BuildReferenceWeights(int32 SrcSize, int32 DstSize, ETextureResizeFilter Filter)
+{
+    TArray<double> Weights;
+    Weights.SetNumZeroed(SrcSize * DstSize);
+    const double Scale = (double)SrcSize / (double)DstSize;
+    const double InvFilterScale = 1.0 / FMath::Max(Scale, 1.0);
+    for (int32 D = 0; D < DstSize; ++D)
+    {
+        double* Row = Weights.GetData() + D * SrcSize;
+        if (SrcSize == DstSize)
+        {
+            Row[D] = 1.0;
+            continue;
+        }
+
+        const double Center = (D + 0.5) * Scale;
+        double Sum = 0.0;
+        for (int32 S = 0; S < SrcSize; ++S)
+        {
+            Row[S] = ReferenceFilter(Filter, (S - Center + 0.5) * InvFilterScale);
+            Sum += Row[S];
+        }
+        if (FMath::Abs(Sum) > 1e-8)
+        {
+            for (int32 S = 0; S < SrcSize; ++S)
+            {
+                Row[S] /= Sum;
+            }
+        }
+        else
+        {
+            FMemory::Memzero(Row, sizeof(double) * SrcSize);
+            Row[FMath::Clamp(FMath::FloorToInt(Center), 0, SrcSize - 1)] = 1.0;
+        }
+    }
+    return Weights;
+}
+
+void TestResampleFilters(FChannelPackTestContext& Test)
+{
+    struct FResizeCase
+    {
+        int32 SrcWidth, SrcHeight, DstWidth, DstHeight;
+    };
+    static const FResizeCase Cases[] =
+    {
+        { 37, 29, 37, 29 },  // Identity
+        { 64, 48, 32, 24 },  // Exact halving
+        { 37, 29, 16, 11 },  // Odd downscale
+        { 16, 11, 37, 29 },  // Odd upscale
+        { 5, 3, 64, 40 },    // Large upscale
+        { 100, 7, 33, 7 },   // One axis only
+        { 33, 65, 65, 33 },  // Up on one axis, down on the other
+        { 1, 1, 7, 5 },
+        { 7, 5, 1, 1 },
+    };
+
+    for (const ETextureResizeFilter Filter : ResizeFilters)
+    {
+        for (const FResizeCase& Case : Cases)
+        {
+            const FString What = FString::Printf(TEXT("%s, %dx%d to %dx%d"), GetResizeFilterName(Filter), Case.SrcWidth, Case.SrcHeight, Case.DstWidth, Case.DstHeight);
+
+            // The tap tables: normalized weights, and tap ranges inside the source
+            for (int32 Axis = 0; Axis < 2; ++Axis)
+            {
+                const int32 SrcSize = Axis == 0 ? Case.SrcWidth : Case.SrcHeight;
+                const int32 DstSize = Axis == 0 ? Case.DstWidth : Case.DstHeight;
+                FResampleAxis Taps;
+                Taps.Build(SrcSize, DstSize, Filter);
+                for (int32 D = 0; D < DstSize; ++D)
+                {
+                    double Sum = 0.0;
+                    for (int32 T = 0; T < Taps.Count[D]; ++T)
+                    {
+                        Sum += Taps.Weights[D * Taps.MaxTaps + T];
+                    }
+                    const bool bInside = Taps.First[D] >= 0 && Taps.Count[D] >= 1 && Taps.First[D] + Taps.Count[D] <= SrcSize;
+                    if (!Test.Expect(bInside && FMath::Abs(Sum - 1.0) < 1e-5, FString::Printf(TEXT("%s, axis %d, sample %d: taps [%d, +%d), weight sum %f"),
+                        *What, Axis, D, Taps.First[D], Taps.Count[D], Sum)))
+                    {
+                        break;
+                    }
+                }
+            }
+
+            TArray<uint8> Source;
+            Source.SetNumUninitialized(Case.SrcWidth * Case.SrcHeight);
+            FillChannelPackTestNoise(Source.GetData(), Source.Num(), Case.SrcWidth * 1000 + Case.DstWidth);
+
+            FChannelPackDesc Channels[4];
+            Channels[0].Source.Data = Source.GetData();
+            Channels[0].Source.Width = Case.SrcWidth;
+            Channels[0].Source.Height = Case.SrcHeight;
+            Channels[0].Source.Format = EChannelPackSourceFormat::G8;
+            TArray<uint8> Output;
+            Output.SetNumUninitialized(Case.DstWidth * Case.DstHeight * 4);
+            PackChannelsToBGRA8(Channels, Case.DstWidth, Case.DstHeight, Filter, Output.GetData());
+
+            const TArray<double> WeightsX = BuildReferenceWeights(Case.SrcWidth, Case.DstWidth, Filter);
+            const TArray<double> WeightsY = BuildReferenceWeights(Case.SrcHeight, Case.DstHeight, Filter);
+            TArray<uint8> Expected;
+            TArray<uint8> Actual;
+            Expected.SetNumUninitialized(Case.DstWidth * Case.DstHeight);
+            Actual.SetNumUninitialized(Case.DstWidth * Case.DstHeight);
+            for (int32 Y = 0; Y < Case.DstHeight; ++Y)
+            {
+                for (int32 X = 0; X < Case.DstWidth; ++X)
+                {
+                    double Value = 0.0;
+                    for (int32 SY = 0; SY < Case.SrcHeight; ++SY)
+                    {
+                        const double WeightY = WeightsY[Y * Case.SrcHeight + SY];
+                        for (int32 SX = 0; WeightY != 0.0 && SX < Case.SrcWidth; ++SX)
+                        {
+                            Value += WeightY * WeightsX[X * Case.SrcWidth + SX] * Source[SY * Case.SrcWidth + SX];
+                        }
+                    }
+                    Expected[Y * Case.DstWidth + X] = (uint8)FMath::Clamp(FMath::FloorToInt(Value + 0.5), 0, 255);
+                    Actual[Y * Case.DstWidth + X] = Output[(Y * Case.DstWidth + X) * 4 + 2];
+                }
+            }
+            const bool bIdentity = Case.SrcWidth == Case.DstWidth && Case.SrcHeight == Case.DstHeight;
+            Test.ExpectBytesNear(Expected.GetData(), Actual.GetData(), Expected.Num(), bIdentity ? 0 : 1, What);
+        }
+    }
+}
+
+/** Packs a G8 source into the red channel of a Width x Height output and returns that channel. */
+static TArray<uint8> PackG8(const TArray<uint8>& Source, int32 SrcWidth, int32 SrcHeight, int32 Width, int32 Height, ETextureResizeFilter Filter)
+{
+    FChannelPackDesc Channels[4];
+    Channels[0].Source.Data = Source.GetData();
+    Channels[0].Source.Width = SrcWidth;
+    Channels[0].Source.Height = SrcHeight;
+    Channels[0].Source.Format = EChannelPackSourceFormat::G8;
+    TArray<uint8> Output;
+    Output.SetNumUninitialized(Width * Height * 4);
+    PackChannelsToBGRA8(Channels, Width, Height, Filter, Output.GetData());
+
+    TArray<uint8> Red;
+    Red.SetNumUninitialized(Width * Height);
+    for (int32 i = 0; i < Width * Height; ++i)
+    {
+        Red[i] = Output[i * 4 + 2];
+    }
+    return Red;
+}
+
+void TestSourceMipSelection(FChannelPackTestContext& Test)
+{
+    // A pack reads the source mip of exactly the output size (FindChannelPackSourceMipOfSize), and mip 0
+    // at any other size. The selected mip is packed texel for texel with every filter, so the output is
+    // exactly the source's own mip, whatever filter made the chain.
+    static constexpr int32 Mip0Width = 256;
+    static constexpr int32 Mip0Height = 192;
+
+    // A box-filtered chain of noise, down to 8x6
+    TArray<TArray<uint8>> Mips;
+    Mips.AddDefaulted();
+    Mips[0].SetNumUninitialized(Mip0Width * Mip0Height);
+    FillChannelPackTestNoise(Mips[0].GetData(), Mips[0].Num(), 15);
+    for (int32 Mip = 1; (Mip0Height >> Mip) >= 6; ++Mip)
+    {
+        const int32 Width = Mip0Width >> Mip;
+        const int32 Height = Mip0Height >> Mip;
+        const TArray<uint8>& Parent = Mips[Mip - 1];
+        TArray<uint8> Level;
+        Level.SetNumUninitialized(Width * Height);
+        for (int32 Y = 0; Y < Height; ++Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const uint8* Block = Parent.GetData() + (Y * 2) * (Width * 2) + X * 2;
+                Level[Y * Width + X] = (uint8)((Block[0] + Block[1] + Block[Width * 2] + Block[Width * 2 + 1] + 2) / 4);
+            }
+        }
+        Mips.Add(MoveTemp(Level));
+    }
+
+    for (int32 Mip = 0; Mip < Mips.Num(); ++Mip)
+    {
+        const int32 Width = Mip0Width >> Mip;
+        const int32 Height = Mip0Height >> Mip;
+        const int32 Selected = FindChannelPackSourceMipOfSize(Mip0Width, Mip0Height, Mips.Num(), Width, Height);
+        Test.Expect(Selected == Mip, FString::Printf(TEXT("%dx%d selects mip %d, expected %d"), Width, Height, Selected, Mip));
+        for (const ETextureResizeFilter Filter : ResizeFilters)
+        {
+            const TArray<uint8> Packed = PackG8(Mips[Mip], Width, Height, Width, Height, Filter);
+            Test.ExpectBytes(Mips[Mip].GetData(), Packed.GetData(), Packed.Num(),
+                FString::Printf(TEXT("mip %d (%dx%d) packed with %s"), Mip, Width, Height, GetResizeFilterName(Filter)));
+        }
+
+        // No mip of these sizes: between two mips, another aspect, or below the chain's last mip
+        const FIntPoint OtherSizes[] = { FIntPoint(Width * 3 / 4, Height * 3 / 4), FIntPoint(Width, Height + 1), FIntPoint(Width - 1, Height), FIntPoint(Width / 2, Height) };
+        for (const FIntPoint& Size : OtherSizes)
+        {
+            const int32 Other = FindChannelPackSourceMipOfSize(Mip0Width, Mip0Height, Mips.Num(), Size.X, Size.Y);
+            Test.Expect(Other == 0, FString::Printf(TEXT("%dx%d selects mip %d, expected 0"), Size.X, Size.Y, Other));
+        }
+    }
+    Test.Expect(FindChannelPackSourceMipOfSize(Mip0Width, Mip0Height, 2, Mip0Width / 4, Mip0Height / 4) == 0, TEXT("A size past the chain selects mip 0"));
+    Test.Expect(FindChannelPackSourceMipOfSize(Mip0Width, Mip0Height, 1, Mip0Width / 2, Mip0Height / 2) == 0, TEXT("A single mip is always selected"));
+    Test.Expect(FindChannelPackSourceMipOfSize(100, 3, 8, 12, 1) == 3, TEXT("Mips of 1 row keep their width"));
+}
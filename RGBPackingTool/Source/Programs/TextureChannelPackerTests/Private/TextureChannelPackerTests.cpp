@@ -0,0 +1,173 @@
+#include "TextureChannelPackerTests.h"
+#include "RequiredProgramMainCPPInclude.h"
+#include "TextureChannelPackerBenchmarks.h"
+#include "TextureChannelPackerKernels.h"
+
+DEFINE_LOG_CATEGORY(LogTexturePackerTests);
+
+IMPLEMENT_APPLICATION(TextureChannelPackerTests, "TextureChannelPackerTests");
+
+const int32 ChannelPackTestLengths[19] = { 0, 1, 2, 3, 7, 15, 16, 17, 31, 32, 33, 47, 63, 64, 65, 127, 129, 1000, 1023 };
+
+// ---------------------------------------------------------
+// FChannelPackTestContext
+// ---------------------------------------------------------
+
+bool FChannelPackTestContext::Expect(bool bCondition, const FString& What)
+{
+    ++NumChecks;
+    if (!bCondition)
+    {
+        ++NumFailures;
+        UE_LOG(LogTexturePackerTests, Error, TEXT("%s: FAILED %s"), TestName, *What);
+    }
+    return bCondition;
+}
+
+bool FChannelPackTestContext::ExpectBytes(const uint8* Expected, const uint8* Actual, int64 Num, const FString& What)
+{
+    return ExpectBytesNear(Expected, Actual, Num, 0, What);
+}
+
+bool FChannelPackTestContext::ExpectBytesNear(const uint8* Expected, const uint8* Actual, int64 Num, int32 Tolerance, const FString& What)
+{
+    for (int64 i = 0; i < Num; ++i)
+    {
+        if (FMath::Abs((int32)Expected[i] - (int32)Actual[i]) > Tolerance)
+        {
+            return Expect(false, FString::Printf(TEXT("%s: element %lld is %d, expected %d"), *What, i, Actual[i], Expected[i]));
+        }
+    }
+    return Expect(true, What);
+}
+
+bool FChannelPackTestContext::ExpectFloats(const float* Expected, const float* Actual, int64 Num, const FString& What)
+{
+    for (int64 i = 0; i < Num; ++i)
+    {
+        if (!(Expected[i] == Actual[i] || (FMath::IsNaN(Expected[i]) && FMath::IsNaN(Actual[i]))))
+        {
+            return Expect(false, FString::Printf(TEXT("%s: element %lld is %.9g, expected %.9g"), *What, i, Actual[i], Expected[i]));
+        }
+    }
+    return Expect(true, What);
+}
+
+void FillChannelPackTestNoise(uint8* Data, int64 NumBytes, int32 Seed)
+{
+    FRandomStream Random(Seed);
+    for (int64 i = 0; i < NumBytes; ++i)
+    {
+        Data[i] = (uint8)(Random.GetUnsignedInt() >> 24);
+    }
+}
+
+// ---------------------------------------------------------
+// Test Runner
+// ---------------------------------------------------------
+
+struct FChannelPackTest
+{
+    const TCHAR* Name;
+    void (*Run)(FChannelPackTestContext& Test);
+};
+
+static const FChannelPackTest ChannelPackTests[] =
+{
+    { TEXT("Kernels.Interleave"), &TestInterleaveKernels },
+    { TEXT("Kernels.ChannelWriters"), &TestChannelWriters },
+    { TEXT("Kernels.RowConverters"), &TestRowConverters },
+    { TEXT("Kernels.HalfConversion"), &TestHalfConversion },
+    { TEXT("Kernels.Deinterleave"), &TestDeinterleaveKernels },
+    { TEXT("Resampler.Filters"), &TestResampleFilters },
+    { TEXT("Resampler.SourceMips"), &TestSourceMipSelection },
+    { TEXT("Engine.PackAgainstScalarKernels"), &TestPackAgainstScalarKernels },
+    { TEXT("Engine.ConstantChannels"), &TestConstantChannels },
+    { TEXT("Engine.ResizedLuminance"), &TestResizedLuminance },
+    { TEXT("Engine.StagedPack"), &TestStagedPack },
+};
+
+static const TCHAR* GetHalfConversionName()
+{
+#if TEXTURECHANNELPACKER_WITH_F16C
+    return TEXT("F16C");
+#elif TEXTURECHANNELPACKER_WITH_SSE2
+    return TEXT("SSE2 bit manipulation");
+#elif TEXTURECHANNELPACKER_WITH_NEON
+    return TEXT("NEON");
+#else
+    return TEXT("Scalar");
+#endif
+}
+
+/**
+ * Runs every test whose name contains -Filter=<Text> (all by default), then the benchmark suite if
+ * -Benchmark is given, with the suite's own parameters (see ParseChannelPackBenchmarkSuiteSettings).
+ *
+ * @return 0 if every check passed (and no benchmark case regressed), 1 otherwise, 2 for invalid arguments.
+ */
+static int32 RunChannelPackTests(const TCHAR* CommandLine)
+{
+    FString Filter;
+    FParse::Value(CommandLine, TEXT("Filter="), Filter);
+
+    UE_LOG(LogTexturePackerTests, Display, TEXT("Texture Channel Packer tests, SIMD: %s, halves: %s"), GetChannelPackerSimdName(), GetHalfConversionName());
+
+    int32 NumTests = 0;
+    int32 NumFailedTests = 0;
+    for (const FChannelPackTest& TestCase : ChannelPackTests)
+    {
+        if (!Filter.IsEmpty() && !FString(TestCase.Name).Contains(Filter))
+        {
+            continue;
+        }
+
+        FChannelPackTestContext Test(TestCase.Name);
+        const double StartTime = FPlatformTime::Seconds();
+        TestCase.Run(Test);
+        ++NumTests;
+        NumFailedTests += Test.GetNumFailures() > 0 ? 1 : 0;
+        UE_LOG(LogTexturePackerTests, Display, TEXT("  %-34s : %s  %7d checks  %8.1f ms"), TestCase.Name,
+            Test.GetNumFailures() > 0 ? TEXT("FAILED") : TEXT("passed"), Test.GetNumChecks(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    }
+    UE_LOG(LogTexturePackerTests, Display, TEXT("%d of %d tests passed"), NumTests - NumFailedTests, NumTests);
+
+    if (!FParse::Param(CommandLine, TEXT("Benchmark")))
+    {
+        return NumFailedTests > 0 ? 1 : 0;
+    }
+
+    FChannelPackBenchmarkSuiteSettings Settings;
+    FString Error;
+    if (!ParseChannelPackBenchmarkSuiteSettings(CommandLine, Settings, Error))
+    {
+        UE_LOG(LogTexturePackerTests, Error, TEXT("%s"), *Error);
+        return 2;
+    }
+
+    TArray<FChannelPackBenchmarkResult> Results;
+    if (!RunChannelPackBenchmarkSuite(Settings, Results, Error))
+    {
+        UE_LOG(LogTexturePackerTests, Error, TEXT("%s"), *Error);
+        return 1;
+    }
+    return NumFailedTests > 0 ? 1 : 0;
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+    FTaskTagScope Scope(ETaskTag::EGameThread);
+    ON_SCOPE_EXIT
+    {
+        RequestEngineExit(TEXT("Exiting"));
+        FEngineLoop::AppPreExit();
+        FModuleManager::Get().UnloadModulesAtShutdown();
+        FEngineLoop::AppExit();
+    };
+
+    if (const int32 Result = GEngineLoop.PreInit(ArgC, ArgV))
+    {
+        return Result;
+    }
+    return RunChannelPackTests(FCommandLine::Get());
+}
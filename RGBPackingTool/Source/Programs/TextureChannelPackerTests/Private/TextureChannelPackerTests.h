@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TextureChannelPackerTypes.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTexturePackerTests, Log, All);
+
+/**
+ * @class FChannelPackTestContext
+ * @brief Counts the checks of one test and logs the ones that fail.
+ *
+ * Buffer comparisons report the first mismatching element only, so a broken kernel does not flood
+ * the log with one line per pixel.
+ */
+class FChannelPackTestContext
+{
+public:
+    explicit FChannelPackTestContext(const TCHAR* InTestName) : TestName(InTestName) {}
+
+    /** Records a check. What describes the case and is logged if bCondition is false. */
+    bool Expect(bool bCondition, const FString& What);
+
+    /** Expects two byte buffers to be identical. */
+    bool ExpectBytes(const uint8* Expected, const uint8* Actual, int64 Num, const FString& What);
+
+    /** Expects two byte buffers to differ by at most Tolerance per element. */
+    bool ExpectBytesNear(const uint8* Expected, const uint8* Actual, int64 Num, int32 Tolerance, const FString& What);
+
+    /** Expects two float buffers to be equal, treating NaN as equal to NaN and -0 as equal to +0. */
+    bool ExpectFloats(const float* Expected, const float* Actual, int64 Num, const FString& What);
+
+    const TCHAR* GetTestName() const { return TestName; }
+    int32 GetNumChecks() const { return NumChecks; }
+    int32 GetNumFailures() const { return NumFailures; }
+
+private:
+    const TCHAR* TestName;
+    int32 NumChecks = 0;
+    int32 NumFailures = 0;
+};
+
+/** Fills Data with deterministic noise. */
+void FillChannelPackTestNoise(uint8* Data, int64 NumBytes, int32 Seed);
+
+/** Element counts that exercise every vector width (16 and 32) with and without a scalar tail. */
+extern const int32 ChannelPackTestLengths[19];
+
+// Kernels (TextureChannelPackerKernelTests.cpp): every vector loop against its scalar tail
+void TestInterleaveKernels(FChannelPackTestContext& Test);
+void TestChannelWriters(FChannelPackTestContext& Test);
+void TestRowConverters(FChannelPackTestContext& Test);
+void TestHalfConversion(FChannelPackTestContext& Test);
+void TestDeinterleaveKernels(FChannelPackTestContext& Test);
+
+// Resampler (TextureChannelPackerResamplerTests.cpp)
+void TestResampleFilters(FChannelPackTestContext& Test);
+void TestSourceMipSelection(FChannelPackTestContext& Test);
+
+// Engine (TextureChannelPackerEngineTests.cpp)
+void TestPackAgainstScalarKernels(FChannelPackTestContext& Test);
+void TestConstantChannels(FChannelPackTestContext& Test);
+void TestResizedLuminance(FChannelPackTestContext& Test);
+void TestStagedPack(FChannelPackTestContext& Test);
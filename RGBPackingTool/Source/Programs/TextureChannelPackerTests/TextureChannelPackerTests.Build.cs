@@ -0,0 +1,27 @@
+using UnrealBuildTool;
+
+public class TextureChannelPackerTests : ModuleRules
+{
+    public TextureChannelPackerTests(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateIncludePaths.AddRange(
+            new string[]
+            {
+                "Runtime/Launch/Public",
+                "Runtime/Launch/Private",
+            }
+        );
+
+        // Only the engine-free pixel engine: the tests run without the editor
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "Projects",
+                "TextureChannelPackerCore",
+            }
+        );
+    }
+}
@@ -0,0 +1,30 @@
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+/**
+ * Console program that checks the pixel engine (TextureChannelPackerCore) against its scalar
+ * reference paths and optionally runs the benchmark suite. Links Core and the engine only, so it
+ * builds and runs on build machines without the editor.
+ */
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class TextureChannelPackerTestsTarget : TargetRules
+{
+    public TextureChannelPackerTestsTarget(TargetInfo Target) : base(Target)
+    {
+        Type = TargetType.Program;
+        LinkType = TargetLinkType.Monolithic;
+        LaunchModuleName = "TextureChannelPackerTests";
+        DefaultBuildSettings = BuildSettingsVersion.Latest;
+        IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+
+        EnablePlugins.Add("TextureChannelPacker");
+
+        bCompileAgainstEngine = false;
+        bCompileAgainstCoreUObject = false;
+        bCompileAgainstApplicationCore = false;
+        bCompileICU = false;
+        bBuildWithEditorOnlyData = true;
+        bBuildRequiresCookedData = false;
+        bIsBuildingConsoleApplication = true;
+    }
+}
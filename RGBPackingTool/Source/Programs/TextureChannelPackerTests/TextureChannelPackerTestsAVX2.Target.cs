@@ -0,0 +1,15 @@
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+/**
+ * The same tests built with AVX2 (and F16C) as the minimum instruction set, so that the AVX2 and F16C
+ * kernels are compiled and checked. Runs on AVX2 CPUs only.
+ */
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class TextureChannelPackerTestsAVX2Target : TextureChannelPackerTestsTarget
+{
+    public TextureChannelPackerTestsAVX2Target(TargetInfo Target) : base(Target)
+    {
+        MinCpuArchX64 = MinimumCpuArchitectureX64.AVX2;
+    }
+}